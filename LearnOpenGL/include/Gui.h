@@ -5,9 +5,14 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <deque>
 #include <GLFW/glfw3.h> // 需要 GLFWwindow 定义
 
-#include "postProcessingData.h"
+#include "renderer.h"
+#include "resourceTracker.h"
+#include "simulation.h"
 
 class Gui {
 public:
@@ -50,17 +55,158 @@ public:
     }
 
     // 具体的面板绘制逻辑
-    // 传入引用，这样我们就能直接修改 main.cpp 里的变量
-    void DrawPanel(PointLightData& lightData, PostProcessingData& postProcessingData) {
+    // 渲染器的设置和统计都是它的公开成员，直接在这里读写；模拟线程和上传线程不归渲染器管，单独传进来
+    void DrawPanel(Renderer& renderer, SimulationSettings& simulation, const SimulationStats& simulationStats,
+                   const UploadStats& uploadStats) {
+        PointLightData& lightData = renderer.lightData;
+        PostProcessingData& postProcessingData = renderer.postProcessingData;
+        BloomRenderer& bloom = renderer.bloom;
+        AutoExposure& autoExposure = renderer.autoExposure;
+        PostProcessor& postProcessor = renderer.postProcessor;
+        const SceneBandwidthStats& bandwidthStats = renderer.bandwidthStats;
+        DynamicResolution& dynamicResolution = renderer.dynamicResolution;
+        const RenderTargetPool& renderTargets = renderer.renderTargets;
+        PointShadowAtlas& pointShadows = renderer.pointShadows;
+        OutlineData& outlineData = renderer.outlineData;
+        const OutlineTimings& outlineTimings = renderer.outlineTimings;
+        Profiler& profiler = renderer.profiler;
+        CommandRecordingSettings& recording = renderer.recording;
+        const CommandRecordingStats& recordingStats = renderer.recordingStats;
+        ModelStreamer& streamer = renderer.streamer;
         ImGui::Begin("Scene Controls");
 
         ImGui::Text("Performance: %.1f FPS", ImGui::GetIO().Framerate);
 
         if (ImGui::CollapsingHeader("Post Processing", ImGuiTreeNodeFlags_DefaultOpen)) {
-            ImGui::SliderFloat("Exposure", &postProcessingData.exposure, 0.1f, 5.0f);
-            ImGui::SliderInt("Amount", &postProcessingData.amount, 1, 100);
+            ImGui::SliderFloat(postProcessingData.autoExposure ? "Exposure Comp." : "Exposure",
+                               &postProcessingData.exposure, 0.1f, 5.0f);
+            ImGui::Checkbox("Auto Exposure", &postProcessingData.autoExposure);
+            if (postProcessingData.autoExposure && ImGui::TreeNode("Auto Exposure Settings")) {
+                ImGui::SliderFloat("Key Value", &postProcessingData.exposureKey, 0.01f, 1.0f);
+                ImGui::DragFloatRange2("Log2 Lum Range", &postProcessingData.exposureMinLogLum,
+                                       &postProcessingData.exposureMaxLogLum, 0.1f, -16.0f, 16.0f);
+                ImGui::DragFloatRange2("Percentiles", &postProcessingData.exposureLowPercent,
+                                       &postProcessingData.exposureHighPercent, 0.005f, 0.0f, 1.0f);
+                ImGui::SliderFloat("Adapt Up (1/s)", &postProcessingData.adaptSpeedUp, 0.1f, 10.0f);
+                ImGui::SliderFloat("Adapt Down (1/s)", &postProcessingData.adaptSpeedDown, 0.1f, 10.0f);
+                const AutoExposureResult& exposureResult = autoExposure.Result();
+                ImGui::Text("Avg lum %.3f   P-low %.3f   P-high %.3f",
+                            exposureResult.averageLum, exposureResult.lowLum, exposureResult.highLum);
+                ImGui::Text("Target %.3f   Adapted %.3f   Exposure %.2f",
+                            exposureResult.targetLum, exposureResult.adaptedLum, exposureResult.exposure);
+                ImGui::Text("GPU: %.0f us (avg %.0f us)", autoExposure.Milliseconds() * 1000.0f, autoExposure.AverageMs() * 1000.0f);
+                if (ImGui::Button("Reset Exposure Timing")) autoExposure.ResetTimings();
+                ImGui::TreePop();
+            }
             ImGui::SliderFloat("gamma", &postProcessingData.gamma, 0.1f, 5.0f);
             ImGui::SliderFloat("Bloom Strength", &postProcessingData.bloomStrength, 0.0f, 1.0f);
+            ImGui::SliderFloat("Bloom Threshold", &postProcessingData.bloomThreshold, 0.0f, 5.0f);
+            ImGui::SliderFloat("Bloom Knee", &postProcessingData.bloomKnee, 0.0f, 1.0f);
+            ImGui::Separator();
+            const char* bloomModes[] = { "Mip Chain", "Ping-Pong (legacy)", "Compute Gaussian" };
+            ImGui::Combo("Bloom Mode", &postProcessingData.bloomMode, bloomModes, IM_ARRAYSIZE(bloomModes));
+            if (postProcessingData.bloomMode == BLOOM_MIP_CHAIN) {
+                ImGui::SliderInt("Mip Levels", &postProcessingData.bloomMips, 1, bloom.MaxMips());
+                ImGui::DragFloat("Filter Radius", &postProcessingData.bloomFilterRadius, 0.0005f, 0.0f, 0.05f, "%.4f");
+            } else if (postProcessingData.bloomMode == BLOOM_PING_PONG) {
+                ImGui::SliderInt("Amount", &postProcessingData.amount, 1, 100);
+            } else {
+                ImGui::SliderInt("Blur Radius", &postProcessingData.bloomBlurRadius, 1, ComputeBlur::MAX_RADIUS);
+            }
+            // 两种方法各自的平均耗时和估算半径，调到半径差不多时比较耗时
+            const BloomStats& bloomStats = bloom.stats;
+            ImGui::Text("GPU ms      Mip %.3f   Ping-Pong %.3f   Compute %.3f",
+                        bloomStats.mipChainMs, bloomStats.pingPongMs, bloomStats.computeMs);
+            ImGui::Text("Radius px   Mip %.0f   Ping-Pong %.0f   Compute %.0f",
+                        bloomStats.mipChainRadius, bloomStats.pingPongRadius, bloomStats.computeRadius);
+            if (ImGui::Button("Reset Bloom Timings")) bloom.ResetTimings();
+            ImGui::Separator();
+            ImGui::Checkbox("Color Grading", &postProcessingData.colorGrading);
+            if (postProcessingData.colorGrading) {
+                ImGui::SliderFloat("Saturation", &postProcessingData.saturation, 0.0f, 2.0f);
+                ImGui::SliderFloat("Contrast", &postProcessingData.contrast, 0.5f, 2.0f);
+            }
+            ImGui::Checkbox("Vignette", &postProcessingData.vignette);
+            if (postProcessingData.vignette) {
+                ImGui::SliderFloat("Vignette Strength", &postProcessingData.vignetteStrength, 0.0f, 1.0f);
+                ImGui::SliderFloat("Vignette Radius", &postProcessingData.vignetteRadius, 0.0f, 1.0f);
+            }
+            // 合并成一个 pass 和每个效果单独一个 pass 的对比
+            ImGui::Checkbox("Fused Post Pass", &postProcessingData.fusedPost);
+            const PostStats& postStats = postProcessor.stats;
+            ImGui::Text("Passes: %d, variants compiled: %u", postStats.passes, postStats.variants);
+            ImGui::Text("GPU ms      Fused %.3f   Separate %.3f", postStats.fusedMs, postStats.separateMs);
+            ImGui::Text("Traffic     Fused %.1f MB   Separate %.1f MB   saved %.1f MB/frame",
+                        postStats.fusedBytes / (1024.0 * 1024.0), postStats.separateBytes / (1024.0 * 1024.0),
+                        (postStats.separateBytes - postStats.fusedBytes) / (1024.0 * 1024.0));
+            if (ImGui::Button("Reset Post Timings")) postProcessor.ResetTimings();
+            // 去掉高亮附件 (BrightColor) 后省下的带宽
+            ImGui::Separator();
+            ImGui::Text("Scene fragments: %llu", bandwidthStats.fragments);
+            ImGui::Text("Bright MRT saved: %.1f MB/frame, %.1f MB memory",
+                        bandwidthStats.savedBytes / (1024.0 * 1024.0), bandwidthStats.savedMemory / (1024.0 * 1024.0));
+        }
+
+        if (ImGui::CollapsingHeader("Profiler")) {
+            drawProfiler(profiler);
+        }
+
+        if (ImGui::CollapsingHeader("GL Calls")) {
+            drawGlStats(GlStats::Get());
+        }
+
+        if (ImGui::CollapsingHeader("Memory")) {
+            drawMemory(ResourceTracker::Get());
+        }
+
+        if (ImGui::CollapsingHeader("Dynamic Resolution")) {
+            DynamicResolutionSettings& drs = dynamicResolution.settings;
+            ImGui::Checkbox("Enabled", &drs.enabled);
+            ImGui::SliderFloat("Target GPU ms", &drs.targetMs, 4.0f, 50.0f, "%.1f");
+            ImGui::SliderFloat("Min Scale", &drs.minScale, 0.25f, 1.0f);
+            ImGui::SliderFloat("Max Scale", &drs.maxScale, 0.25f, 1.0f);
+            if (drs.minScale > drs.maxScale) drs.minScale = drs.maxScale;
+            ImGui::SliderFloat("Sharpness", &drs.sharpness, 0.0f, 1.0f);
+            ImGui::Text("GPU frame: %.2f ms", dynamicResolution.LastGpuMs());
+            ImGui::Text("Scale: %.2f (%d x %d)", dynamicResolution.Scale(),
+                        dynamicResolution.RenderWidth(), dynamicResolution.RenderHeight());
+        }
+
+        if (ImGui::CollapsingHeader("Command Recording")) {
+            ImGui::Checkbox("Parallel Recording", &recording.enabled);
+            ImGui::SliderInt("Objects per Job", &recording.grain, 8, 1024);
+            ImGui::Text("Workers: %d", JobSystem::Get().WorkerCount());
+            ImGui::Text("Packets: %u, jobs: %u", recordingStats.packets, recordingStats.jobs);
+            ImGui::Text("Wait: %.3f ms, submit: %.3f ms", recordingStats.waitMs, recordingStats.submitMs);
+        }
+
+        if (ImGui::CollapsingHeader("Simulation")) {
+            ImGui::Checkbox("Simulation Thread", &simulation.threaded);
+            if (simulation.threaded) {
+                ImGui::SliderInt("Tick Rate (Hz)", &simulation.tickRate, 30, 1000);
+                ImGui::Checkbox("Late Latch Input", &simulation.lateLatch);
+                ImGui::Text("Ticks: %.0f / s, step: %.3f ms", simulationStats.ticksPerSecond, simulationStats.stepMs);
+                ImGui::Text("Latch wait: %.3f ms", simulationStats.latchWaitMs);
+            }
+            ImGui::Text("Snapshot age: %.3f ms", simulationStats.snapshotAgeMs);
+            ImGui::Text("Input -> frame: %.3f ms", simulationStats.inputLatencyMs);
+        }
+
+        if (ImGui::CollapsingHeader("Model Streaming")) {
+            drawStreaming(streamer, uploadStats);
+        }
+
+        if (ImGui::CollapsingHeader("Render Targets")) {
+            const RenderTargetPoolStats& poolStats = renderTargets.stats;
+            ImGui::Text("Backbuffer: %d x %d", renderTargets.Width(), renderTargets.Height());
+            ImGui::Text("Textures: %zu, %.1f MB", renderTargets.Entries().size(),
+                        renderTargets.MemoryBytes() / (1024.0 * 1024.0));
+            ImGui::Text("Allocations: %u, resizes: %u, evictions: %u",
+                        poolStats.allocations, poolStats.resizes, poolStats.evictions);
+            for (const RenderTargetEntry& entry : renderTargets.Entries())
+                ImGui::Text("  %-10s %4d x %-4d x%.3g %6.2f MB%s", RenderTargetPool::FormatName(entry.desc.internalFormat),
+                            entry.width, entry.height, entry.desc.scale,
+                            RenderTargetPool::EntryBytes(entry) / (1024.0 * 1024.0), entry.idleFrames > 0 ? "  (idle)" : "");
         }
 
         if (ImGui::CollapsingHeader("Light Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -84,8 +230,246 @@ public:
             ImGui::DragFloat("Linear", &lightData.linear, 0.001f, 0.0f, 1.0f, "%.4f");
             ImGui::DragFloat("Quadratic", &lightData.quadratic, 0.0001f, 0.0f, 1.0f, "%.5f");
         }
+
+        if (ImGui::CollapsingHeader("Shadows")) {
+            const PointShadowStats& atlasStats = pointShadows.stats;
+            ImGui::SliderInt("Face Budget", &pointShadows.faceBudget, 1, SHADOW_FACE_COUNT);
+            ImGui::DragFloat("Bias", &pointShadows.bias, 0.001f, 0.0f, 1.0f, "%.3f");
+            ImGui::Text("Faces rendered: %u, deferred: %u, hidden: %u",
+                        atlasStats.facesRendered, atlasStats.facesDeferred, atlasStats.facesHidden);
+            ImGui::Text("Atlas relayouts: %u", atlasStats.relayouts);
+            for (int i = 0; i < MAX_SHADOW_LIGHTS; i++)
+                ImGui::Text("  Light %d: %4d px, influence %.2f", i, atlasStats.resolution[i], atlasStats.influence[i]);
+            ImGui::Separator();
+
+            const ShadowCacheStats& shadowStats = pointShadows.CacheStats();
+            float hitRate = shadowStats.updates ? 100.0f * shadowStats.cacheHits / shadowStats.updates : 0.0f;
+            ImGui::Text("Cache hits: %u / %u (%.1f%%)", shadowStats.cacheHits, shadowStats.updates, hitRate);
+            ImGui::Text("Full hits (no composite): %u", shadowStats.fullHits);
+            ImGui::Separator();
+            ImGui::Text("Invalidations");
+            ImGui::Text("  Forced:        %u", shadowStats.invalidForced);
+            ImGui::Text("  Light moved:   %u", shadowStats.invalidLight);
+            ImGui::Text("  Static set:    %u", shadowStats.invalidStaticSet);
+            ImGui::Text("  Static moved:  %u", shadowStats.invalidStaticMoved);
+            ImGui::Separator();
+            ImGui::Text("This frame: static %u, dynamic %u", shadowStats.staticDrawn, shadowStats.dynamicDrawn);
+            ImGui::Separator();
+
+            // 投射物剔除：本帧合计 + 每个光源最近一次更新 6 个面的合计
+            const CullStats& frameCull = shadowStats.frameCull;
+            ImGui::Text("Casters (frame): submitted %u, culled %u / %u",
+                        frameCull.objectsSubmitted, frameCull.objectsCulled, frameCull.objectsTested);
+            ImGui::Text("Sub-meshes (frame): submitted %u, culled %u",
+                        frameCull.meshesSubmitted, frameCull.meshesCulled);
+            for (int i = 0; i < MAX_SHADOW_LIGHTS; i++) {
+                CullStats lightCull = pointShadows.LightCull(i);
+                ImGui::Text("  Light %d: casters %u/%u culled, meshes %u/%u culled", i,
+                            lightCull.objectsCulled, lightCull.objectsTested,
+                            lightCull.meshesCulled, lightCull.meshesCulled + lightCull.meshesSubmitted);
+            }
+        }
+
+        if (ImGui::CollapsingHeader("Outline")) {
+            const char* modes[] = { "Per Object", "All Hull", "All Screen Space", "All Off" };
+            // A/B 对比时方式由 main 自动切换，这里只显示
+            ImGui::BeginDisabled(outlineData.compare);
+            ImGui::Combo("Mode", &outlineData.overrideMode, modes, IM_ARRAYSIZE(modes));
+            ImGui::EndDisabled();
+            ImGui::ColorEdit3("Color", &outlineData.color.x);
+            ImGui::SliderFloat("Hull Width", &outlineData.hullWidth, 0.0f, 1.0f);
+            ImGui::SliderFloat("Thickness (px)", &outlineData.thickness, 1.0f, 4.0f);
+            ImGui::DragFloat("Depth Threshold", &outlineData.depthThreshold, 0.001f, 0.0f, 1.0f, "%.3f");
+            ImGui::DragFloat("Normal Threshold", &outlineData.normalThreshold, 0.01f, 0.0f, 2.0f);
+            ImGui::Checkbox("A/B Compare", &outlineData.compare);
+            ImGui::Separator();
+            // 左右对比：描边本身 + 被它影响的 toon pass
+            ImGui::Text("GPU ms         Hull    Screen");
+            ImGui::Text("  Outline   %7.3f   %7.3f", outlineTimings.hullPass, outlineTimings.screenPass);
+            ImGui::Text("  Toon      %7.3f   %7.3f", outlineTimings.toonWithHull, outlineTimings.toonWithScreen);
+            ImGui::Text("  Total     %7.3f   %7.3f", outlineTimings.hullPass + outlineTimings.toonWithHull,
+                        outlineTimings.screenPass + outlineTimings.toonWithScreen);
+        }
         ImGui::End();
     }
+private:
+    static const int PROFILER_CAPTURE_FRAMES = 120;
+    static const size_t MEMORY_LIST_COUNT = 20;
+    static constexpr const char* MEMORY_DUMP_PATH = "memory_dump.json";
+    bool memoryDumped = false;
+    // 最近一次流式加载，以及从请求到 resident 之间最慢的一帧
+    char streamPath[256] = "objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx";
+    std::shared_ptr<StreamedModel> lastStream;
+    float streamWorstFrameMs = 0.0f;
+    int streamTailFrames = 0;
+
+    // 按名字给每种范围一个固定的颜色，时间线上同一个 pass 每帧颜色不变
+    static ImU32 scopeColor(const char* name) {
+        unsigned int hash = 2166136261u;
+        for (const char* c = name; *c; c++) hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+        float hue = (hash % 360) / 360.0f;
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+        return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+    }
+
+    // 一条轨道：每个范围一个矩形，嵌套的往下排一层
+    static void drawTrack(ImDrawList* drawList, const ProfileFrame& frame, bool gpu, ImVec2 origin,
+                          float width, float rowHeight, double scaleMs) {
+        for (const ProfileEvent& event : frame.events) {
+            double start = gpu ? event.gpuStart : event.cpuStart;
+            double end = gpu ? event.gpuEnd : event.cpuEnd;
+            ImVec2 min(origin.x + static_cast<float>(start / scaleMs) * width, origin.y + event.depth * rowHeight);
+            ImVec2 max(origin.x + static_cast<float>(end / scaleMs) * width, min.y + rowHeight - 1.0f);
+            if (max.x - min.x < 1.0f) max.x = min.x + 1.0f;
+            drawList->AddRectFilled(min, max, scopeColor(event.name));
+            if (max.x - min.x > ImGui::CalcTextSize(event.name).x + 4.0f)
+                drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(0, 0, 0, 255), event.name);
+            if (ImGui::IsMouseHoveringRect(min, max))
+                ImGui::SetTooltip("%s (%s)\n%.3f ms", event.name, gpu ? "GPU" : "CPU", end - start);
+        }
+    }
+
+    void drawStreaming(ModelStreamer& streamer, const UploadStats& uploadStats) {
+        ImGui::Text("Mode: %s", streamer.Async() ? "upload thread (shared context)" : "synchronous");
+        ImGui::InputText("Path", streamPath, sizeof(streamPath));
+        if (ImGui::Button("Load Model")) {
+            lastStream = streamer.Load(streamPath);
+            streamWorstFrameMs = 0.0f;
+        }
+        ImGui::Text("Pending: %d", streamer.Pending());
+        ImGui::Text("Uploaded: %llu textures, %llu buffers, %.1f MB, busy %.1f ms",
+                    uploadStats.textures, uploadStats.buffers, uploadStats.bytes / (1024.0 * 1024.0), uploadStats.busyMs);
+        if (!lastStream) return;
+        int state = lastStream->state.load(std::memory_order_acquire);
+        // 同步加载卡住的那一帧，帧时间下一帧才拿得到，所以 resident 之后再多看两帧
+        bool loading = state != STREAM_RESIDENT && state != STREAM_FAILED;
+        if (loading) streamTailFrames = 2;
+        if (loading || streamTailFrames-- > 0)
+            streamWorstFrameMs = std::max(streamWorstFrameMs, ImGui::GetIO().DeltaTime * 1000.0f);
+        ImGui::Separator();
+        ImGui::Text("Last: %s", StreamStateName(state));
+        if (state == STREAM_RESIDENT) {
+            ImGui::Text("Load %.1f ms, upload %.1f ms, finalize %.1f ms", lastStream->loadMs, lastStream->uploadMs,
+                        lastStream->finalizeMs);
+            ImGui::Text("Request -> resident: %.1f ms", lastStream->residentMs);
+        }
+        ImGui::Text("Worst frame while loading: %.1f ms", streamWorstFrameMs);
+    }
+
+    void drawProfiler(Profiler& profiler) {
+        ImGui::Checkbox("Enabled##Profiler", &profiler.enabled);
+        const ProfileFrame& frame = profiler.LastFrame();
+        ImGui::Text("Frame %llu: CPU %.3f ms, GPU %.3f ms", frame.index, frame.cpuMs, frame.gpuMs);
+        ImGui::Text("Resolved %u, dropped %u", profiler.stats.resolvedFrames, profiler.stats.droppedFrames);
+
+        // 最近几百帧的 GPU 帧时间
+        const std::deque<ProfileFrame>& history = profiler.History();
+        float gpuHistory[Profiler::HISTORY_SIZE];
+        int count = 0;
+        for (const ProfileFrame& f : history) gpuHistory[count++] = static_cast<float>(f.gpuMs);
+        if (count > 0) ImGui::PlotLines("GPU ms", gpuHistory, count, 0, NULL, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+
+        // 时间线：CPU 一条、GPU 一条，横轴是两者里较长的那个
+        int maxDepth = 0;
+        for (const ProfileEvent& event : frame.events) maxDepth = std::max(maxDepth, event.depth);
+        const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+        const float trackHeight = (maxDepth + 1) * rowHeight;
+        double scaleMs = std::max(std::max(frame.cpuMs, frame.gpuMs), 0.001);
+        float width = ImGui::GetContentRegionAvail().x;
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImGui::Text("CPU");
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        drawTrack(drawList, frame, false, origin, width, rowHeight, scaleMs);
+        ImGui::Dummy(ImVec2(width, trackHeight));
+        ImGui::Text("GPU");
+        origin = ImGui::GetCursorScreenPos();
+        drawTrack(drawList, frame, true, origin, width, rowHeight, scaleMs);
+        ImGui::Dummy(ImVec2(width, trackHeight));
+
+        if (ImGui::TreeNode("Scopes")) {
+            ImGui::Text("%-24s %8s %8s", "", "CPU ms", "GPU ms");
+            for (const ProfileEvent& event : frame.events)
+                ImGui::Text("%*s%-*s %8.3f %8.3f", event.depth * 2, "", 24 - event.depth * 2, event.name,
+                            event.cpuEnd - event.cpuStart, event.gpuEnd - event.gpuStart);
+            ImGui::TreePop();
+        }
+
+        ImGui::BeginDisabled(profiler.IsCapturing() || !profiler.enabled);
+        if (ImGui::Button("Capture Chrome Trace"))
+            profiler.StartCapture(PROFILER_CAPTURE_FRAMES, "profile_trace.json");
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        if (profiler.IsCapturing()) ImGui::Text("capturing...");
+        else ImGui::Text("%d frames -> profile_trace.json", PROFILER_CAPTURE_FRAMES);
+    }
+
+    // 上一帧的 GL 调用：按 pass 分类的次数表 + 上传量 + 调用最多的入口
+    void drawGlStats(GlStats& glStats) {
+        if (!GlStats::Compiled) {
+            ImGui::TextDisabled("Build with -DENTRO_GL_STATS=ON to count GL calls");
+            return;
+        }
+        ImGui::Checkbox("Enabled##GlStats", &glStats.enabled);
+        const GlFrameStats& frame = glStats.LastFrame();
+        ImGui::Text("Draw %u, state %u, uniform %u, upload %u",
+                    frame.CategoryTotal(GLSTAT_CATEGORY_DRAW), frame.CategoryTotal(GLSTAT_CATEGORY_STATE),
+                    frame.CategoryTotal(GLSTAT_CATEGORY_UNIFORM), frame.CategoryTotal(GLSTAT_CATEGORY_UPLOAD));
+        ImGui::Text("Uploaded: buffers %.1f KB, textures %.1f KB",
+                    frame.bufferBytes / 1024.0, frame.textureBytes / 1024.0);
+
+        ImGui::Text("%-16s %6s %6s %8s %6s %9s", "pass", "draw", "state", "uniform", "upload", "KB");
+        for (int pass = 0; pass <= GlFrameStats::MAX_PASSES; pass++) {
+            if (!frame.passNames[pass]) continue;
+            const unsigned int* calls = frame.passCalls[pass];
+            ImGui::Text("%-16s %6u %6u %8u %6u %9.1f", frame.passNames[pass],
+                        calls[GLSTAT_CATEGORY_DRAW], calls[GLSTAT_CATEGORY_STATE], calls[GLSTAT_CATEGORY_UNIFORM],
+                        calls[GLSTAT_CATEGORY_UPLOAD], frame.passUploadBytes[pass] / 1024.0);
+        }
+
+        if (ImGui::TreeNode("Entry Points")) {
+            int order[GLSTAT_COUNT];
+            for (int i = 0; i < GLSTAT_COUNT; i++) order[i] = i;
+            std::sort(order, order + GLSTAT_COUNT, [&frame](int a, int b) { return frame.calls[a] > frame.calls[b]; });
+            for (int i : order) {
+                if (frame.calls[i] == 0) break;
+                ImGui::Text("%-24s %-8s %6u", GlStatCallName(i), GlStatCategoryName(GlStatCallCategory(i)), frame.calls[i]);
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    // 显存 / 内存记账：总量、各类别的当前 / 峰值，以及最大的几项
+    void drawMemory(ResourceTracker& tracker) {
+        const double MB = 1024.0 * 1024.0;
+        ImGui::Text("GPU: %.1f MB (peak %.1f MB)", tracker.GpuBytes() / MB, tracker.PeakGpuBytes() / MB);
+        ImGui::Text("CPU: %.1f MB (peak %.1f MB)", tracker.CpuBytes() / MB, tracker.PeakCpuBytes() / MB);
+
+        ImGui::Text("%-14s %9s %9s %6s %6s %6s", "category", "MB", "peak", "live", "alloc", "free");
+        for (int i = 0; i < RESOURCE_CATEGORY_COUNT; i++) {
+            ResourceCategoryStats stats = tracker.CategoryStats(i);
+            if (stats.allocations == 0) continue;
+            ImGui::Text("%-14s %9.2f %9.2f %6u %6u %6u", ResourceCategoryName(i), stats.currentBytes / MB,
+                        stats.peakBytes / MB, stats.liveCount, stats.allocations, stats.releases);
+        }
+
+        if (ImGui::TreeNode("Largest")) {
+            std::vector<ResourceRecord> live = tracker.LiveRecords();
+            double now = tracker.Now();
+            for (size_t i = 0; i < live.size() && i < MEMORY_LIST_COUNT; i++) {
+                const ResourceRecord& record = live[i];
+                ImGui::Text("%8.2f MB  %-13s %6.0fs  %s", record.bytes / MB, ResourceCategoryName(record.category),
+                            now - record.allocatedAt, record.owner.c_str());
+            }
+            ImGui::TreePop();
+        }
+
+        if (ImGui::Button("Dump##Memory") && tracker.Dump(MEMORY_DUMP_PATH)) memoryDumped = true;
+        if (memoryDumped) {
+            ImGui::SameLine();
+            ImGui::Text("-> %s", MEMORY_DUMP_PATH);
+        }
+    }
 };
 
 #endif //GUI_H
\ No newline at end of file
@@ -3,8 +3,11 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <string>
 #include <vector>
 
+#include "resourceTracker.h"
+
 class UBO {
 public:
     unsigned int ID;
@@ -21,11 +24,13 @@ public:
         
         // 将这个 Buffer 绑定到绑定点 (Binding Point)
         glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, ID);
+        ResourceTracker::Get().Track(RESOURCE_KIND_BUFFER, ID, size, RESOURCE_UNIFORM, "UBO binding " + std::to_string(bindingPoint));
         
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
     ~UBO() {
+        ResourceTracker::Get().Release(RESOURCE_KIND_BUFFER, ID);
         glDeleteBuffers(1, &ID);
     }
 
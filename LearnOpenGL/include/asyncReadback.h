@@ -0,0 +1,92 @@
+#ifndef ASYNCREADBACK_H
+#define ASYNCREADBACK_H
+
+#include <glad/glad.h>
+#include <cstring>
+#include <vector>
+
+// ==========================================================
+// 不阻塞的帧缓冲读回：glReadPixels 写进 PBO (GL_PIXEL_PACK_BUFFER)，后面插一个 fence。
+// Request 之后 CPU 可以继续提交下一帧，等 Ready() 了再 Read，拷贝的时候数据已经在 PBO 里，
+// 不会像直接 glReadPixels 到内存那样把整条管线排空
+// ==========================================================
+class AsyncReadback {
+public:
+    AsyncReadback() {
+        glGenBuffers(1, &pbo);
+    }
+
+    ~AsyncReadback() {
+        if (fence) glDeleteSync(fence);
+        glDeleteBuffers(1, &pbo);
+    }
+
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+    // 读 fbo 的 0 号颜色附件 (RGBA8)，上一次的结果没取走就丢掉
+    void Request(unsigned int fbo, int newWidth, int newHeight) {
+        width = newWidth;
+        height = newHeight;
+        size_t bytes = static_cast<size_t>(width) * height * 4;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        if (bytes != capacity) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+            capacity = bytes;
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glReadBuffer(fbo == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (fence) glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // 让驱动尽快把命令发出去，否则 fence 可能永远等不到
+        glFlush();
+    }
+
+    bool Pending() const { return fence != nullptr; }
+
+    // GPU 已经写完 PBO 了吗 (不等待)
+    bool Ready() const {
+        if (!fence) return false;
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+    }
+
+    // 取出像素 (第一行是画面最下面一行)。wait = false 且还没好时返回 false
+    bool Read(std::vector<unsigned char>& pixels, bool wait) {
+        if (!fence) return false;
+        if (wait) {
+            while (true) {
+                GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+                if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) break;
+                if (status == GL_WAIT_FAILED) return false;
+            }
+        } else if (!Ready()) {
+            return false;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+
+        pixels.resize(capacity);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, capacity, GL_MAP_READ_BIT);
+        if (mapped) std::memcpy(pixels.data(), mapped, capacity);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return mapped != nullptr;
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+private:
+    unsigned int pbo = 0;
+    size_t capacity = 0;
+    int width = 0, height = 0;
+    GLsync fence = nullptr;
+};
+
+#endif
\ No newline at end of file
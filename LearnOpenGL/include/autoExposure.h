@@ -0,0 +1,168 @@
+#ifndef AUTOEXPOSURE_H
+#define AUTOEXPOSURE_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+#include "shader.h"
+#include "gpuTimer.h"
+#include "postProcessingData.h"
+#include "resourceTracker.h"
+
+// 和 luminanceAverage.comp 里的 ExposureResult 保持一致 (std430，全是 float)
+struct AutoExposureResult {
+    float averageLum = 0.0f;
+    float lowLum = 0.0f;
+    float highLum = 0.0f;
+    float targetLum = 0.0f;
+    float adaptedLum = 0.0f;
+    float exposure = 1.0f;
+};
+
+// ==========================================================
+// 自动曝光
+// luminanceHistogram.comp：HDR 场景的 log2 亮度直方图 (256 个 bin，共享内存原子操作)
+// luminanceAverage.comp：一个工作组做前缀和 + 归约，取两个百分位之间的平均亮度，
+//                       和上一帧的结果做时间适应，曝光写进 1x1 的 R32F 纹理。
+// 色调映射直接采样这张纹理，CPU 不需要等 GPU 的结果；
+// GUI 里显示的统计值走异步读回：Compute 把结果拷进一块小缓冲并插 fence，ReadResult 只在 fence 过了才读，
+// 所以统计值会晚一两帧，但 CPU 从来不等 GPU
+// ==========================================================
+class AutoExposure {
+public:
+    static const int BIN_COUNT = 256;  // 和两个计算着色器保持一致
+    static const int GROUP_SIZE = 16;
+
+    AutoExposure()
+        : histogramShader("shaders/luminanceHistogram.comp"),
+          averageShader("shaders/luminanceAverage.comp") {
+        glGenBuffers(1, &histogramBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, histogramBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, BIN_COUNT * sizeof(unsigned int), NULL, GL_DYNAMIC_COPY);
+        unsigned int zero = 0;
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+        // adaptedLum = 0 表示还没有结果，第一帧直接取目标亮度
+        AutoExposureResult initial;
+        glGenBuffers(2, resultBuffers);
+        for (unsigned int buffer : resultBuffers) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(AutoExposureResult), &initial, GL_DYNAMIC_COPY);
+        }
+        glGenBuffers(1, &readbackBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readbackBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(AutoExposureResult), NULL, GL_STREAM_READ);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        ResourceTracker& tracker = ResourceTracker::Get();
+        tracker.Track(RESOURCE_KIND_BUFFER, histogramBuffer, BIN_COUNT * sizeof(unsigned int), RESOURCE_BUFFER, "auto exposure histogram");
+        for (unsigned int buffer : resultBuffers)
+            tracker.Track(RESOURCE_KIND_BUFFER, buffer, sizeof(AutoExposureResult), RESOURCE_BUFFER, "auto exposure result");
+        tracker.Track(RESOURCE_KIND_BUFFER, readbackBuffer, sizeof(AutoExposureResult), RESOURCE_BUFFER, "auto exposure readback");
+
+        glGenTextures(1, &exposureTexture);
+        glBindTexture(GL_TEXTURE_2D, exposureTexture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, 1, 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        float one = 1.0f;
+        glClearTexImage(exposureTexture, 0, GL_RED, GL_FLOAT, &one);
+        tracker.Track(RESOURCE_KIND_TEXTURE, exposureTexture, ResourceTracker::TextureBytes(1, 1, GL_R32F, false),
+                      RESOURCE_RENDER_TARGET, "auto exposure");
+    }
+
+    ~AutoExposure() {
+        ResourceTracker& tracker = ResourceTracker::Get();
+        tracker.Release(RESOURCE_KIND_BUFFER, histogramBuffer);
+        for (unsigned int buffer : resultBuffers) tracker.Release(RESOURCE_KIND_BUFFER, buffer);
+        tracker.Release(RESOURCE_KIND_BUFFER, readbackBuffer);
+        tracker.Release(RESOURCE_KIND_TEXTURE, exposureTexture);
+        if (readbackFence) glDeleteSync(readbackFence);
+        glDeleteBuffers(1, &histogramBuffer);
+        glDeleteBuffers(2, resultBuffers);
+        glDeleteBuffers(1, &readbackBuffer);
+        glDeleteTextures(1, &exposureTexture);
+    }
+
+    // 统计 hdrTexture 的亮度并更新曝光。结束后 ExposureTexture() 可以直接采样
+    void Compute(unsigned int hdrTexture, int width, int height, float deltaTime, const PostProcessingData& settings) {
+        timer.Begin();
+        float minLogLum = settings.exposureMinLogLum;
+        float logLumRange = std::max(0.01f, settings.exposureMaxLogLum - settings.exposureMinLogLum);
+
+        // 1. 直方图
+        histogramShader.use();
+        histogramShader.setFloat("minLogLum", minLogLum);
+        histogramShader.setFloat("inverseLogLumRange", 1.0f / logLumRange);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, histogramBuffer);
+        glDispatchCompute((width + GROUP_SIZE - 1) / GROUP_SIZE, (height + GROUP_SIZE - 1) / GROUP_SIZE, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        // 2. 归约 + 适应：读上一帧的结果，写到另一块缓冲
+        float lowPercent = std::clamp(settings.exposureLowPercent, 0.0f, 0.99f);
+        float highPercent = std::clamp(settings.exposureHighPercent, lowPercent + 0.01f, 1.0f);
+        averageShader.use();
+        averageShader.setFloat("minLogLum", minLogLum);
+        averageShader.setFloat("logLumRange", logLumRange);
+        averageShader.setFloat("lowPercent", lowPercent);
+        averageShader.setFloat("highPercent", highPercent);
+        averageShader.setFloat("keyValue", settings.exposureKey);
+        averageShader.setFloat("speedUp", settings.adaptSpeedUp);
+        averageShader.setFloat("speedDown", settings.adaptSpeedDown);
+        averageShader.setFloat("deltaTime", deltaTime);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, resultBuffers[1 - current]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, resultBuffers[current]);
+        glBindImageTexture(0, exposureTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute(1, 1, 1);
+        // 色调映射马上要采样曝光纹理，下一帧还要读结果缓冲
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        // 上一次读回已经取走了，就把这一帧的结果拷一份出来等 ReadResult
+        if (!readbackFence) {
+            glBindBuffer(GL_COPY_READ_BUFFER, resultBuffers[current]);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, readbackBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(AutoExposureResult));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            readbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        current = 1 - current;
+        timer.End();
+    }
+
+    // 拷出来的结果 GPU 做完了就读进 Result() 并返回 true，否则什么都不做 (不等待，只在 GUI 打开时调用)
+    bool ReadResult() {
+        if (!readbackFence) return false;
+        GLenum status = glClientWaitSync(readbackFence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+        glDeleteSync(readbackFence);
+        readbackFence = nullptr;
+        glBindBuffer(GL_COPY_READ_BUFFER, readbackBuffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(AutoExposureResult), &result);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return true;
+    }
+
+    unsigned int ExposureTexture() const { return exposureTexture; }
+    const AutoExposureResult& Result() const { return result; }
+    float Milliseconds() const { return timer.Milliseconds(); }
+    float AverageMs() const { return timer.Average(); }
+    void ResetTimings() { timer.ResetAverage(); }
+
+private:
+    Shader histogramShader;
+    Shader averageShader;
+    unsigned int histogramBuffer;
+    unsigned int resultBuffers[2];
+    unsigned int readbackBuffer;                // GUI 用的结果拷贝，readbackFence 过了才读
+    GLsync readbackFence = nullptr;
+    unsigned int exposureTexture;
+    int current = 0;  // 这一帧要写的结果缓冲
+    GpuTimer timer;
+    AutoExposureResult result;
+};
+
+#endif
\ No newline at end of file
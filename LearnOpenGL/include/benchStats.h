@@ -0,0 +1,43 @@
+#ifndef BENCHSTATS_H
+#define BENCHSTATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// 一组采样 (比如每帧的毫秒数) 的汇总
+struct SampleStats {
+    size_t count = 0;
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+
+    // 百分位用最近秩 (nearest-rank)：结果一定是某个真实采样，不做插值
+    static SampleStats Compute(std::vector<double> samples) {
+        SampleStats stats;
+        stats.count = samples.size();
+        if (samples.empty()) return stats;
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double v : samples) sum += v;
+        stats.mean = sum / samples.size();
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.p50 = Percentile(samples, 0.50);
+        stats.p95 = Percentile(samples, 0.95);
+        stats.p99 = Percentile(samples, 0.99);
+        return stats;
+    }
+
+    // sorted 必须已经排好序
+    static double Percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+};
+
+#endif
\ No newline at end of file
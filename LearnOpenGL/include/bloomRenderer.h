@@ -0,0 +1,273 @@
+#ifndef BLOOMRENDERER_H
+#define BLOOMRENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+#include "shader.h"
+#include "screenQuad.h"
+#include "gpuTimer.h"
+#include "postProcessingData.h"
+#include "blurKernel.h"
+#include "computeBlur.h"
+#include "renderTargetPool.h"
+
+enum BloomMode {
+    BLOOM_MIP_CHAIN,   // 逐级降采样 + 升采样 (13-tap 降采样, 3x3 tent 升采样)
+    BLOOM_PING_PONG,   // 旧方法：全分辨率高斯模糊来回 amount 次
+    BLOOM_COMPUTE      // 计算着色器：一次全分辨率可分离高斯 (共享内存)，半径任意
+};
+
+// 两种方法的 GPU 耗时 (毫秒，从上次 ResetTimings 开始的平均值) 和估算的光晕半径
+struct BloomStats {
+    float mipChainMs = 0.0f;
+    float pingPongMs = 0.0f;
+    float computeMs = 0.0f;
+    float mipChainRadius = 0.0f;  // 全分辨率像素
+    float pingPongRadius = 0.0f;
+    float computeRadius = 0.0f;
+};
+
+// ==========================================================
+// 泛光 (Bloom)
+// mip 链：先从半分辨率开始一级级降采样，再从最小的一级往回升采样并叠加。
+// 每一级的像素数是上一级的 1/4，总开销收敛在 ~1.33 倍的半分辨率 pass，
+// 加一级 mip 光晕半径翻倍但几乎不增加开销。
+// 旧的 ping-pong 高斯模糊保留下来，方便在同样的光晕半径下对比耗时。
+// 计算着色器模糊 (ComputeBlur) 也可以直接拿来做泛光，用来和上面两种对比。
+// 输入是 HDR 场景颜色本身：mip 链在第一次降采样里顺便做软阈值提取高亮，
+// 另外两种方法先单独跑一遍 bloomPrefilter.frag。
+// 所有纹理每帧从 RenderTargetPool 借，尺寸跟着窗口走；这里只保留帧缓冲对象，每次挂上借到的纹理
+// ==========================================================
+class BloomRenderer {
+public:
+    BloomStats stats;
+
+    explicit BloomRenderer(RenderTargetPool& targets)
+        : targets(targets),
+          downsampleShader("shaders/screen.vert", "shaders/bloomDownsample.frag"),
+          upsampleShader("shaders/screen.vert", "shaders/bloomUpsample.frag"),
+          blurShader("shaders/blur.vert", "shaders/blur.frag"),
+          prefilterShader("shaders/screen.vert", "shaders/bloomPrefilter.frag") {
+        glGenFramebuffers(1, &mipFBO);
+        glGenFramebuffers(2, pingpongFBO);
+        glGenFramebuffers(1, &computeFBO);
+    }
+
+    ~BloomRenderer() {
+        glDeleteFramebuffers(1, &mipFBO);
+        glDeleteFramebuffers(2, pingpongFBO);
+        glDeleteFramebuffers(1, &computeFBO);
+    }
+
+    // 对 HDR 场景颜色 (和 backbuffer 一样大) 做泛光，返回模糊后的纹理 (本帧内有效)。
+    // 结束时绑定默认帧缓冲，视口恢复成全屏
+    unsigned int Render(unsigned int sceneTexture, ScreenQuad& screenQuad, const PostProcessingData& settings) {
+        width = targets.Width();
+        height = targets.Height();
+        unsigned int result;
+        if (settings.bloomMode == BLOOM_PING_PONG) {
+            pingPongTimer.Begin();
+            unsigned int pingpongColorbuffers[2];
+            for (unsigned int i = 0; i < 2; i++) {
+                pingpongColorbuffers[i] = targets.Acquire(RenderTargetDesc(GL_RGBA16F));
+                attach(pingpongFBO[i], pingpongColorbuffers[i]);
+            }
+            // 高亮写进 pingpong[0]，第一次模糊 (水平) 正好从它读、写到 pingpong[1]
+            prefilter(sceneTexture, pingpongFBO[0], screenQuad, settings);
+            result = renderPingPong(pingpongColorbuffers, screenQuad, settings.amount);
+            pingPongTimer.End();
+        } else if (settings.bloomMode == BLOOM_COMPUTE) {
+            computeTimer.Begin();
+            if (computeBlur.Radius() != settings.bloomBlurRadius)
+                computeBlur.SetKernel(BlurKernel::Gaussian(settings.bloomBlurRadius));
+            // 计算着色器的输出，格式必须是 RGBA16F
+            unsigned int computeTarget = targets.Acquire(RenderTargetDesc(GL_RGBA16F));
+            attach(computeFBO, computeTarget);
+            // 水平那一遍只读输入，所以输入输出可以是同一张
+            prefilter(sceneTexture, computeFBO, screenQuad, settings);
+            computeBlur.Blur(computeTarget, computeTarget, width, height);
+            result = computeTarget;
+            computeTimer.End();
+        } else {
+            mipChainTimer.Begin();
+            downsampleShader.use();
+            downsampleShader.setFloat("threshold", settings.bloomThreshold);
+            downsampleShader.setFloat("knee", settings.bloomKnee);
+            result = renderMipChain(sceneTexture, screenQuad, settings.bloomMips, settings.bloomFilterRadius);
+            mipChainTimer.End();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, width, height);
+        glActiveTexture(GL_TEXTURE0);
+
+        stats.mipChainMs = mipChainTimer.Average();
+        stats.pingPongMs = pingPongTimer.Average();
+        stats.computeMs = computeTimer.Average();
+        stats.mipChainRadius = MipChainRadius(settings.bloomMips, settings.bloomFilterRadius);
+        stats.pingPongRadius = PingPongRadius(settings.amount);
+        stats.computeRadius = static_cast<float>(computeBlur.Radius());
+        return result;
+    }
+
+    void ResetTimings() {
+        mipChainTimer.ResetAverage();
+        pingPongTimer.ResetAverage();
+        computeTimer.ResetAverage();
+    }
+
+    // 估算的光晕半径 (全分辨率像素，约 2 sigma)
+    // mip 链：最小一级的一个像素对应 2^mipCount 个全分辨率像素，tent 再扩 filterRadius
+    float MipChainRadius(int mipCount, float filterRadius) const {
+        int levels = std::max(1, std::min(mipCount, MaxMips()));
+        return std::pow(2.0f, static_cast<float>(levels)) + filterRadius * width;
+    }
+    // ping-pong：blur.frag 的权重约等于 sigma = 1.8 的高斯，每两次 (水平 + 垂直) 方差叠加一次
+    float PingPongRadius(int amount) const {
+        return 2.0f * 1.8f * std::sqrt(amount * 0.5f);
+    }
+
+    // 从半分辨率开始一直减半到 1x1，最多 MAX_MIPS 级
+    int MaxMips() const {
+        int levels = 0;
+        for (int size = std::max(targets.Width(), targets.Height()) / 2; levels < MAX_MIPS; size /= 2) {
+            levels++;
+            if (size <= 1) break;
+        }
+        return levels;
+    }
+
+private:
+    struct BloomMip {
+        unsigned int texture;
+        int width, height;
+    };
+
+    RenderTargetPool& targets;
+    int width = 0, height = 0;
+    Shader downsampleShader;
+    Shader upsampleShader;
+    Shader blurShader;
+    Shader prefilterShader;
+    unsigned int mipFBO;
+    unsigned int pingpongFBO[2];
+    GpuTimer mipChainTimer;
+    GpuTimer pingPongTimer;
+    GpuTimer computeTimer;
+    ComputeBlur computeBlur;
+    unsigned int computeFBO;
+    // 原来写死在 blur.frag 里的权重，合并成线性采样后 9 次读取变 5 次
+    BlurKernel pingPongKernel = BlurKernel::FromWeights({ 0.227027f, 0.1945946f, 0.1216216f, 0.054054f, 0.016216f }).Folded();
+
+    static const int MAX_MIPS = 8;
+
+    // 把借来的纹理挂到帧缓冲上 (纹理每帧可能不同，挂载很便宜)
+    static void attach(unsigned int fbo, unsigned int texture) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    }
+
+    // 单独的高亮提取 (只有 ping-pong / 计算着色器模式需要)
+    void prefilter(unsigned int sceneTexture, unsigned int targetFBO, ScreenQuad& screenQuad, const PostProcessingData& settings) {
+        glBindFramebuffer(GL_FRAMEBUFFER, targetFBO);
+        glViewport(0, 0, width, height);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        prefilterShader.use();
+        prefilterShader.setInt("scene", 0);
+        prefilterShader.setFloat("threshold", settings.bloomThreshold);
+        prefilterShader.setFloat("knee", settings.bloomKnee);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, sceneTexture);
+        screenQuad.Draw();
+        glEnable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    unsigned int renderMipChain(unsigned int sceneTexture, ScreenQuad& screenQuad, int mipCount, float filterRadius) {
+        int levels = std::max(1, std::min(mipCount, MaxMips()));
+        // 第 i 级是 backbuffer 的 1/2^(i+1)，只需要 RGB，R11F_G11F_B10F 比 RGBA16F 省一半带宽
+        std::vector<BloomMip> mips(levels);
+        float scale = 1.0f;
+        for (BloomMip& mip : mips) {
+            scale *= 0.5f;
+            RenderTargetDesc desc(GL_R11F_G11F_B10F, scale);
+            mip.texture = targets.Acquire(desc);
+            targets.SizeOf(desc, mip.width, mip.height);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, mipFBO);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+
+        // 1. 降采样：原图 -> mip0 -> mip1 -> ...
+        downsampleShader.use();
+        downsampleShader.setInt("srcTexture", 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, sceneTexture);
+        glm::vec2 srcResolution(width, height);
+        for (int i = 0; i < levels; i++) {
+            const BloomMip& mip = mips[i];
+            downsampleShader.setVec2("srcResolution", srcResolution);
+            // 第一级用 Karis 平均，压住单个极亮像素造成的闪烁，同时做软阈值
+            downsampleShader.setInt("mipLevel", i);
+            glViewport(0, 0, mip.width, mip.height);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mip.texture, 0);
+            screenQuad.Draw();
+            srcResolution = glm::vec2(mip.width, mip.height);
+            glBindTexture(GL_TEXTURE_2D, mip.texture);
+        }
+
+        // 2. 升采样：从最小一级往回，每一级模糊后叠加 (GL_ONE, GL_ONE) 到上一级
+        upsampleShader.use();
+        upsampleShader.setInt("srcTexture", 0);
+        upsampleShader.setFloat("filterRadius", filterRadius);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+        glBlendEquation(GL_FUNC_ADD);
+        for (int i = levels - 1; i > 0; i--) {
+            const BloomMip& mip = mips[i];
+            const BloomMip& nextMip = mips[i - 1];
+            glBindTexture(GL_TEXTURE_2D, mip.texture);
+            glViewport(0, 0, nextMip.width, nextMip.height);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, nextMip.texture, 0);
+            screenQuad.Draw();
+        }
+        // 恢复 main 里的混合设置
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_DEPTH_TEST);
+        return mips[0].texture;
+    }
+
+    unsigned int renderPingPong(const unsigned int pingpongColorbuffers[2], ScreenQuad& screenQuad, int amount) {
+        unsigned int brightTexture = pingpongColorbuffers[0];
+        bool horizontal = true, first_iteration = true;
+        blurShader.use();
+        blurShader.setInt("tapCount", pingPongKernel.TapCount());
+        blurShader.setFloatArray("offsets", pingPongKernel.offsets.data(), pingPongKernel.TapCount());
+        blurShader.setFloatArray("weights", pingPongKernel.weights.data(), pingPongKernel.TapCount());
+        glViewport(0, 0, width, height);
+        glActiveTexture(GL_TEXTURE0);
+        for (int i = 0; i < amount; i++)
+        {
+            // 绑定当前要写入的 FBO (0 或 1)
+            glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
+            blurShader.setInt("horizontal", horizontal);
+
+            // 第一次循环读高亮图，之后读对方的 pingpongBuffer
+            glBindTexture(GL_TEXTURE_2D, first_iteration ? brightTexture : pingpongColorbuffers[!horizontal]);
+
+            screenQuad.Draw(); // 画个四边形进行模糊计算
+
+            horizontal = !horizontal; // 切换方向
+            if (first_iteration) first_iteration = false;
+        }
+        // 一次都没模糊时直接返回高亮图
+        return first_iteration ? brightTexture : pingpongColorbuffers[!horizontal];
+    }
+};
+
+#endif
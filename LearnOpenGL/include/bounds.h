@@ -0,0 +1,110 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cmath>
+
+// 轴对齐包围盒
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    // 默认是“空”盒子，Expand 之后才有效
+    AABB() : min(glm::vec3(FLT_MAX)), max(glm::vec3(-FLT_MAX)) {}
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    bool Valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    void Expand(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void Expand(const AABB& box) {
+        if (!box.Valid()) return;
+        Expand(box.min);
+        Expand(box.max);
+    }
+
+    // 变换到另一个空间后的包围盒 (Arvo 的方法：中心点直接变换，半长乘矩阵的绝对值)
+    AABB Transformed(const glm::mat4& m) const {
+        if (!Valid()) return *this;
+        glm::vec3 center = (min + max) * 0.5f;
+        glm::vec3 extent = (max - min) * 0.5f;
+        glm::vec3 newCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+        glm::vec3 newExtent(0.0f);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                newExtent[i] += std::abs(m[j][i]) * extent[j];
+        return AABB(newCenter - newExtent, newCenter + newExtent);
+    }
+};
+
+// 视锥体：6 个平面，从 Projection * View 矩阵里直接提取 (Gribb-Hartmann)
+// 平面方程 dot(n, p) + d >= 0 表示在视锥内侧
+struct Frustum {
+    glm::vec4 planes[6]; // 左 右 下 上 近 远
+
+    explicit Frustum(const glm::mat4& viewProjection) {
+        for (int p = 0; p < 6; p++) {
+            int row = p / 2;
+            float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+            glm::vec4 plane;
+            // glm 是列主序：m[列][行]
+            for (int k = 0; k < 4; k++)
+                plane[k] = viewProjection[k][3] + sign * viewProjection[k][row];
+            float len = glm::length(glm::vec3(plane));
+            planes[p] = plane / len;
+        }
+    }
+
+    // 包围盒和视锥相交 (保守测试：只要不完全在某个平面外面就算相交)
+    bool Intersects(const AABB& box) const {
+        if (!box.Valid()) return false;
+        for (const glm::vec4& plane : planes) {
+            // 取沿平面法线方向最远的那个角点
+            glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x,
+                               plane.y >= 0.0f ? box.max.y : box.min.y,
+                               plane.z >= 0.0f ? box.max.z : box.min.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) return false;
+        }
+        return true;
+    }
+
+    bool Intersects(const glm::vec3& center, float radius) const {
+        for (const glm::vec4& plane : planes)
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+        return true;
+    }
+
+    // 视锥本身的包围盒 (NDC 立方体的 8 个角反投影回世界空间)
+    static AABB Corners(const glm::mat4& viewProjection) {
+        glm::mat4 inv = glm::inverse(viewProjection);
+        AABB box;
+        for (int i = 0; i < 8; i++) {
+            glm::vec4 corner((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+            glm::vec4 world = inv * corner;
+            box.Expand(glm::vec3(world) / world.w);
+        }
+        return box;
+    }
+};
+
+// 剔除统计
+struct CullStats {
+    unsigned int objectsTested = 0;
+    unsigned int objectsCulled = 0;
+    unsigned int objectsSubmitted = 0;
+    unsigned int meshesCulled = 0;
+    unsigned int meshesSubmitted = 0;
+
+    void Add(const CullStats& other) {
+        objectsTested += other.objectsTested;
+        objectsCulled += other.objectsCulled;
+        objectsSubmitted += other.objectsSubmitted;
+        meshesCulled += other.meshesCulled;
+        meshesSubmitted += other.meshesSubmitted;
+    }
+};
+
+#endif
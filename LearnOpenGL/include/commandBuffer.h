@@ -0,0 +1,280 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "renderObject.h"
+#include "shader.h"
+#include "jobSystem.h"
+
+// 子网格贴图的类型，顺序和名字与 Mesh::Draw 里的 material.texture_<类型><序号> 一致
+enum MeshTextureType {
+    MESH_TEXTURE_DIFFUSE,
+    MESH_TEXTURE_SPECULAR,
+    MESH_TEXTURE_NORMAL,
+    MESH_TEXTURE_HEIGHT,
+    MESH_TEXTURE_TYPE_COUNT
+};
+
+const int MAX_TEXTURES_PER_TYPE = 4;
+
+// 一次 draw 会设置的 uniform。录制时只记槽位号，提交时再按当前程序查位置 (每个程序只查一次)
+enum DrawUniformSlot {
+    DRAW_UNIFORM_NONE = -1,
+    DRAW_UNIFORM_MODEL,
+    DRAW_UNIFORM_UV_SCALE,
+    DRAW_UNIFORM_USE_NORMAL_MAP,   // RenderObject 手动设置的法线贴图
+    DRAW_UNIFORM_USE_NORMAL,       // 子网格自带法线贴图 (Mesh::Draw)
+    DRAW_UNIFORM_TEXTURE_FIRST,    // 之后是 material.texture_<类型><1..MAX_TEXTURES_PER_TYPE>
+    DRAW_UNIFORM_COUNT = DRAW_UNIFORM_TEXTURE_FIRST + MESH_TEXTURE_TYPE_COUNT * MAX_TEXTURES_PER_TYPE
+};
+
+inline const char* MeshTextureTypeName(int type) {
+    static const char* names[MESH_TEXTURE_TYPE_COUNT] = {
+        "texture_diffuse", "texture_specular", "texture_normal", "texture_height"
+    };
+    return names[type];
+}
+
+inline int MeshTextureType(const std::string& name) {
+    for (int type = 0; type < MESH_TEXTURE_TYPE_COUNT; type++)
+        if (name == MeshTextureTypeName(type)) return type;
+    return -1;
+}
+
+// 第 number 个 (从 1 开始) type 类型贴图的槽位，超出范围时是 DRAW_UNIFORM_NONE
+inline int DrawTextureSlot(int type, int number) {
+    if (type < 0 || number < 1 || number > MAX_TEXTURES_PER_TYPE) return DRAW_UNIFORM_NONE;
+    return DRAW_UNIFORM_TEXTURE_FIRST + type * MAX_TEXTURES_PER_TYPE + number - 1;
+}
+
+inline std::string DrawUniformName(int slot) {
+    switch (slot) {
+        case DRAW_UNIFORM_MODEL: return "model";
+        case DRAW_UNIFORM_UV_SCALE: return "uvScale";
+        case DRAW_UNIFORM_USE_NORMAL_MAP: return "useNormalMap";
+        case DRAW_UNIFORM_USE_NORMAL: return "useNormal";
+        default: break;
+    }
+    int index = slot - DRAW_UNIFORM_TEXTURE_FIRST;
+    return std::string("material.") + MeshTextureTypeName(index / MAX_TEXTURES_PER_TYPE)
+           + std::to_string(index % MAX_TEXTURES_PER_TYPE + 1);
+}
+
+// 子网格自带的一张贴图：绑到哪个纹理单元，对应哪个采样器 uniform
+struct DrawTexture {
+    unsigned int texture = 0;
+    unsigned char unit = 0;
+    signed char slot = DRAW_UNIFORM_NONE;
+};
+
+// ==========================================================
+// 一个 draw 包：画一个子网格需要的全部数据 (矩阵、uniform 值、VAO、贴图)，本身不含任何 GL 调用。
+// 名字 (VAO / 纹理) 对后端来说是不透明的句柄，换后端只需要换 GlCommandExecutor
+// ==========================================================
+struct DrawPacket {
+    glm::mat4 model;
+    glm::vec2 uvScale;
+    unsigned int vertexArray = 0;
+    unsigned int indexCount = 0;
+    unsigned int diffuseOverride = 0;  // RenderObject::textureID，0 = 没有
+    unsigned int normalOverride = 0;   // RenderObject::normalMapID，0 = 没有 (useNormalMap 设成 false)
+    unsigned int firstTexture = 0;     // 子网格自带的贴图在 CommandBuffer::textures 里的位置
+    unsigned int textureCount = 0;
+    bool meshNormal = false;           // 子网格带法线贴图：useNormal 设成 true (和 Mesh::Draw 一样从不设回 false)
+};
+
+// ==========================================================
+// 一组物体的 draw 包 (按物体顺序，每个子网格一个包)。
+// 先在 GL 线程上 Layout：按每个物体的子网格数 / 贴图数算好前缀和、一次分配好空间；
+// 之后各个任务用 Record 录制互不重叠的物体区间，直接写到自己的位置，不需要合并也不需要加锁
+// ==========================================================
+class CommandBuffer {
+public:
+    std::vector<DrawPacket> packets;
+    std::vector<DrawTexture> textures;
+
+    void Layout(const std::vector<RenderObject*>& objects) {
+        firstPacket.resize(objects.size() + 1);
+        firstTextureOf.resize(objects.size() + 1);
+        unsigned int packetCount = 0, textureCount = 0;
+        for (size_t i = 0; i < objects.size(); i++) {
+            firstPacket[i] = packetCount;
+            firstTextureOf[i] = textureCount;
+            for (const Mesh& mesh : objects[i]->model->meshes) textureCount += static_cast<unsigned int>(mesh.textures.size());
+            packetCount += static_cast<unsigned int>(objects[i]->model->meshes.size());
+        }
+        firstPacket[objects.size()] = packetCount;
+        firstTextureOf[objects.size()] = textureCount;
+        packets.resize(packetCount);
+        textures.resize(textureCount);
+    }
+
+    // 录制 objects[begin, end)，和 RenderObject::Draw 设置的状态完全一样。可以在任何线程调用，不碰 GL
+    void Record(const std::vector<RenderObject*>& objects, int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            const RenderObject& object = *objects[i];
+            glm::mat4 modelMat = object.GetModelMatrix();
+            unsigned int packetIndex = firstPacket[i];
+            unsigned int textureIndex = firstTextureOf[i];
+            for (const Mesh& mesh : object.model->meshes) {
+                DrawPacket& packet = packets[packetIndex++];
+                packet.model = modelMat;
+                packet.uvScale = object.uvScale;
+                packet.vertexArray = mesh.VAO;
+                packet.indexCount = static_cast<unsigned int>(mesh.indices.size());
+                packet.diffuseOverride = object.textureID;
+                packet.normalOverride = object.normalMapID;
+                packet.firstTexture = textureIndex;
+                packet.textureCount = static_cast<unsigned int>(mesh.textures.size());
+                packet.meshNormal = false;
+                int numbers[MESH_TEXTURE_TYPE_COUNT] = { 1, 1, 1, 1 };
+                for (size_t t = 0; t < mesh.textures.size(); t++) {
+                    int type = MeshTextureType(mesh.textures[t].type);
+                    DrawTexture& texture = textures[textureIndex++];
+                    texture.texture = mesh.textures[t].id;
+                    texture.unit = static_cast<unsigned char>(t);
+                    texture.slot = static_cast<signed char>(type >= 0 ? DrawTextureSlot(type, numbers[type]++) : DRAW_UNIFORM_NONE);
+                    if (type == MESH_TEXTURE_NORMAL) packet.meshNormal = true;
+                }
+            }
+        }
+    }
+
+    size_t Size() const { return packets.size(); }
+
+private:
+    std::vector<unsigned int> firstPacket;     // 第 i 个物体的第一个包 (多一个元素放总数)
+    std::vector<unsigned int> firstTextureOf;
+};
+
+// 录制的开关和每帧统计 (给 GUI / 基准测试看)
+struct CommandRecordingSettings {
+    bool enabled = true;      // 关掉就回到逐个物体 RenderObject::Draw 的直接提交
+    int grain = 64;           // 每个录制任务负责的物体数
+};
+
+struct CommandRecordingStats {
+    unsigned int packets = 0;    // 这一帧录制的 draw 包
+    unsigned int jobs = 0;       // 录制任务数
+    float waitMs = 0.0f;         // GL 线程在场景 pass 前等录制做完的时间 (录制和阴影 pass 重叠，理想是 0)
+    float submitMs = 0.0f;       // GL 线程解码提交所有包的时间
+};
+
+// 把 objects 按 grain 个一块交给 jobs 录制，立刻返回；counter 归零时 buffer 就录好了。
+// 返回任务数。objects 和 buffer 必须活到 counter 归零
+inline unsigned int RecordCommandsAsync(JobSystem& jobs, const std::vector<RenderObject*>& objects, CommandBuffer& buffer,
+                                        int grain, JobCounter& counter) {
+    buffer.Layout(objects);
+    int count = static_cast<int>(objects.size());
+    grain = std::max(grain, 1);
+    unsigned int jobCount = 0;
+    for (int begin = 0; begin < count; begin += grain) {
+        int end = std::min(begin + grain, count);
+        jobs.Run([&objects, &buffer, begin, end]() { buffer.Record(objects, begin, end); }, &counter);
+        jobCount++;
+    }
+    return jobCount;
+}
+
+// ==========================================================
+// GL 后端：在 GL 线程上把 CommandBuffer 一口气提交掉。
+// uniform 位置按程序缓存 (第一次见到某个程序时查一遍所有槽位)，
+// 一次 Submit 之内跳过重复的 VAO / 纹理单元 / 纹理 / 采样器绑定。提交完的 GL 状态和逐个 RenderObject::Draw 一样
+// (VAO 解绑、活动纹理单元回到 0)。着色器程序要由调用方先 use
+// ==========================================================
+class GlCommandExecutor {
+public:
+    void Submit(const CommandBuffer& buffer, const Shader& shader) {
+        if (buffer.packets.empty()) return;
+        const GLint* locations = locationsFor(shader.ID);
+        unsigned int boundTextures[MAX_TRACKED_UNITS];
+        std::fill(boundTextures, boundTextures + MAX_TRACKED_UNITS, UNKNOWN);
+        int samplerUnits[DRAW_UNIFORM_COUNT];
+        std::fill(samplerUnits, samplerUnits + DRAW_UNIFORM_COUNT, -1);
+        int activeUnit = -1;
+        int useNormalMap = -1;
+        bool useNormal = false;
+        unsigned int boundVAO = UNKNOWN;
+
+        auto bind = [&](unsigned int unit, unsigned int texture) {
+            if (static_cast<int>(unit) != activeUnit) {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                activeUnit = static_cast<int>(unit);
+            }
+            if (unit >= MAX_TRACKED_UNITS || boundTextures[unit] != texture) {
+                glBindTexture(GL_TEXTURE_2D, texture);
+                if (unit < MAX_TRACKED_UNITS) boundTextures[unit] = texture;
+            }
+        };
+        auto sampler = [&](int slot, int unit) {
+            if (slot < 0 || samplerUnits[slot] == unit) return;
+            glUniform1i(locations[slot], unit);
+            samplerUnits[slot] = unit;
+        };
+
+        for (const DrawPacket& packet : buffer.packets) {
+            // RenderObject::prepare
+            if (packet.diffuseOverride != 0) {
+                bind(0, packet.diffuseOverride);
+                sampler(DrawTextureSlot(MESH_TEXTURE_DIFFUSE, 1), 0);
+            }
+            if (packet.normalOverride != 0) {
+                bind(1, packet.normalOverride);
+                sampler(DrawTextureSlot(MESH_TEXTURE_NORMAL, 1), 1);
+            }
+            int wantNormalMap = packet.normalOverride != 0 ? 1 : 0;
+            if (wantNormalMap != useNormalMap) {
+                glUniform1i(locations[DRAW_UNIFORM_USE_NORMAL_MAP], wantNormalMap);
+                useNormalMap = wantNormalMap;
+            }
+            glUniform2fv(locations[DRAW_UNIFORM_UV_SCALE], 1, &packet.uvScale[0]);
+            glUniformMatrix4fv(locations[DRAW_UNIFORM_MODEL], 1, GL_FALSE, &packet.model[0][0]);
+
+            // Mesh::Draw
+            for (unsigned int t = 0; t < packet.textureCount; t++) {
+                const DrawTexture& texture = buffer.textures[packet.firstTexture + t];
+                sampler(texture.slot, texture.unit);
+                bind(texture.unit, texture.texture);
+            }
+            if (packet.meshNormal && !useNormal) {
+                glUniform1i(locations[DRAW_UNIFORM_USE_NORMAL], 1);
+                useNormal = true;
+            }
+            if (packet.vertexArray != boundVAO) {
+                glBindVertexArray(packet.vertexArray);
+                boundVAO = packet.vertexArray;
+            }
+            glDrawElements(GL_TRIANGLES, packet.indexCount, GL_UNSIGNED_INT, 0);
+        }
+        glBindVertexArray(0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+private:
+    static const unsigned int MAX_TRACKED_UNITS = 16;
+    static const unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+    struct ProgramUniforms {
+        unsigned int program = 0;
+        GLint locations[DRAW_UNIFORM_COUNT];
+    };
+    std::vector<ProgramUniforms> programs;   // 程序很少，线性查找就够了
+
+    const GLint* locationsFor(unsigned int program) {
+        for (const ProgramUniforms& entry : programs)
+            if (entry.program == program) return entry.locations;
+        ProgramUniforms entry;
+        entry.program = program;
+        for (int slot = 0; slot < DRAW_UNIFORM_COUNT; slot++)
+            entry.locations[slot] = glGetUniformLocation(program, DrawUniformName(slot).c_str());
+        programs.push_back(entry);
+        return programs.back().locations;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef COMPUTEBLUR_H
+#define COMPUTEBLUR_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+
+#include "shader.h"
+#include "blurKernel.h"
+#include "resourceTracker.h"
+
+// ==========================================================
+// 计算着色器版本的可分离模糊 (blur.comp)
+// 每个工作组把一段像素 + 两侧的边读进共享内存再做卷积，每个纹素只从显存读一次。
+// 输入输出都是普通纹理，泛光 / SSAO / 阴影滤波都可以直接拿来用：
+//   blur.SetKernel(BlurKernel::Gaussian(16));
+//   blur.Blur(src, dst, width, height);
+// dst 必须是 GL_RGBA16F (和 blur.comp 里的 image 格式一致)，可以和 src 是同一张
+// ==========================================================
+class ComputeBlur {
+public:
+    static const int TILE_SIZE = 128;  // 和 blur.comp 保持一致
+    static const int MAX_RADIUS = 64;
+
+    ComputeBlur() : shader("shaders/blur.comp") {
+        SetKernel(BlurKernel::Gaussian(4));
+    }
+
+    ~ComputeBlur() {
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, scratch);
+        if (scratch) glDeleteTextures(1, &scratch);
+    }
+
+    // 核的半径超过 MAX_RADIUS 时截断
+    void SetKernel(const BlurKernel& newKernel) {
+        kernel = newKernel;
+        if (kernel.TapCount() > MAX_RADIUS + 1) {
+            std::cout << "ERROR::COMPUTEBLUR:: Kernel radius " << kernel.TapCount() - 1
+                      << " exceeds " << MAX_RADIUS << ", truncated" << std::endl;
+            kernel.weights.resize(MAX_RADIUS + 1);
+            kernel.offsets.resize(MAX_RADIUS + 1);
+        }
+    }
+
+    int Radius() const { return kernel.TapCount() - 1; }
+
+    void Blur(unsigned int srcTexture, unsigned int dstTexture, int width, int height) {
+        ensureScratch(width, height);
+        shader.use();
+        shader.setInt("radius", Radius());
+        shader.setFloatArray("weights", kernel.weights.data(), kernel.TapCount());
+
+        // 水平：src -> scratch
+        dispatch(srcTexture, scratch, width, height, true);
+        // 垂直：scratch -> dst，第二遍要读第一遍 imageStore 的结果
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        dispatch(scratch, dstTexture, width, height, false);
+        // 后面可能当纹理采样，也可能当帧缓冲附件
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+    }
+
+private:
+    Shader shader;
+    BlurKernel kernel;
+    unsigned int scratch = 0;
+    int scratchWidth = 0, scratchHeight = 0;
+
+    void dispatch(unsigned int src, unsigned int dst, int width, int height, bool horizontal) {
+        shader.setBool("horizontal", horizontal);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, src);
+        glBindImageTexture(0, dst, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        int lineLength = horizontal ? width : height;
+        int lines = horizontal ? height : width;
+        glDispatchCompute((lineLength + TILE_SIZE - 1) / TILE_SIZE, lines, 1);
+    }
+
+    // 中间结果用的纹理，尺寸变了才重新分配
+    void ensureScratch(int width, int height) {
+        if (scratch && scratchWidth == width && scratchHeight == height) return;
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, scratch);
+        if (scratch) glDeleteTextures(1, &scratch);
+        glGenTextures(1, &scratch);
+        glBindTexture(GL_TEXTURE_2D, scratch);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, scratch, ResourceTracker::TextureBytes(width, height, GL_RGBA16F, false),
+                                     RESOURCE_RENDER_TARGET, "blur scratch");
+        scratchWidth = width;
+        scratchHeight = height;
+    }
+};
+
+#endif
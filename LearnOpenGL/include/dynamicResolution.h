@@ -0,0 +1,79 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <algorithm>
+#include <cmath>
+
+// 动态分辨率的参数 (在 GUI 里调)
+struct DynamicResolutionSettings {
+    bool enabled = false;
+    float targetMs = 16.6f;   // 目标 GPU 帧时间
+    float minScale = 0.5f;    // 每个轴的缩放下限
+    float maxScale = 1.0f;
+    float sharpness = 0.5f;   // 升采样时的对比度自适应锐化强度 (0 ~ 1)
+};
+
+// ==========================================================
+// 动态分辨率控制器
+// 场景帧缓冲按最大分辨率分配，每帧只渲染左下角 scale 大小的子区域 (改视口即可，不用重建纹理)，
+// 再由 upscale.frag 放大回全分辨率。
+// GPU 时间大致和像素数 (scale^2) 成正比，所以按 sqrt(目标 / 实测) 调整 scale，
+// 再加上阻尼和死区，避免每帧来回抖动
+// ==========================================================
+class DynamicResolution {
+public:
+    DynamicResolutionSettings settings;
+
+    DynamicResolution(int width, int height) : fullWidth(width), fullHeight(height) {}
+
+    // 每拿到一次新的 GPU 帧时间调用一次
+    void Update(float gpuMs) {
+        lastGpuMs = gpuMs;
+        if (!settings.enabled) {
+            scale = 1.0f;
+            return;
+        }
+        if (gpuMs <= 0.0f) return;
+        // 死区：比目标快一点点或慢一点点都不动
+        bool over = gpuMs > settings.targetMs;
+        bool wellUnder = gpuMs < settings.targetMs * HEADROOM;
+        if (over || wellUnder) {
+            float desired = scale * std::sqrt(settings.targetMs * (over ? 1.0f : HEADROOM) / gpuMs);
+            // 降得快 (掉帧更难受)，升得慢
+            float rate = over ? DOWN_RATE : UP_RATE;
+            scale += (desired - scale) * rate;
+        }
+        scale = std::clamp(scale, settings.minScale, settings.maxScale);
+    }
+
+    // 窗口尺寸变了：scale 不变，渲染尺寸按新的全分辨率重新算
+    void Resize(int width, int height) {
+        fullWidth = width;
+        fullHeight = height;
+    }
+
+    float Scale() const { return scale; }
+    float LastGpuMs() const { return lastGpuMs; }
+
+    // 实际渲染尺寸，对齐到 8 像素，scale 的微小变化不会让每帧尺寸都不同
+    int RenderWidth() const { return alignedSize(fullWidth); }
+    int RenderHeight() const { return alignedSize(fullHeight); }
+    bool IsFullResolution() const { return RenderWidth() == fullWidth && RenderHeight() == fullHeight; }
+
+private:
+    static constexpr float HEADROOM = 0.85f;  // 低于目标的 85% 才开始升分辨率
+    static constexpr float DOWN_RATE = 0.5f;
+    static constexpr float UP_RATE = 0.1f;
+
+    int fullWidth, fullHeight;
+    float scale = 1.0f;
+    float lastGpuMs = 0.0f;
+
+    int alignedSize(int full) const {
+        int size = static_cast<int>(full * scale);
+        if (size >= full) return full;
+        return std::max(8, (size + 7) / 8 * 8);
+    }
+};
+
+#endif
@@ -0,0 +1,1235 @@
+#ifndef GLCAPTURE_H
+#define GLCAPTURE_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "glStats.h"
+
+// ==========================================================
+// GL 命令流录制 / 回放 (离线分析驱动开销用)
+// 录制：和 GlStats 一样把 glad 的函数指针换成包装，每个调用连同参数和引用的数据 (顶点、纹理像素、
+// 着色器源码、uniform 数组 ...) 顺序写进一个二进制文件，每帧开头插一个帧标记。
+// 回放：main_replay 读文件，先把第一个要分析的帧之前的部分 (资源创建 + 预热帧) 执行一遍，
+// 再把录下来的帧反复执行，逐个调用计时。
+// - 录制必须在 gladLoadGL 之后、创建任何 GL 对象之前开始 (Renderer 构造之前)，
+//   因为回放要从头重建所有对象；对象名 / uniform location / fence 回放时重新生成再映射
+// - 只录下面列出的入口；查询类 (glGetString / glGetShaderiv / glCheckFramebufferStatus ...) 不录，
+//   会阻塞的读回 (glReadPixels / glGetBufferSubData / glGetQueryObject* / glMapBufferRange) 录下来，回放时读到临时内存
+// - ImGui 用它自己的 GL 加载器，不经过 glad，录不到 (它会把改过的状态恢复，不影响回放)
+// - 只在 GL 上下文所在的线程调用；文件里指针 / GLsizeiptr 按本机宽度存，录制和回放要同一种平台
+// ==========================================================
+
+// 只有标量参数的入口：X(名字, 参数映射, 参数表, 实参)
+// 参数映射每个字符对应一个参数：e = 原样，T 纹理，B 缓冲，F 帧缓冲，R 渲染缓冲，V VAO，P 程序 / 着色器，
+// Q 查询对象，U = glUseProgram 的程序 (回放时记下当前程序)，L = uniform location，O = 缓冲里的偏移 (指针参数)
+#define ENTRO_GL_CAPTURE_CALLS(X) \
+    X(ActiveTexture, "e", (GLenum texture), (texture)) \
+    X(AttachShader, "PP", (GLuint program, GLuint shader), (program, shader)) \
+    X(CompileShader, "P", (GLuint shader), (shader)) \
+    X(LinkProgram, "P", (GLuint program), (program)) \
+    X(DeleteShader, "P", (GLuint shader), (shader)) \
+    X(DeleteProgram, "P", (GLuint program), (program)) \
+    X(UseProgram, "U", (GLuint program), (program)) \
+    X(BeginQuery, "eQ", (GLenum target, GLuint id), (target, id)) \
+    X(EndQuery, "e", (GLenum target), (target)) \
+    X(QueryCounter, "Qe", (GLuint id, GLenum target), (id, target)) \
+    X(BindBufferBase, "eeB", (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+    X(BindFramebuffer, "eF", (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+    X(BindRenderbuffer, "eR", (GLenum target, GLuint renderbuffer), (target, renderbuffer)) \
+    X(BindTexture, "eT", (GLenum target, GLuint texture), (target, texture)) \
+    X(BindImageTexture, "eTeeeee", (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format), (unit, texture, level, layered, layer, access, format)) \
+    X(BindVertexArray, "V", (GLuint array), (array)) \
+    X(BlendEquation, "e", (GLenum mode), (mode)) \
+    X(BlendFunc, "ee", (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+    X(BlitFramebuffer, "eeeeeeeeee", (GLint sx0, GLint sy0, GLint sx1, GLint sy1, GLint dx0, GLint dy0, GLint dx1, GLint dy1, GLbitfield mask, GLenum filter), (sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter)) \
+    X(Clear, "e", (GLbitfield mask), (mask)) \
+    X(ClearColor, "eeee", (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+    X(CullFace, "e", (GLenum mode), (mode)) \
+    X(DepthFunc, "e", (GLenum func), (func)) \
+    X(Enable, "e", (GLenum cap), (cap)) \
+    X(Disable, "e", (GLenum cap), (cap)) \
+    X(DrawBuffer, "e", (GLenum buf), (buf)) \
+    X(ReadBuffer, "e", (GLenum src), (src)) \
+    X(PolygonMode, "ee", (GLenum face, GLenum mode), (face, mode)) \
+    X(Scissor, "eeee", (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+    X(Viewport, "eeee", (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+    X(MemoryBarrier, "e", (GLbitfield barriers), (barriers)) \
+    X(Finish, "", (), ()) \
+    X(Flush, "", (), ()) \
+    X(DispatchCompute, "eee", (GLuint x, GLuint y, GLuint z), (x, y, z)) \
+    X(DrawArrays, "eee", (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+    X(DrawArraysInstanced, "eeee", (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances)) \
+    X(DrawElements, "eeeO", (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+    X(DrawElementsInstanced, "eeeOe", (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances), (mode, count, type, indices, instances)) \
+    X(EnableVertexAttribArray, "e", (GLuint index), (index)) \
+    X(VertexAttribPointer, "eeeeeO", (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer)) \
+    X(FramebufferTexture2D, "eeeTe", (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level)) \
+    X(FramebufferRenderbuffer, "eeeR", (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer)) \
+    X(RenderbufferStorage, "eeee", (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), (target, internalformat, width, height)) \
+    X(GenerateMipmap, "e", (GLenum target), (target)) \
+    X(TexParameteri, "eee", (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+    X(TexStorage2D, "eeeee", (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (target, levels, internalformat, width, height)) \
+    X(TexStorage2DMultisample, "eeeeee", (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations)) \
+    X(Uniform1i, "Le", (GLint location, GLint v0), (location, v0)) \
+    X(Uniform1f, "Le", (GLint location, GLfloat v0), (location, v0)) \
+    X(Uniform2f, "Lee", (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1)) \
+    X(Uniform2i, "Lee", (GLint location, GLint v0, GLint v1), (location, v0, v1)) \
+    X(Uniform3f, "Leee", (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2)) \
+    X(Uniform4f, "Leeee", (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+
+// 同样只有标量参数，但录制时要顺便记下状态 (上传数据的大小和来源要用)，包装函数单独写
+#define ENTRO_GL_CAPTURE_TRACKED_CALLS(X) \
+    X(BindBuffer, "eB", (GLenum target, GLuint buffer), (target, buffer)) \
+    X(PixelStorei, "ee", (GLenum pname, GLint param), (pname, param))
+
+// glGen* / glDelete* 成对的对象：X(后缀, 映射字符)
+#define ENTRO_GL_CAPTURE_OBJECTS(X) \
+    X(Textures, 'T') \
+    X(Buffers, 'B') \
+    X(Framebuffers, 'F') \
+    X(Renderbuffers, 'R') \
+    X(VertexArrays, 'V') \
+    X(Queries, 'Q')
+
+// uniform 数组：X(名字, 每个元素几个 float)
+#define ENTRO_GL_CAPTURE_UNIFORM_VECTORS(X) \
+    X(Uniform1fv, 1) \
+    X(Uniform2fv, 2) \
+    X(Uniform3fv, 3) \
+    X(Uniform4fv, 4)
+
+#define ENTRO_GL_CAPTURE_UNIFORM_MATRICES(X) \
+    X(UniformMatrix2fv, 4) \
+    X(UniformMatrix3fv, 9) \
+    X(UniformMatrix4fv, 16)
+
+// 带数据 / 有返回值的入口，录制和回放都单独写
+#define ENTRO_GL_CAPTURE_SPECIAL_CALLS(X) \
+    X(CreateShader) \
+    X(CreateProgram) \
+    X(ShaderSource) \
+    X(GetUniformLocation) \
+    X(BufferData) \
+    X(BufferSubData) \
+    X(ClearBufferData) \
+    X(TexImage2D) \
+    X(TexSubImage2D) \
+    X(ClearTexImage) \
+    X(TexParameterfv) \
+    X(ClearBufferfv) \
+    X(DrawBuffers) \
+    X(ReadPixels) \
+    X(GetBufferSubData) \
+    X(GetQueryObjectui64v) \
+    X(GetQueryObjectiv) \
+    X(FenceSync) \
+    X(ClientWaitSync) \
+    X(DeleteSync) \
+    X(MapBufferRange) \
+    X(UnmapBuffer)
+
+enum GlCaptureCall {
+#define ENTRO_GL_CAPTURE_ENUM(name, spec, params, args) CAPTURE_##name,
+    ENTRO_GL_CAPTURE_CALLS(ENTRO_GL_CAPTURE_ENUM)
+    ENTRO_GL_CAPTURE_TRACKED_CALLS(ENTRO_GL_CAPTURE_ENUM)
+#undef ENTRO_GL_CAPTURE_ENUM
+#define ENTRO_GL_CAPTURE_ENUM(suffix, kind) CAPTURE_Gen##suffix, CAPTURE_Delete##suffix,
+    ENTRO_GL_CAPTURE_OBJECTS(ENTRO_GL_CAPTURE_ENUM)
+#undef ENTRO_GL_CAPTURE_ENUM
+#define ENTRO_GL_CAPTURE_ENUM(name, components) CAPTURE_##name,
+    ENTRO_GL_CAPTURE_UNIFORM_VECTORS(ENTRO_GL_CAPTURE_ENUM)
+    ENTRO_GL_CAPTURE_UNIFORM_MATRICES(ENTRO_GL_CAPTURE_ENUM)
+#undef ENTRO_GL_CAPTURE_ENUM
+#define ENTRO_GL_CAPTURE_ENUM(name) CAPTURE_##name,
+    ENTRO_GL_CAPTURE_SPECIAL_CALLS(ENTRO_GL_CAPTURE_ENUM)
+#undef ENTRO_GL_CAPTURE_ENUM
+    CAPTURE_FRAME,       // 帧标记，后面跟帧号
+    CAPTURE_END,
+    CAPTURE_CALL_COUNT
+};
+
+inline const char* GlCaptureCallName(int call) {
+    static const char* names[CAPTURE_CALL_COUNT] = {
+#define ENTRO_GL_CAPTURE_NAME(name, spec, params, args) "gl" #name,
+        ENTRO_GL_CAPTURE_CALLS(ENTRO_GL_CAPTURE_NAME)
+        ENTRO_GL_CAPTURE_TRACKED_CALLS(ENTRO_GL_CAPTURE_NAME)
+#undef ENTRO_GL_CAPTURE_NAME
+#define ENTRO_GL_CAPTURE_NAME(suffix, kind) "glGen" #suffix, "glDelete" #suffix,
+        ENTRO_GL_CAPTURE_OBJECTS(ENTRO_GL_CAPTURE_NAME)
+#undef ENTRO_GL_CAPTURE_NAME
+#define ENTRO_GL_CAPTURE_NAME(name, components) "gl" #name,
+        ENTRO_GL_CAPTURE_UNIFORM_VECTORS(ENTRO_GL_CAPTURE_NAME)
+        ENTRO_GL_CAPTURE_UNIFORM_MATRICES(ENTRO_GL_CAPTURE_NAME)
+#undef ENTRO_GL_CAPTURE_NAME
+#define ENTRO_GL_CAPTURE_NAME(name) "gl" #name,
+        ENTRO_GL_CAPTURE_SPECIAL_CALLS(ENTRO_GL_CAPTURE_NAME)
+#undef ENTRO_GL_CAPTURE_NAME
+        "frame", "end"
+    };
+    return call >= 0 && call < CAPTURE_CALL_COUNT ? names[call] : "?";
+}
+
+// 文件头
+struct GlCaptureHeader {
+    char magic[8] = { 'E', 'N', 'T', 'R', 'O', 'G', 'L', 'C' };
+    uint32_t version = 1;
+    uint32_t pointerSize = sizeof(void*);
+    int32_t width = 0, height = 0;          // 输出帧缓冲的尺寸
+    uint32_t outputFramebuffer = 0;         // 录制时画到哪个帧缓冲 (回放时换成回放程序自己的)
+    uint32_t firstFrame = 0;                // 从第几帧开始是要分析的帧，之前的部分回放时只执行一遍
+};
+
+// 上传 / 读回数据按行对齐后的字节数 (最后一行不补齐)
+inline size_t GlAlignedPixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type, int alignment) {
+    if (width <= 0 || height <= 0) return 0;
+    size_t row = GlPixelDataBytes(width, 1, format, type);
+    size_t stride = alignment > 1 ? (row + alignment - 1) / alignment * alignment : row;
+    return stride * (height - 1) + row;
+}
+
+// ==========================================================
+// 录制
+// ==========================================================
+class GlCapture {
+public:
+    static GlCapture& Get() {
+        static GlCapture instance;
+        return instance;
+    }
+
+    ~GlCapture() { Finish(); }
+
+    // 开始录制：第 firstFrame 帧 (从 0 数) 起录 frameCount 帧，录完自动写完文件；之前的帧和资源创建作为前导也录下来。
+    // outputFramebuffer 是应用画最终结果的帧缓冲 (窗口是 0，无窗口是 HeadlessContext 的 FBO)
+    bool Start(const std::string& path, unsigned int firstFrame, unsigned int frameCount,
+               unsigned int outputFramebuffer, int width, int height) {
+        if (recording || installed) {
+            std::cout << "ERROR::CAPTURE:: Capture can only be started once" << std::endl;
+            return false;
+        }
+        file.open(path, std::ios::binary);
+        if (!file) {
+            std::cout << "ERROR::CAPTURE:: Failed to open " << path << std::endl;
+            return false;
+        }
+        GlCaptureHeader header;
+        header.width = width;
+        header.height = height;
+        header.outputFramebuffer = outputFramebuffer;
+        header.firstFrame = firstFrame;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        this->path = path;
+        lastFrame = firstFrame + std::max(frameCount, 1u);
+        install();
+        recording = true;
+        return true;
+    }
+
+    // 每帧开头调用 (Renderer::RenderFrame)：写帧标记，录够了就收尾
+    void BeginFrame() {
+        if (!recording) return;
+        if (frame >= lastFrame) {
+            Finish();
+            return;
+        }
+        begin(CAPTURE_FRAME);
+        put(static_cast<uint32_t>(frame));
+        frame++;
+    }
+
+    void Finish() {
+        if (!recording) return;
+        recording = false;
+        begin(CAPTURE_END);
+        size_t size = static_cast<size_t>(file.tellp());
+        file.close();
+        std::cout << "Capture: " << calls << " calls, " << frame << " frames, "
+                  << size / (1024.0 * 1024.0) << " MB -> " << path << std::endl;
+    }
+
+    bool Recording() const { return recording; }
+
+private:
+    bool installed = false;
+    bool recording = false;
+    std::ofstream file;
+    std::string path;
+    unsigned int frame = 0, lastFrame = 0;
+    unsigned long long calls = 0;
+
+    // 录制时要知道的状态
+    GLuint unpackBuffer = 0, packBuffer = 0;
+    GLint unpackAlignment = 4, packAlignment = 4;
+    std::unordered_map<GLsync, uint32_t> syncs;
+    uint32_t nextSync = 1;
+    struct Mapping { void* pointer = nullptr; GLsizeiptr length = 0; GLbitfield access = 0; };
+    std::unordered_map<GLenum, Mapping> mappings;
+
+    void begin(GlCaptureCall call) {
+        put(static_cast<uint16_t>(call));
+        calls++;
+    }
+
+    template<typename T>
+    void put(T value) {
+        if constexpr (std::is_pointer_v<T>) {
+            uint64_t offset = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+            file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        } else {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    template<typename... A>
+    void values(A... args) { (put(args), ...); }
+
+    // 有无数据 + 字节数 + 数据
+    void blob(const void* data, size_t size) {
+        put(static_cast<uint8_t>(data != nullptr));
+        if (!data) return;
+        put(static_cast<uint64_t>(size));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    void names(GLsizei n, const GLuint* ids) {
+        put(n);
+        file.write(reinterpret_cast<const char*>(ids), sizeof(GLuint) * std::max(n, 0));
+    }
+
+    // 上传的像素：绑定了 PIXEL_UNPACK_BUFFER 时指针是缓冲里的偏移
+    void pixels(const void* data, GLsizei width, GLsizei height, GLenum format, GLenum type) {
+        put(static_cast<uint8_t>(unpackBuffer != 0));
+        if (unpackBuffer) put(data);
+        else blob(data, GlAlignedPixelBytes(width, height, format, type, unpackAlignment));
+    }
+
+    uint32_t syncId(GLsync sync) {
+        auto found = syncs.find(sync);
+        return found != syncs.end() ? found->second : 0;
+    }
+
+    void install() {
+        installed = true;
+#define ENTRO_GL_CAPTURE_INSTALL(name) \
+        original##name = glad_gl##name; \
+        if (glad_gl##name) glad_gl##name = wrap##name;
+#define ENTRO_GL_CAPTURE_INSTALL_CALL(name, spec, params, args) ENTRO_GL_CAPTURE_INSTALL(name)
+        ENTRO_GL_CAPTURE_CALLS(ENTRO_GL_CAPTURE_INSTALL_CALL)
+        ENTRO_GL_CAPTURE_TRACKED_CALLS(ENTRO_GL_CAPTURE_INSTALL_CALL)
+#undef ENTRO_GL_CAPTURE_INSTALL_CALL
+#define ENTRO_GL_CAPTURE_INSTALL_OBJECT(suffix, kind) ENTRO_GL_CAPTURE_INSTALL(Gen##suffix) ENTRO_GL_CAPTURE_INSTALL(Delete##suffix)
+        ENTRO_GL_CAPTURE_OBJECTS(ENTRO_GL_CAPTURE_INSTALL_OBJECT)
+#undef ENTRO_GL_CAPTURE_INSTALL_OBJECT
+#define ENTRO_GL_CAPTURE_INSTALL_UNIFORM(name, components) ENTRO_GL_CAPTURE_INSTALL(name)
+        ENTRO_GL_CAPTURE_UNIFORM_VECTORS(ENTRO_GL_CAPTURE_INSTALL_UNIFORM)
+        ENTRO_GL_CAPTURE_UNIFORM_MATRICES(ENTRO_GL_CAPTURE_INSTALL_UNIFORM)
+#undef ENTRO_GL_CAPTURE_INSTALL_UNIFORM
+        ENTRO_GL_CAPTURE_SPECIAL_CALLS(ENTRO_GL_CAPTURE_INSTALL)
+#undef ENTRO_GL_CAPTURE_INSTALL
+    }
+
+#define ENTRO_GL_CAPTURE_WRAP(name, spec, params, args) \
+    static inline decltype(glad_gl##name) original##name = nullptr; \
+    static void APIENTRY wrap##name params { \
+        GlCapture& capture = Get(); \
+        if (capture.recording) { \
+            capture.begin(CAPTURE_##name); \
+            capture.values args; \
+        } \
+        original##name args; \
+    }
+    ENTRO_GL_CAPTURE_CALLS(ENTRO_GL_CAPTURE_WRAP)
+#undef ENTRO_GL_CAPTURE_WRAP
+
+    static inline PFNGLBINDBUFFERPROC originalBindBuffer = nullptr;
+    static void APIENTRY wrapBindBuffer(GLenum target, GLuint buffer) {
+        GlCapture& capture = Get();
+        if (target == GL_PIXEL_UNPACK_BUFFER) capture.unpackBuffer = buffer;
+        else if (target == GL_PIXEL_PACK_BUFFER) capture.packBuffer = buffer;
+        if (capture.recording) {
+            capture.begin(CAPTURE_BindBuffer);
+            capture.values(target, buffer);
+        }
+        originalBindBuffer(target, buffer);
+    }
+
+    static inline PFNGLPIXELSTOREIPROC originalPixelStorei = nullptr;
+    static void APIENTRY wrapPixelStorei(GLenum pname, GLint param) {
+        GlCapture& capture = Get();
+        if (pname == GL_UNPACK_ALIGNMENT) capture.unpackAlignment = param;
+        else if (pname == GL_PACK_ALIGNMENT) capture.packAlignment = param;
+        if (capture.recording) {
+            capture.begin(CAPTURE_PixelStorei);
+            capture.values(pname, param);
+        }
+        originalPixelStorei(pname, param);
+    }
+
+    // glGen*：先调用拿到名字再记；glDelete*：记下要删的名字
+#define ENTRO_GL_CAPTURE_WRAP(suffix, kind) \
+    static inline decltype(glad_glGen##suffix) originalGen##suffix = nullptr; \
+    static void APIENTRY wrapGen##suffix(GLsizei n, GLuint* ids) { \
+        originalGen##suffix(n, ids); \
+        GlCapture& capture = Get(); \
+        if (!capture.recording) return; \
+        capture.begin(CAPTURE_Gen##suffix); \
+        capture.names(n, ids); \
+    } \
+    static inline decltype(glad_glDelete##suffix) originalDelete##suffix = nullptr; \
+    static void APIENTRY wrapDelete##suffix(GLsizei n, const GLuint* ids) { \
+        GlCapture& capture = Get(); \
+        if (capture.recording) { \
+            capture.begin(CAPTURE_Delete##suffix); \
+            capture.names(n, ids); \
+        } \
+        originalDelete##suffix(n, ids); \
+    }
+    ENTRO_GL_CAPTURE_OBJECTS(ENTRO_GL_CAPTURE_WRAP)
+#undef ENTRO_GL_CAPTURE_WRAP
+
+#define ENTRO_GL_CAPTURE_WRAP(name, components) \
+    static inline decltype(glad_gl##name) original##name = nullptr; \
+    static void APIENTRY wrap##name(GLint location, GLsizei count, const GLfloat* value) { \
+        GlCapture& capture = Get(); \
+        if (capture.recording) { \
+            capture.begin(CAPTURE_##name); \
+            capture.values(location, count); \
+            capture.blob(value, sizeof(GLfloat) * components * std::max(count, 0)); \
+        } \
+        original##name(location, count, value); \
+    }
+    ENTRO_GL_CAPTURE_UNIFORM_VECTORS(ENTRO_GL_CAPTURE_WRAP)
+#undef ENTRO_GL_CAPTURE_WRAP
+
+#define ENTRO_GL_CAPTURE_WRAP(name, components) \
+    static inline decltype(glad_gl##name) original##name = nullptr; \
+    static void APIENTRY wrap##name(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) { \
+        GlCapture& capture = Get(); \
+        if (capture.recording) { \
+            capture.begin(CAPTURE_##name); \
+            capture.values(location, count, transpose); \
+            capture.blob(value, sizeof(GLfloat) * components * std::max(count, 0)); \
+        } \
+        original##name(location, count, transpose, value); \
+    }
+    ENTRO_GL_CAPTURE_UNIFORM_MATRICES(ENTRO_GL_CAPTURE_WRAP)
+#undef ENTRO_GL_CAPTURE_WRAP
+
+    static inline PFNGLCREATESHADERPROC originalCreateShader = nullptr;
+    static GLuint APIENTRY wrapCreateShader(GLenum type) {
+        GLuint shader = originalCreateShader(type);
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_CreateShader);
+            capture.values(type, shader);
+        }
+        return shader;
+    }
+
+    static inline PFNGLCREATEPROGRAMPROC originalCreateProgram = nullptr;
+    static GLuint APIENTRY wrapCreateProgram() {
+        GLuint program = originalCreateProgram();
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_CreateProgram);
+            capture.values(program);
+        }
+        return program;
+    }
+
+    // 每段源码单独存 (length 为空或者 < 0 表示以 0 结尾)
+    static inline PFNGLSHADERSOURCEPROC originalShaderSource = nullptr;
+    static void APIENTRY wrapShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ShaderSource);
+            capture.values(shader, count);
+            for (GLsizei i = 0; i < count; i++) {
+                size_t length = lengths && lengths[i] >= 0 ? static_cast<size_t>(lengths[i]) : strlen(strings[i]);
+                capture.blob(strings[i], length);
+            }
+        }
+        originalShaderSource(shader, count, strings, lengths);
+    }
+
+    static inline PFNGLGETUNIFORMLOCATIONPROC originalGetUniformLocation = nullptr;
+    static GLint APIENTRY wrapGetUniformLocation(GLuint program, const GLchar* name) {
+        GLint location = originalGetUniformLocation(program, name);
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_GetUniformLocation);
+            capture.values(program, location);
+            capture.blob(name, strlen(name) + 1);
+        }
+        return location;
+    }
+
+    static inline PFNGLBUFFERDATAPROC originalBufferData = nullptr;
+    static void APIENTRY wrapBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_BufferData);
+            capture.values(target, size, usage);
+            capture.blob(data, static_cast<size_t>(size));
+        }
+        originalBufferData(target, size, data, usage);
+    }
+
+    static inline PFNGLBUFFERSUBDATAPROC originalBufferSubData = nullptr;
+    static void APIENTRY wrapBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_BufferSubData);
+            capture.values(target, offset, size);
+            capture.blob(data, static_cast<size_t>(size));
+        }
+        originalBufferSubData(target, offset, size, data);
+    }
+
+    static inline PFNGLCLEARBUFFERDATAPROC originalClearBufferData = nullptr;
+    static void APIENTRY wrapClearBufferData(GLenum target, GLenum internalformat, GLenum format, GLenum type, const void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ClearBufferData);
+            capture.values(target, internalformat, format, type);
+            capture.blob(data, GlPixelDataBytes(1, 1, format, type));
+        }
+        originalClearBufferData(target, internalformat, format, type, data);
+    }
+
+    static inline PFNGLTEXIMAGE2DPROC originalTexImage2D = nullptr;
+    static void APIENTRY wrapTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                        GLint border, GLenum format, GLenum type, const void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_TexImage2D);
+            capture.values(target, level, internalformat, width, height, border, format, type);
+            capture.pixels(data, width, height, format, type);
+        }
+        originalTexImage2D(target, level, internalformat, width, height, border, format, type, data);
+    }
+
+    static inline PFNGLTEXSUBIMAGE2DPROC originalTexSubImage2D = nullptr;
+    static void APIENTRY wrapTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+                                           GLenum format, GLenum type, const void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_TexSubImage2D);
+            capture.values(target, level, xoffset, yoffset, width, height, format, type);
+            capture.pixels(data, width, height, format, type);
+        }
+        originalTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, data);
+    }
+
+    static inline PFNGLCLEARTEXIMAGEPROC originalClearTexImage = nullptr;
+    static void APIENTRY wrapClearTexImage(GLuint texture, GLint level, GLenum format, GLenum type, const void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ClearTexImage);
+            capture.values(texture, level, format, type);
+            capture.blob(data, GlPixelDataBytes(1, 1, format, type));
+        }
+        originalClearTexImage(texture, level, format, type, data);
+    }
+
+    static inline PFNGLTEXPARAMETERFVPROC originalTexParameterfv = nullptr;
+    static void APIENTRY wrapTexParameterfv(GLenum target, GLenum pname, const GLfloat* params) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_TexParameterfv);
+            capture.values(target, pname);
+            capture.blob(params, sizeof(GLfloat) * (pname == GL_TEXTURE_BORDER_COLOR ? 4 : 1));
+        }
+        originalTexParameterfv(target, pname, params);
+    }
+
+    static inline PFNGLCLEARBUFFERFVPROC originalClearBufferfv = nullptr;
+    static void APIENTRY wrapClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ClearBufferfv);
+            capture.values(buffer, drawbuffer);
+            capture.blob(value, sizeof(GLfloat) * (buffer == GL_COLOR ? 4 : 1));
+        }
+        originalClearBufferfv(buffer, drawbuffer, value);
+    }
+
+    static inline PFNGLDRAWBUFFERSPROC originalDrawBuffers = nullptr;
+    static void APIENTRY wrapDrawBuffers(GLsizei n, const GLenum* bufs) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_DrawBuffers);
+            capture.put(n);
+            capture.blob(bufs, sizeof(GLenum) * std::max(n, 0));
+        }
+        originalDrawBuffers(n, bufs);
+    }
+
+    // 读回只记参数，回放时读到临时内存；读进 PIXEL_PACK_BUFFER 时记偏移
+    static inline PFNGLREADPIXELSPROC originalReadPixels = nullptr;
+    static void APIENTRY wrapReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ReadPixels);
+            capture.values(x, y, width, height, format, type, static_cast<uint8_t>(capture.packBuffer != 0), capture.packAlignment);
+            capture.put(capture.packBuffer ? static_cast<const void*>(data) : nullptr);
+        }
+        originalReadPixels(x, y, width, height, format, type, data);
+    }
+
+    static inline PFNGLGETBUFFERSUBDATAPROC originalGetBufferSubData = nullptr;
+    static void APIENTRY wrapGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void* data) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_GetBufferSubData);
+            capture.values(target, offset, size);
+        }
+        originalGetBufferSubData(target, offset, size, data);
+    }
+
+    static inline PFNGLGETQUERYOBJECTUI64VPROC originalGetQueryObjectui64v = nullptr;
+    static void APIENTRY wrapGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_GetQueryObjectui64v);
+            capture.values(id, pname);
+        }
+        originalGetQueryObjectui64v(id, pname, params);
+    }
+
+    static inline PFNGLGETQUERYOBJECTIVPROC originalGetQueryObjectiv = nullptr;
+    static void APIENTRY wrapGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_GetQueryObjectiv);
+            capture.values(id, pname);
+        }
+        originalGetQueryObjectiv(id, pname, params);
+    }
+
+    // fence 是指针，文件里换成从 1 开始的编号
+    static inline PFNGLFENCESYNCPROC originalFenceSync = nullptr;
+    static GLsync APIENTRY wrapFenceSync(GLenum condition, GLbitfield flags) {
+        GLsync sync = originalFenceSync(condition, flags);
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            uint32_t id = capture.nextSync++;
+            capture.syncs[sync] = id;
+            capture.begin(CAPTURE_FenceSync);
+            capture.values(condition, flags, id);
+        }
+        return sync;
+    }
+
+    static inline PFNGLCLIENTWAITSYNCPROC originalClientWaitSync = nullptr;
+    static GLenum APIENTRY wrapClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_ClientWaitSync);
+            capture.values(capture.syncId(sync), flags, timeout);
+        }
+        return originalClientWaitSync(sync, flags, timeout);
+    }
+
+    static inline PFNGLDELETESYNCPROC originalDeleteSync = nullptr;
+    static void APIENTRY wrapDeleteSync(GLsync sync) {
+        GlCapture& capture = Get();
+        if (capture.recording) {
+            capture.begin(CAPTURE_DeleteSync);
+            capture.values(capture.syncId(sync));
+        }
+        capture.syncs.erase(sync);
+        originalDeleteSync(sync);
+    }
+
+    // 映射写入的内容在 Unmap 时整段记下来
+    static inline PFNGLMAPBUFFERRANGEPROC originalMapBufferRange = nullptr;
+    static void* APIENTRY wrapMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        void* pointer = originalMapBufferRange(target, offset, length, access);
+        GlCapture& capture = Get();
+        capture.mappings[target] = { pointer, length, access };
+        if (capture.recording) {
+            capture.begin(CAPTURE_MapBufferRange);
+            capture.values(target, offset, length, access);
+        }
+        return pointer;
+    }
+
+    static inline PFNGLUNMAPBUFFERPROC originalUnmapBuffer = nullptr;
+    static GLboolean APIENTRY wrapUnmapBuffer(GLenum target) {
+        GlCapture& capture = Get();
+        Mapping mapping = capture.mappings[target];
+        capture.mappings.erase(target);
+        if (capture.recording) {
+            capture.begin(CAPTURE_UnmapBuffer);
+            capture.put(target);
+            bool written = mapping.pointer && (mapping.access & GL_MAP_WRITE_BIT);
+            capture.blob(written ? mapping.pointer : nullptr, static_cast<size_t>(mapping.length));
+        }
+        return originalUnmapBuffer(target);
+    }
+};
+
+// ==========================================================
+// 回放
+// ==========================================================
+
+// 回放时一个调用的耗时 (调用返回为止的 CPU 时间，也就是驱动开销)
+struct GlReplaySample {
+    unsigned int frame = 0;     // 录制时的帧号
+    unsigned int index = 0;     // 帧内第几个调用
+    uint16_t call = 0;
+    double us = 0.0;
+};
+
+class GlReplay {
+public:
+    const GlCaptureHeader& Header() const { return header; }
+
+    bool Load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            std::cout << "ERROR::REPLAY:: Failed to open " << path << std::endl;
+            return false;
+        }
+        data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        GlCaptureHeader expected;
+        if (data.size() < sizeof(header)) {
+            std::cout << "ERROR::REPLAY:: Not a capture file: " << path << std::endl;
+            return false;
+        }
+        memcpy(&header, data.data(), sizeof(header));
+        if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+            std::cout << "ERROR::REPLAY:: Not a capture file or wrong version: " << path << std::endl;
+            return false;
+        }
+        if (header.pointerSize != sizeof(void*)) {
+            std::cout << "ERROR::REPLAY:: Capture was recorded with " << header.pointerSize * 8 << "-bit pointers" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // 执行到第一个要分析的帧之前 (建资源 + 预热帧)。录制时画到的帧缓冲换成 outputFramebuffer
+    bool RunPrelude(unsigned int outputFramebuffer) {
+        output = outputFramebuffer;
+        objects('F')[0] = output;
+        objects('F')[header.outputFramebuffer] = output;
+        cursor = sizeof(header);
+        samples = nullptr;
+        while (!failed) {
+            size_t start = cursor;
+            uint16_t call = get<uint16_t>();
+            if (call == CAPTURE_END) {
+                std::cout << "ERROR::REPLAY:: Capture ends before frame " << header.firstFrame << std::endl;
+                return false;
+            }
+            if (call == CAPTURE_FRAME) {
+                uint32_t index = get<uint32_t>();
+                if (index >= header.firstFrame) {
+                    loopStart = start;
+                    return true;
+                }
+                continue;
+            }
+            execute(call);
+        }
+        return false;
+    }
+
+    // 把录下的帧执行一遍，每个调用的耗时追加到 out (可以为空)；finishEachFrame 时每帧结束 glFinish，
+    // frameMs 里是每帧的墙钟时间
+    bool PlayFrames(bool finishEachFrame, std::vector<GlReplaySample>* out, std::vector<double>& frameMs) {
+        cursor = loopStart;
+        samples = out;
+        auto frameStart = std::chrono::steady_clock::now();
+        bool inFrame = false;
+        auto endFrame = [&]() {
+            if (!inFrame) return;
+            if (finishEachFrame) glFinish();
+            auto now = std::chrono::steady_clock::now();
+            frameMs.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+            frameStart = now;
+        };
+        while (!failed) {
+            uint16_t call = get<uint16_t>();
+            if (call == CAPTURE_END) {
+                endFrame();
+                return true;
+            }
+            if (call == CAPTURE_FRAME) {
+                endFrame();
+                frame = get<uint32_t>();
+                index = 0;
+                inFrame = true;
+                continue;
+            }
+            execute(call);
+            index++;
+        }
+        return false;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    GlCaptureHeader header;
+    std::vector<char> data;
+    size_t cursor = 0;
+    size_t loopStart = 0;
+    bool failed = false;
+    unsigned int output = 0;
+    unsigned int frame = 0, index = 0;
+    std::vector<GlReplaySample>* samples = nullptr;
+
+    // 录制时的名字 -> 回放时的名字，按映射字符分开
+    std::unordered_map<uint32_t, uint32_t> names[128];
+    std::unordered_map<uint64_t, GLint> locations;   // (录制时的程序, location) -> 回放时的 location
+    std::unordered_map<uint32_t, GLsync> syncs;
+    std::unordered_map<GLenum, void*> mappings;
+    GLuint currentProgram = 0;                       // 录制时的名字
+    std::vector<char> scratch;                       // 读回的临时内存
+
+    template<typename T>
+    T get() {
+        uint64_t size = std::is_pointer_v<T> ? sizeof(uint64_t) : sizeof(T);
+        if (cursor + size > data.size()) {
+            if (!failed) std::cout << "ERROR::REPLAY:: Truncated capture" << std::endl;
+            failed = true;
+            return T();
+        }
+        T value;
+        if constexpr (std::is_pointer_v<T>) {
+            uint64_t offset;
+            memcpy(&offset, data.data() + cursor, sizeof(offset));
+            value = reinterpret_cast<T>(static_cast<uintptr_t>(offset));
+        } else {
+            memcpy(&value, data.data() + cursor, sizeof(T));
+        }
+        cursor += size;
+        return value;
+    }
+
+    // 数据直接指向读进来的文件，不拷贝
+    const char* blob(size_t* size = nullptr) {
+        if (!get<uint8_t>()) return nullptr;
+        uint64_t length = get<uint64_t>();
+        if (failed || cursor + length > data.size()) {
+            if (!failed) std::cout << "ERROR::REPLAY:: Truncated capture" << std::endl;
+            failed = true;
+            return nullptr;
+        }
+        const char* pointer = data.data() + cursor;
+        cursor += length;
+        if (size) *size = length;
+        return pointer;
+    }
+
+    std::vector<GLuint> ids() {
+        GLsizei n = get<GLsizei>();
+        std::vector<GLuint> result;
+        for (GLsizei i = 0; i < n && !failed; i++) result.push_back(get<GLuint>());
+        return result;
+    }
+
+    // 没建过映射的名字 (0、录制开始前就有的对象) 原样用
+    std::unordered_map<uint32_t, uint32_t>& objects(char kind) {
+        return names[static_cast<unsigned char>(kind)];
+    }
+
+    GLuint name(char kind, GLuint captured) {
+        auto& map = objects(kind);
+        auto found = map.find(captured);
+        return found != map.end() ? found->second : captured;
+    }
+
+    static uint64_t locationKey(GLuint program, GLint location) {
+        return (static_cast<uint64_t>(program) << 32) | static_cast<uint32_t>(location);
+    }
+
+    template<typename T>
+    void remap(char kind, T& value) {
+        if constexpr (std::is_integral_v<T>) {
+            if (kind == 'e' || kind == 'O') return;
+            if (kind == 'U') {
+                currentProgram = static_cast<GLuint>(value);
+                kind = 'P';
+            }
+            if (kind == 'L') {
+                auto found = locations.find(locationKey(currentProgram, static_cast<GLint>(value)));
+                if (found != locations.end()) value = static_cast<T>(found->second);
+                return;
+            }
+            value = static_cast<T>(name(kind, static_cast<GLuint>(value)));
+        }
+    }
+
+    template<typename Tuple, size_t... I>
+    void remapAll(Tuple& args, const char* spec, std::index_sequence<I...>) {
+        (remap(spec[I], std::get<I>(args)), ...);
+    }
+
+    void timed(uint16_t call, Clock::time_point start) {
+        if (!samples) return;
+        GlReplaySample sample;
+        sample.frame = frame;
+        sample.index = index;
+        sample.call = call;
+        sample.us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        samples->push_back(sample);
+    }
+
+    // 标量参数的入口：按函数指针的参数类型读出实参，映射名字后调用
+    template<typename... A>
+    void replay(uint16_t call, void (APIENTRYP function)(A...), const char* spec) {
+        std::tuple<A...> args{ get<A>()... };
+        if (failed) return;
+        remapAll(args, spec, std::index_sequence_for<A...>{});
+        Clock::time_point start = Clock::now();
+        std::apply(function, args);
+        timed(call, start);
+    }
+
+    void execute(uint16_t call) {
+        switch (call) {
+#define ENTRO_GL_REPLAY_CALL(name, spec, params, args) \
+            case CAPTURE_##name: replay(call, glad_gl##name, spec); return;
+            ENTRO_GL_CAPTURE_CALLS(ENTRO_GL_REPLAY_CALL)
+            ENTRO_GL_CAPTURE_TRACKED_CALLS(ENTRO_GL_REPLAY_CALL)
+#undef ENTRO_GL_REPLAY_CALL
+
+            // 循环回放时同一个 glGen 会执行多次，名字已经有映射的不再新建
+#define ENTRO_GL_REPLAY_OBJECT(suffix, kind) \
+            case CAPTURE_Gen##suffix: { \
+                std::vector<GLuint> captured = ids(); \
+                Clock::time_point start = Clock::now(); \
+                for (GLuint id : captured) { \
+                    if (objects(kind).count(id)) continue; \
+                    GLuint fresh = 0; \
+                    glad_glGen##suffix(1, &fresh); \
+                    objects(kind)[id] = fresh; \
+                } \
+                timed(call, start); \
+                return; \
+            } \
+            case CAPTURE_Delete##suffix: { \
+                std::vector<GLuint> deleted; \
+                for (GLuint id : ids()) { \
+                    auto found = objects(kind).find(id); \
+                    if (found == objects(kind).end()) continue; \
+                    if (kind != 'F' || found->second != output) deleted.push_back(found->second); \
+                    objects(kind).erase(found); \
+                } \
+                Clock::time_point start = Clock::now(); \
+                glad_glDelete##suffix(static_cast<GLsizei>(deleted.size()), deleted.data()); \
+                timed(call, start); \
+                return; \
+            }
+            ENTRO_GL_CAPTURE_OBJECTS(ENTRO_GL_REPLAY_OBJECT)
+#undef ENTRO_GL_REPLAY_OBJECT
+
+#define ENTRO_GL_REPLAY_UNIFORM(name, components) \
+            case CAPTURE_##name: { \
+                GLint location = get<GLint>(); \
+                GLsizei count = get<GLsizei>(); \
+                const char* value = blob(); \
+                remap('L', location); \
+                Clock::time_point start = Clock::now(); \
+                glad_gl##name(location, count, reinterpret_cast<const GLfloat*>(value)); \
+                timed(call, start); \
+                return; \
+            }
+            ENTRO_GL_CAPTURE_UNIFORM_VECTORS(ENTRO_GL_REPLAY_UNIFORM)
+#undef ENTRO_GL_REPLAY_UNIFORM
+
+#define ENTRO_GL_REPLAY_UNIFORM(name, components) \
+            case CAPTURE_##name: { \
+                GLint location = get<GLint>(); \
+                GLsizei count = get<GLsizei>(); \
+                GLboolean transpose = get<GLboolean>(); \
+                const char* value = blob(); \
+                remap('L', location); \
+                Clock::time_point start = Clock::now(); \
+                glad_gl##name(location, count, transpose, reinterpret_cast<const GLfloat*>(value)); \
+                timed(call, start); \
+                return; \
+            }
+            ENTRO_GL_CAPTURE_UNIFORM_MATRICES(ENTRO_GL_REPLAY_UNIFORM)
+#undef ENTRO_GL_REPLAY_UNIFORM
+
+            case CAPTURE_CreateShader: {
+                GLenum type = get<GLenum>();
+                GLuint captured = get<GLuint>();
+                Clock::time_point start = Clock::now();
+                objects('P')[captured] = glad_glCreateShader(type);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_CreateProgram: {
+                GLuint captured = get<GLuint>();
+                Clock::time_point start = Clock::now();
+                objects('P')[captured] = glad_glCreateProgram();
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ShaderSource: {
+                GLuint shader = name('P', get<GLuint>());
+                GLsizei count = get<GLsizei>();
+                std::vector<const GLchar*> strings;
+                std::vector<GLint> lengths;
+                for (GLsizei i = 0; i < count && !failed; i++) {
+                    size_t length = 0;
+                    const char* text = blob(&length);
+                    strings.push_back(text ? text : "");
+                    lengths.push_back(static_cast<GLint>(length));
+                }
+                Clock::time_point start = Clock::now();
+                glad_glShaderSource(shader, count, strings.data(), lengths.data());
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_GetUniformLocation: {
+                GLuint program = get<GLuint>();
+                GLint location = get<GLint>();
+                const char* uniform = blob();
+                if (failed || !uniform) return;
+                Clock::time_point start = Clock::now();
+                GLint replayed = glad_glGetUniformLocation(name('P', program), uniform);
+                timed(call, start);
+                locations[locationKey(program, location)] = replayed;
+                return;
+            }
+            case CAPTURE_BufferData: {
+                GLenum target = get<GLenum>();
+                GLsizeiptr size = get<GLsizeiptr>();
+                GLenum usage = get<GLenum>();
+                const char* bytes = blob();
+                Clock::time_point start = Clock::now();
+                glad_glBufferData(target, size, bytes, usage);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_BufferSubData: {
+                GLenum target = get<GLenum>();
+                GLintptr offset = get<GLintptr>();
+                GLsizeiptr size = get<GLsizeiptr>();
+                const char* bytes = blob();
+                Clock::time_point start = Clock::now();
+                glad_glBufferSubData(target, offset, size, bytes);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ClearBufferData: {
+                GLenum target = get<GLenum>();
+                GLenum internalformat = get<GLenum>();
+                GLenum format = get<GLenum>();
+                GLenum type = get<GLenum>();
+                const char* bytes = blob();
+                Clock::time_point start = Clock::now();
+                glad_glClearBufferData(target, internalformat, format, type, bytes);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_TexImage2D: {
+                GLenum target = get<GLenum>();
+                GLint level = get<GLint>();
+                GLint internalformat = get<GLint>();
+                GLsizei width = get<GLsizei>();
+                GLsizei height = get<GLsizei>();
+                GLint border = get<GLint>();
+                GLenum format = get<GLenum>();
+                GLenum type = get<GLenum>();
+                const void* pixels = this->pixels();
+                Clock::time_point start = Clock::now();
+                glad_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_TexSubImage2D: {
+                GLenum target = get<GLenum>();
+                GLint level = get<GLint>();
+                GLint xoffset = get<GLint>();
+                GLint yoffset = get<GLint>();
+                GLsizei width = get<GLsizei>();
+                GLsizei height = get<GLsizei>();
+                GLenum format = get<GLenum>();
+                GLenum type = get<GLenum>();
+                const void* pixels = this->pixels();
+                Clock::time_point start = Clock::now();
+                glad_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ClearTexImage: {
+                GLuint texture = name('T', get<GLuint>());
+                GLint level = get<GLint>();
+                GLenum format = get<GLenum>();
+                GLenum type = get<GLenum>();
+                const char* bytes = blob();
+                Clock::time_point start = Clock::now();
+                glad_glClearTexImage(texture, level, format, type, bytes);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_TexParameterfv: {
+                GLenum target = get<GLenum>();
+                GLenum pname = get<GLenum>();
+                const char* params = blob();
+                if (failed || !params) return;
+                Clock::time_point start = Clock::now();
+                glad_glTexParameterfv(target, pname, reinterpret_cast<const GLfloat*>(params));
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ClearBufferfv: {
+                GLenum buffer = get<GLenum>();
+                GLint drawbuffer = get<GLint>();
+                const char* value = blob();
+                if (failed || !value) return;
+                Clock::time_point start = Clock::now();
+                glad_glClearBufferfv(buffer, drawbuffer, reinterpret_cast<const GLfloat*>(value));
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_DrawBuffers: {
+                GLsizei n = get<GLsizei>();
+                const char* bufs = blob();
+                if (failed) return;
+                Clock::time_point start = Clock::now();
+                glad_glDrawBuffers(n, reinterpret_cast<const GLenum*>(bufs));
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ReadPixels: {
+                GLint x = get<GLint>();
+                GLint y = get<GLint>();
+                GLsizei width = get<GLsizei>();
+                GLsizei height = get<GLsizei>();
+                GLenum format = get<GLenum>();
+                GLenum type = get<GLenum>();
+                bool toBuffer = get<uint8_t>() != 0;
+                GLint alignment = get<GLint>();
+                void* offset = get<void*>();
+                if (failed) return;
+                void* target = offset;
+                if (!toBuffer) {
+                    scratch.resize(GlAlignedPixelBytes(width, height, format, type, alignment));
+                    target = scratch.data();
+                }
+                Clock::time_point start = Clock::now();
+                glad_glReadPixels(x, y, width, height, format, type, target);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_GetBufferSubData: {
+                GLenum target = get<GLenum>();
+                GLintptr offset = get<GLintptr>();
+                GLsizeiptr size = get<GLsizeiptr>();
+                if (failed) return;
+                scratch.resize(static_cast<size_t>(size));
+                Clock::time_point start = Clock::now();
+                glad_glGetBufferSubData(target, offset, size, scratch.data());
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_GetQueryObjectui64v: {
+                GLuint id = name('Q', get<GLuint>());
+                GLenum pname = get<GLenum>();
+                GLuint64 result = 0;
+                Clock::time_point start = Clock::now();
+                glad_glGetQueryObjectui64v(id, pname, &result);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_GetQueryObjectiv: {
+                GLuint id = name('Q', get<GLuint>());
+                GLenum pname = get<GLenum>();
+                GLint result = 0;
+                Clock::time_point start = Clock::now();
+                glad_glGetQueryObjectiv(id, pname, &result);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_FenceSync: {
+                GLenum condition = get<GLenum>();
+                GLbitfield flags = get<GLbitfield>();
+                uint32_t id = get<uint32_t>();
+                Clock::time_point start = Clock::now();
+                syncs[id] = glad_glFenceSync(condition, flags);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_ClientWaitSync: {
+                uint32_t id = get<uint32_t>();
+                GLbitfield flags = get<GLbitfield>();
+                GLuint64 timeout = get<GLuint64>();
+                auto found = syncs.find(id);
+                if (failed || found == syncs.end()) return;
+                Clock::time_point start = Clock::now();
+                glad_glClientWaitSync(found->second, flags, timeout);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_DeleteSync: {
+                uint32_t id = get<uint32_t>();
+                auto found = syncs.find(id);
+                if (failed || found == syncs.end()) return;
+                Clock::time_point start = Clock::now();
+                glad_glDeleteSync(found->second);
+                timed(call, start);
+                syncs.erase(found);
+                return;
+            }
+            case CAPTURE_MapBufferRange: {
+                GLenum target = get<GLenum>();
+                GLintptr offset = get<GLintptr>();
+                GLsizeiptr length = get<GLsizeiptr>();
+                GLbitfield access = get<GLbitfield>();
+                if (failed) return;
+                Clock::time_point start = Clock::now();
+                mappings[target] = glad_glMapBufferRange(target, offset, length, access);
+                timed(call, start);
+                return;
+            }
+            case CAPTURE_UnmapBuffer: {
+                GLenum target = get<GLenum>();
+                size_t size = 0;
+                const char* written = blob(&size);
+                if (failed) return;
+                Clock::time_point start = Clock::now();
+                void* pointer = mappings[target];
+                if (written && pointer) memcpy(pointer, written, size);
+                glad_glUnmapBuffer(target);
+                timed(call, start);
+                mappings.erase(target);
+                return;
+            }
+            default:
+                std::cout << "ERROR::REPLAY:: Unknown call " << call << " at offset " << cursor << std::endl;
+                failed = true;
+                return;
+        }
+    }
+
+    // 上传的像素：文件里的数据，或者 PIXEL_UNPACK_BUFFER 里的偏移
+    const void* pixels() {
+        if (get<uint8_t>()) return get<const void*>();
+        return blob();
+    }
+};
+
+#endif
\ No newline at end of file
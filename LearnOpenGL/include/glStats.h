@@ -0,0 +1,282 @@
+#ifndef GLSTATS_H
+#define GLSTATS_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstring>
+
+// ==========================================================
+// 每帧的 GL 调用统计：绘制、状态切换、uniform、上传的字节数，按入口和按 render pass 分开计。
+// 做法是把 glad 的函数指针 (glad_glDrawElements 等) 换成包一层计数的版本，
+// Mesh::Draw / Shader::set* / UBO::SetData 这些调用方一行都不用改。
+// 只有 CMake 打开 ENTRO_GL_STATS 时才编译进来；关掉时 GlStats 的方法都是空的内联函数，
+// 函数指针也不换，没有任何开销。
+// 计数不加锁，只在 GL 上下文所在的线程调用；别的上下文的线程 (后台上传) 先 IgnoreCurrentThread，它的调用不计
+// ==========================================================
+
+enum GlStatCategory {
+    GLSTAT_CATEGORY_DRAW,     // 绘制 / dispatch / 清屏 / blit
+    GLSTAT_CATEGORY_STATE,    // 绑定、开关、视口等状态切换
+    GLSTAT_CATEGORY_UNIFORM,  // glUniform* 和 glGetUniformLocation
+    GLSTAT_CATEGORY_UPLOAD,   // 缓冲 / 纹理数据上传
+    GLSTAT_CATEGORY_COUNT
+};
+
+// 统计的入口：X(名字, 分类, 返回值, 参数表, 实参)
+// 上传类的 4 个入口除了计数还要算字节数，单独写
+#define ENTRO_GL_STAT_CALLS(X) \
+    X(DrawElements, DRAW, void, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+    X(DrawArrays, DRAW, void, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+    X(DrawElementsInstanced, DRAW, void, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances), (mode, count, type, indices, instances)) \
+    X(DrawArraysInstanced, DRAW, void, (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances)) \
+    X(DispatchCompute, DRAW, void, (GLuint x, GLuint y, GLuint z), (x, y, z)) \
+    X(Clear, DRAW, void, (GLbitfield mask), (mask)) \
+    X(ClearBufferfv, DRAW, void, (GLenum buffer, GLint drawbuffer, const GLfloat* value), (buffer, drawbuffer, value)) \
+    X(BlitFramebuffer, DRAW, void, (GLint sx0, GLint sy0, GLint sx1, GLint sy1, GLint dx0, GLint dy0, GLint dx1, GLint dy1, GLbitfield mask, GLenum filter), (sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter)) \
+    X(UseProgram, STATE, void, (GLuint program), (program)) \
+    X(BindVertexArray, STATE, void, (GLuint array), (array)) \
+    X(BindBuffer, STATE, void, (GLenum target, GLuint buffer), (target, buffer)) \
+    X(BindBufferBase, STATE, void, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+    X(BindTexture, STATE, void, (GLenum target, GLuint texture), (target, texture)) \
+    X(BindImageTexture, STATE, void, (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format), (unit, texture, level, layered, layer, access, format)) \
+    X(ActiveTexture, STATE, void, (GLenum texture), (texture)) \
+    X(BindFramebuffer, STATE, void, (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+    X(DrawBuffers, STATE, void, (GLsizei n, const GLenum* bufs), (n, bufs)) \
+    X(Enable, STATE, void, (GLenum cap), (cap)) \
+    X(Disable, STATE, void, (GLenum cap), (cap)) \
+    X(DepthFunc, STATE, void, (GLenum func), (func)) \
+    X(CullFace, STATE, void, (GLenum mode), (mode)) \
+    X(BlendFunc, STATE, void, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+    X(Viewport, STATE, void, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+    X(MemoryBarrier, STATE, void, (GLbitfield barriers), (barriers)) \
+    X(GetUniformLocation, UNIFORM, GLint, (GLuint program, const GLchar* name), (program, name)) \
+    X(Uniform1i, UNIFORM, void, (GLint location, GLint v0), (location, v0)) \
+    X(Uniform1f, UNIFORM, void, (GLint location, GLfloat v0), (location, v0)) \
+    X(Uniform1fv, UNIFORM, void, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(Uniform2f, UNIFORM, void, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1)) \
+    X(Uniform2fv, UNIFORM, void, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(Uniform2i, UNIFORM, void, (GLint location, GLint v0, GLint v1), (location, v0, v1)) \
+    X(Uniform3f, UNIFORM, void, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2)) \
+    X(Uniform3fv, UNIFORM, void, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(Uniform4f, UNIFORM, void, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3)) \
+    X(Uniform4fv, UNIFORM, void, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(UniformMatrix2fv, UNIFORM, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(UniformMatrix3fv, UNIFORM, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(UniformMatrix4fv, UNIFORM, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+
+enum GlStatCall {
+#define ENTRO_GL_STAT_ENUM(name, category, ret, params, args) GLSTAT_##name,
+    ENTRO_GL_STAT_CALLS(ENTRO_GL_STAT_ENUM)
+#undef ENTRO_GL_STAT_ENUM
+    GLSTAT_BufferData,
+    GLSTAT_BufferSubData,
+    GLSTAT_TexImage2D,
+    GLSTAT_TexSubImage2D,
+    GLSTAT_COUNT
+};
+
+inline const char* GlStatCallName(int call) {
+    static const char* names[GLSTAT_COUNT] = {
+#define ENTRO_GL_STAT_NAME(name, category, ret, params, args) "gl" #name,
+        ENTRO_GL_STAT_CALLS(ENTRO_GL_STAT_NAME)
+#undef ENTRO_GL_STAT_NAME
+        "glBufferData", "glBufferSubData", "glTexImage2D", "glTexSubImage2D"
+    };
+    return call >= 0 && call < GLSTAT_COUNT ? names[call] : "?";
+}
+
+inline GlStatCategory GlStatCallCategory(int call) {
+    static const GlStatCategory categories[GLSTAT_COUNT] = {
+#define ENTRO_GL_STAT_CATEGORY(name, category, ret, params, args) GLSTAT_CATEGORY_##category,
+        ENTRO_GL_STAT_CALLS(ENTRO_GL_STAT_CATEGORY)
+#undef ENTRO_GL_STAT_CATEGORY
+        GLSTAT_CATEGORY_UPLOAD, GLSTAT_CATEGORY_UPLOAD, GLSTAT_CATEGORY_UPLOAD, GLSTAT_CATEGORY_UPLOAD
+    };
+    return categories[call];
+}
+
+inline const char* GlStatCategoryName(int category) {
+    static const char* names[GLSTAT_CATEGORY_COUNT] = { "draw", "state", "uniform", "upload" };
+    return category >= 0 && category < GLSTAT_CATEGORY_COUNT ? names[category] : "?";
+}
+
+// 像素数据的字节数：宽 x 高 x 每像素字节 (按 format / type 估计，不算行对齐，压缩格式不在这里)
+inline size_t GlPixelDataBytes(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+    size_t components = 4;
+    switch (format) {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+        case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL: components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+        default: break;
+    }
+    size_t componentBytes = 1;
+    switch (type) {
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: componentBytes = 2; break;
+        case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: componentBytes = 4; break;
+        case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_2_10_10_10_REV:
+            components = 1; componentBytes = 4; break;
+        default: break;
+    }
+    return static_cast<size_t>(width) * height * components * componentBytes;
+}
+
+// 一帧的统计。pass 的最后一格 (MAX_PASSES) 是不在任何 pass 里的调用
+struct GlFrameStats {
+    static const int MAX_PASSES = 16;
+
+    unsigned int calls[GLSTAT_COUNT] = {};
+    unsigned int passCalls[MAX_PASSES + 1][GLSTAT_CATEGORY_COUNT] = {};
+    size_t passUploadBytes[MAX_PASSES + 1] = {};
+    const char* passNames[MAX_PASSES + 1] = {};
+    size_t bufferBytes = 0;
+    size_t textureBytes = 0;
+
+    unsigned int CategoryTotal(int category) const {
+        unsigned int total = 0;
+        for (int pass = 0; pass <= MAX_PASSES; pass++) total += passCalls[pass][category];
+        return total;
+    }
+};
+
+#ifdef ENTRO_GL_STATS
+
+class GlStats {
+public:
+    static constexpr bool Compiled = true;
+    bool enabled = true;
+
+    static GlStats& Get() {
+        static GlStats instance;
+        return instance;
+    }
+
+    // gladLoadGL 之后调用，重复调用没关系
+    void Install() {
+        if (installed) return;
+        installed = true;
+#define ENTRO_GL_STAT_INSTALL(name, category, ret, params, args) \
+        original##name = glad_gl##name; \
+        if (glad_gl##name) glad_gl##name = wrap##name;
+        ENTRO_GL_STAT_CALLS(ENTRO_GL_STAT_INSTALL)
+#undef ENTRO_GL_STAT_INSTALL
+        originalBufferData = glad_glBufferData;
+        originalBufferSubData = glad_glBufferSubData;
+        originalTexImage2D = glad_glTexImage2D;
+        originalTexSubImage2D = glad_glTexSubImage2D;
+        glad_glBufferData = wrapBufferData;
+        glad_glBufferSubData = wrapBufferSubData;
+        glad_glTexImage2D = wrapTexImage2D;
+        glad_glTexSubImage2D = wrapTexSubImage2D;
+    }
+
+    void BeginFrame() {
+        current = GlFrameStats();
+        pass = GlFrameStats::MAX_PASSES;
+        current.passNames[pass] = "other";
+    }
+
+    void EndFrame() { last = current; }
+
+    // 之后的调用记到 index 这个 pass，index < 0 表示回到 "other"
+    void SetPass(int index, const char* name) {
+        if (index < 0 || index >= GlFrameStats::MAX_PASSES) {
+            pass = GlFrameStats::MAX_PASSES;
+            return;
+        }
+        pass = index;
+        current.passNames[index] = name;
+    }
+
+    const GlFrameStats& LastFrame() const { return last; }
+
+    // 调用它的线程上的 GL 调用以后都不计 (函数指针是全局的，别的线程也会走到包装里)
+    static void IgnoreCurrentThread() { ignoredThread() = true; }
+
+private:
+    bool installed = false;
+    int pass = GlFrameStats::MAX_PASSES;
+    GlFrameStats current;
+    GlFrameStats last;
+
+    static bool& ignoredThread() {
+        thread_local bool ignored = false;
+        return ignored;
+    }
+
+    void count(GlStatCall call) {
+        if (ignoredThread() || !enabled) return;
+        current.calls[call]++;
+        current.passCalls[pass][GlStatCallCategory(call)]++;
+    }
+
+    void upload(GlStatCall call, size_t bytes, bool texture) {
+        count(call);
+        if (ignoredThread() || !enabled) return;
+        (texture ? current.textureBytes : current.bufferBytes) += bytes;
+        current.passUploadBytes[pass] += bytes;
+    }
+
+#define ENTRO_GL_STAT_WRAP(name, category, ret, params, args) \
+    static inline decltype(glad_gl##name) original##name = nullptr; \
+    static ret APIENTRY wrap##name params { \
+        Get().count(GLSTAT_##name); \
+        return original##name args; \
+    }
+    ENTRO_GL_STAT_CALLS(ENTRO_GL_STAT_WRAP)
+#undef ENTRO_GL_STAT_WRAP
+
+    // 数据指针为空只是分配，不算上传
+    static inline PFNGLBUFFERDATAPROC originalBufferData = nullptr;
+    static void APIENTRY wrapBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        Get().upload(GLSTAT_BufferData, data ? static_cast<size_t>(size) : 0, false);
+        originalBufferData(target, size, data, usage);
+    }
+
+    static inline PFNGLBUFFERSUBDATAPROC originalBufferSubData = nullptr;
+    static void APIENTRY wrapBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        Get().upload(GLSTAT_BufferSubData, static_cast<size_t>(size), false);
+        originalBufferSubData(target, offset, size, data);
+    }
+
+    static inline PFNGLTEXIMAGE2DPROC originalTexImage2D = nullptr;
+    static void APIENTRY wrapTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                        GLint border, GLenum format, GLenum type, const void* pixels) {
+        Get().upload(GLSTAT_TexImage2D, pixels ? GlPixelDataBytes(width, height, format, type) : 0, true);
+        originalTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+    }
+
+    static inline PFNGLTEXSUBIMAGE2DPROC originalTexSubImage2D = nullptr;
+    static void APIENTRY wrapTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+                                           GLenum format, GLenum type, const void* pixels) {
+        Get().upload(GLSTAT_TexSubImage2D, GlPixelDataBytes(width, height, format, type), true);
+        originalTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+    }
+};
+
+#else
+
+// 编译时关掉：全是空函数
+class GlStats {
+public:
+    static constexpr bool Compiled = false;
+    bool enabled = false;
+
+    static GlStats& Get() {
+        static GlStats instance;
+        return instance;
+    }
+
+    void Install() {}
+    void BeginFrame() {}
+    void EndFrame() {}
+    void SetPass(int, const char*) {}
+    const GlFrameStats& LastFrame() const { return last; }
+    static void IgnoreCurrentThread() {}
+
+private:
+    GlFrameStats last;
+};
+
+#endif
+
+#endif
\ No newline at end of file
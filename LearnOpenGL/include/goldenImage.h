@@ -0,0 +1,163 @@
+#ifndef GOLDENIMAGE_H
+#define GOLDENIMAGE_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 8 位 RGB 图像，第一行是画面最上面一行 (和 PPM 一致)
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> rgb;
+
+    bool Empty() const { return width <= 0 || height <= 0; }
+
+    // glReadPixels 出来的 RGBA (第一行在最下面) 转过来
+    static Image FromGL(const std::vector<unsigned char>& rgba, int width, int height) {
+        Image image;
+        image.width = width;
+        image.height = height;
+        image.rgb.resize(static_cast<size_t>(width) * height * 3);
+        for (int y = 0; y < height; y++) {
+            const unsigned char* src = &rgba[static_cast<size_t>(height - 1 - y) * width * 4];
+            unsigned char* dst = &image.rgb[static_cast<size_t>(y) * width * 3];
+            for (int x = 0; x < width; x++) {
+                dst[x * 3 + 0] = src[x * 4 + 0];
+                dst[x * 3 + 1] = src[x * 4 + 1];
+                dst[x * 3 + 2] = src[x * 4 + 2];
+            }
+        }
+        return image;
+    }
+};
+
+// 二进制 PPM (P6)，不依赖任何图片库，任何看图软件都能打开
+inline bool WritePPM(const std::string& path, const Image& image) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "ERROR::IMAGE:: Failed to open " << path << std::endl;
+        return false;
+    }
+    file << "P6\n" << image.width << " " << image.height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(image.rgb.data()), image.rgb.size());
+    return static_cast<bool>(file);
+}
+
+inline bool ReadPPM(const std::string& path, Image& image) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::string magic;
+    int maxValue = 0;
+    file >> magic >> image.width >> image.height >> maxValue;
+    if (magic != "P6" || maxValue != 255 || image.width <= 0 || image.height <= 0) {
+        std::cout << "ERROR::IMAGE:: Unsupported PPM " << path << std::endl;
+        return false;
+    }
+    file.get(); // 头后面的一个空白
+    image.rgb.resize(static_cast<size_t>(image.width) * image.height * 3);
+    file.read(reinterpret_cast<char*>(image.rgb.data()), image.rgb.size());
+    return static_cast<bool>(file);
+}
+
+// 比较的容差：逐像素 + 结构相似度 (SSIM)
+// 不同驱动 / 浮点顺序带来的零星小误差由逐像素阈值吸收，
+// 整体偏色、模糊、错位这类"看得出来"的变化由 SSIM 抓
+struct ImageTolerance {
+    int pixelThreshold = 8;           // 任一通道差超过它算坏像素 (0~255)
+    double maxBadPixelFraction = 0.001;
+    double minSSIM = 0.98;
+};
+
+struct ImageCompareResult {
+    bool sizeMismatch = false;
+    int maxDiff = 0;
+    size_t badPixels = 0;
+    double badFraction = 0.0;
+    double ssim = 1.0;
+    bool passed = false;
+};
+
+inline double Luminance(const unsigned char* p) {
+    return 0.2126 * p[0] + 0.7152 * p[1] + 0.0722 * p[2];
+}
+
+// 亮度上的 SSIM，8x8 窗口，步长 4，取所有窗口的平均
+inline double ComputeSSIM(const Image& a, const Image& b) {
+    const int window = 8, stride = 4;
+    const double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+    const double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+    double total = 0.0;
+    int windows = 0;
+    for (int y0 = 0; y0 + window <= a.height; y0 += stride) {
+        for (int x0 = 0; x0 + window <= a.width; x0 += stride) {
+            double sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+            for (int y = y0; y < y0 + window; y++) {
+                for (int x = x0; x < x0 + window; x++) {
+                    size_t i = (static_cast<size_t>(y) * a.width + x) * 3;
+                    double la = Luminance(&a.rgb[i]);
+                    double lb = Luminance(&b.rgb[i]);
+                    sumA += la; sumB += lb;
+                    sumAA += la * la; sumBB += lb * lb; sumAB += la * lb;
+                }
+            }
+            const double n = window * window;
+            double meanA = sumA / n, meanB = sumB / n;
+            double varA = sumAA / n - meanA * meanA;
+            double varB = sumBB / n - meanB * meanB;
+            double covariance = sumAB / n - meanA * meanB;
+            total += ((2.0 * meanA * meanB + c1) * (2.0 * covariance + c2))
+                     / ((meanA * meanA + meanB * meanB + c1) * (varA + varB + c2));
+            windows++;
+        }
+    }
+    return windows ? total / windows : 1.0;
+}
+
+inline ImageCompareResult CompareImages(const Image& actual, const Image& reference, const ImageTolerance& tolerance) {
+    ImageCompareResult result;
+    if (actual.width != reference.width || actual.height != reference.height) {
+        result.sizeMismatch = true;
+        return result;
+    }
+    size_t pixels = static_cast<size_t>(actual.width) * actual.height;
+    for (size_t i = 0; i < pixels; i++) {
+        int diff = 0;
+        for (int c = 0; c < 3; c++)
+            diff = std::max(diff, std::abs(actual.rgb[i * 3 + c] - reference.rgb[i * 3 + c]));
+        result.maxDiff = std::max(result.maxDiff, diff);
+        if (diff > tolerance.pixelThreshold) result.badPixels++;
+    }
+    result.badFraction = pixels ? static_cast<double>(result.badPixels) / pixels : 0.0;
+    result.ssim = ComputeSSIM(actual, reference);
+    result.passed = result.badFraction <= tolerance.maxBadPixelFraction && result.ssim >= tolerance.minSSIM;
+    return result;
+}
+
+// 差异图：参考图变暗的灰度做底，超过阈值的像素标红，差得越多越亮
+inline Image MakeDiffImage(const Image& actual, const Image& reference, int pixelThreshold) {
+    Image diff;
+    diff.width = reference.width;
+    diff.height = reference.height;
+    diff.rgb.resize(reference.rgb.size());
+    size_t pixels = static_cast<size_t>(diff.width) * diff.height;
+    for (size_t i = 0; i < pixels; i++) {
+        int d = 0;
+        for (int c = 0; c < 3; c++)
+            d = std::max(d, std::abs(actual.rgb[i * 3 + c] - reference.rgb[i * 3 + c]));
+        unsigned char gray = static_cast<unsigned char>(Luminance(&reference.rgb[i * 3]) * 0.3);
+        if (d > pixelThreshold) {
+            diff.rgb[i * 3 + 0] = static_cast<unsigned char>(std::min(255, 128 + d * 4));
+            diff.rgb[i * 3 + 1] = 0;
+            diff.rgb[i * 3 + 2] = 0;
+        } else {
+            diff.rgb[i * 3 + 0] = diff.rgb[i * 3 + 1] = diff.rgb[i * 3 + 2] = gray;
+        }
+    }
+    return diff;
+}
+
+#endif
\ No newline at end of file
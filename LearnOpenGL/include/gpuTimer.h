@@ -0,0 +1,151 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include <glad/glad.h>
+
+// ==========================================================
+// 不阻塞的 GPU 查询 (GL_TIME_ELAPSED / GL_SAMPLES_PASSED ...)
+// 两个 query 轮流用：这一帧写一个，读上一帧的另一个，
+// 结果没准备好就下次再读，不会让 CPU 等 GPU
+// 注意：同一种查询同一时间只能有一个在进行，不能嵌套 (不同种类可以同时进行)
+// ==========================================================
+class GpuQuery {
+public:
+    explicit GpuQuery(GLenum target) : target(target) {
+        glGenQueries(2, queries);
+    }
+
+    ~GpuQuery() {
+        glDeleteQueries(2, queries);
+    }
+
+    void Begin() {
+        glBeginQuery(target, queries[current]);
+    }
+
+    void End() {
+        glEndQuery(target);
+        issued[current] = true;
+        current = 1 - current;
+        collect(current); // 翻转后 current 指向上一次的 query
+    }
+
+    // 最近一次拿到的结果 (查询本身的单位：纳秒 / 片元数 ...)
+    GLuint64 Last() const { return last; }
+
+    // 从上次 ResetAverage 到现在的平均值
+    double Average() const { return samples ? total / samples : 0.0; }
+    unsigned int Samples() const { return samples; }
+
+    void ResetAverage() {
+        total = 0.0;
+        samples = 0;
+    }
+
+private:
+    GLenum target;
+    unsigned int queries[2];
+    bool issued[2] = { false, false };
+    int current = 0;
+    GLuint64 last = 0;
+    double total = 0.0;
+    unsigned int samples = 0;
+
+    void collect(int index) {
+        if (!issued[index]) return;
+        GLint available = 0;
+        glGetQueryObjectiv(queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return; // 还没好，下次 Begin 会复用它，这个结果就丢掉
+        GLuint64 result = 0;
+        glGetQueryObjectui64v(queries[index], GL_QUERY_RESULT, &result);
+        issued[index] = false;
+        last = result;
+        total += static_cast<double>(result);
+        samples++;
+    }
+};
+
+// GPU 计时器 (GL_TIME_ELAPSED)，结果换算成毫秒
+class GpuTimer {
+public:
+    GpuTimer() : query(GL_TIME_ELAPSED) {}
+
+    void Begin() { query.Begin(); }
+    void End() { query.End(); }
+
+    // 最近一次拿到的结果 (毫秒)
+    float Milliseconds() const { return static_cast<float>(query.Last() / 1000000.0); }
+
+    // 从上次 ResetAverage 到现在的平均值 (毫秒)
+    float Average() const { return static_cast<float>(query.Average() / 1000000.0); }
+    unsigned int Samples() const { return query.Samples(); }
+
+    void ResetAverage() { query.ResetAverage(); }
+
+private:
+    GpuQuery query;
+};
+
+// ==========================================================
+// 整帧 GPU 时间：用时间戳 (glQueryCounter) 而不是 GL_TIME_ELAPSED，
+// 这样帧里面其它 GpuTimer 照常工作，不会和它嵌套冲突。
+// 几帧的查询排成一个环，读最老的那一帧，结果通常晚 2~3 帧到
+// ==========================================================
+class GpuFrameTimer {
+public:
+    GpuFrameTimer() {
+        glGenQueries(2 * RING_SIZE, queries);
+    }
+
+    ~GpuFrameTimer() {
+        glDeleteQueries(2 * RING_SIZE, queries);
+    }
+
+    void Begin() {
+        glQueryCounter(queries[2 * current], GL_TIMESTAMP);
+    }
+
+    void End() {
+        glQueryCounter(queries[2 * current + 1], GL_TIMESTAMP);
+        issued[current] = true;
+        current = (current + 1) % RING_SIZE;
+        Collect();
+    }
+
+    // 从最老的开始读，读到还没准备好的就停。
+    // End 里会自动调用；glFinish 之后再调一次就能拿到刚结束这一帧的结果 (基准测试用)
+    void Collect() {
+        for (int i = 0; i < RING_SIZE; i++) {
+            int index = (current + i) % RING_SIZE;
+            if (!issued[index]) continue;
+            GLint available = 0;
+            glGetQueryObjectiv(queries[2 * index + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(queries[2 * index], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(queries[2 * index + 1], GL_QUERY_RESULT, &end);
+            issued[index] = false;
+            lastMs = static_cast<float>((end - start) / 1000000.0);
+            fresh = true;
+        }
+    }
+
+    float Milliseconds() const { return lastMs; }
+
+    // 上次调用之后有没有拿到新结果 (控制器只在有新数据时才调整)
+    bool ConsumeFresh() {
+        bool result = fresh;
+        fresh = false;
+        return result;
+    }
+
+private:
+    static const int RING_SIZE = 4;
+    unsigned int queries[2 * RING_SIZE];
+    bool issued[RING_SIZE] = {};
+    int current = 0;
+    float lastMs = 0.0f;
+    bool fresh = false;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef HEADLESSCONTEXT_H
+#define HEADLESSCONTEXT_H
+
+// ==========================================================
+// 无窗口的 GL 4.5 core 上下文 (EGL)，给没有显卡 / 没有显示器的构建机用
+// 1. 优先用 Mesa 的 surfaceless 平台 (EGL_MESA_platform_surfaceless)，完全不需要 X / Wayland；
+//    没有的话退回默认 display
+// 2. 支持 EGL_KHR_surfaceless_context 就不建任何 surface，否则建一个 1x1 的 pbuffer 凑数
+// 3. 没有默认帧缓冲，渲染结果画进自己的 FBO (RGBA8 颜色 + 深度模板)，用 ReadPixels 读回来
+// 4. CreateSharedContext 再建一个和它共享对象的上下文，给后台上传线程用 (uploadService.h)
+// Mesa 的 llvmpipe 可以直接跑：LIBGL_ALWAYS_SOFTWARE=1 或者 EGL_PLATFORM=surfaceless
+// 只有 CMake 找到 EGL 时才会定义 ENTRO_HAS_EGL
+// ==========================================================
+#ifdef ENTRO_HAS_EGL
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+class HeadlessContext {
+public:
+    HeadlessContext(int width, int height) : width(width), height(height) {
+        if (!createContext()) return;
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+            std::cout << "ERROR::HEADLESS:: Failed to initialize GLAD" << std::endl;
+            return;
+        }
+        createFramebuffer();
+        valid = true;
+        std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << " (" << glGetString(GL_RENDERER) << ")" << std::endl;
+    }
+
+    ~HeadlessContext() {
+        if (valid) {
+            glDeleteFramebuffers(1, &fbo);
+            glDeleteTextures(1, &colorTexture);
+            glDeleteRenderbuffers(1, &depthRBO);
+        }
+        if (display != EGL_NO_DISPLAY) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (sharedContext != EGL_NO_CONTEXT) eglDestroyContext(display, sharedContext);
+            if (sharedSurface != EGL_NO_SURFACE) eglDestroySurface(display, sharedSurface);
+            if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+            if (surface != EGL_NO_SURFACE) eglDestroySurface(display, surface);
+            eglTerminate(display);
+        }
+    }
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    bool Valid() const { return valid; }
+    int Width() const { return width; }
+    int Height() const { return height; }
+    // 代替默认帧缓冲，Renderer::RenderFrame 画到这里
+    unsigned int Framebuffer() const { return fbo; }
+    unsigned int ColorTexture() const { return colorTexture; }
+
+    void Resize(int newWidth, int newHeight) {
+        if (newWidth == width && newHeight == height) return;
+        width = newWidth;
+        height = newHeight;
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &colorTexture);
+        glDeleteRenderbuffers(1, &depthRBO);
+        createFramebuffer();
+    }
+
+    // 读回 RGBA8 像素 (第一行是画面最下面一行，和 glReadPixels 一致)
+    void ReadPixels(std::vector<unsigned char>& pixels) {
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    }
+
+    // 建一个和主上下文共享对象 (纹理 / 缓冲 / sync) 的上下文，在主线程上调用一次。
+    // 之后在另一个线程上 MakeSharedCurrent，退出前 ReleaseShared；上下文本身在析构时删
+    bool CreateSharedContext() {
+        if (!valid) return false;
+        if (sharedContext != EGL_NO_CONTEXT) return true;
+        sharedContext = eglCreateContext(display, config, context, CONTEXT_ATTRIBS);
+        if (sharedContext == EGL_NO_CONTEXT) {
+            std::cout << "ERROR::HEADLESS:: Failed to create a shared context" << std::endl;
+            return false;
+        }
+        if (surface != EGL_NO_SURFACE) {
+            const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            sharedSurface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        }
+        return true;
+    }
+
+    bool MakeSharedCurrent() {
+        return sharedContext != EGL_NO_CONTEXT && eglMakeCurrent(display, sharedSurface, sharedSurface, sharedContext);
+    }
+
+    void ReleaseShared() { eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT); }
+
+private:
+    static constexpr EGLint CONTEXT_ATTRIBS[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    int width, height;
+    bool valid = false;
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLConfig config = nullptr;
+    EGLContext context = EGL_NO_CONTEXT;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext sharedContext = EGL_NO_CONTEXT;
+    EGLSurface sharedSurface = EGL_NO_SURFACE;
+    unsigned int fbo = 0, colorTexture = 0, depthRBO = 0;
+
+    static bool hasExtension(const char* extensions, const char* name) {
+        if (!extensions) return false;
+        size_t length = std::strlen(name);
+        for (const char* p = std::strstr(extensions, name); p; p = std::strstr(p + length, name))
+            if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0')) return true;
+        return false;
+    }
+
+    bool createContext() {
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (getPlatformDisplay)
+                display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        }
+        if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+            std::cout << "ERROR::HEADLESS:: Failed to initialize EGL display" << std::endl;
+            display = EGL_NO_DISPLAY;
+            return false;
+        }
+
+        bool surfaceless = hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+            EGL_NONE
+        };
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            std::cout << "ERROR::HEADLESS:: No suitable EGL config" << std::endl;
+            return false;
+        }
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            std::cout << "ERROR::HEADLESS:: Desktop OpenGL is not supported by EGL" << std::endl;
+            return false;
+        }
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, CONTEXT_ATTRIBS);
+        if (context == EGL_NO_CONTEXT) {
+            std::cout << "ERROR::HEADLESS:: Failed to create a GL 4.5 core context" << std::endl;
+            return false;
+        }
+        if (!surfaceless) {
+            const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        }
+        if (!eglMakeCurrent(display, surface, surface, context)) {
+            std::cout << "ERROR::HEADLESS:: eglMakeCurrent failed" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void createFramebuffer() {
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glGenTextures(1, &colorTexture);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        glGenRenderbuffers(1, &depthRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::HEADLESS:: Framebuffer is not complete!" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+};
+
+#endif // ENTRO_HAS_EGL
+
+#endif
\ No newline at end of file
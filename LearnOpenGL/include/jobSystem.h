@@ -0,0 +1,300 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+struct Job {
+    std::function<void()> function;
+    JobCounter* counter = nullptr;   // 做完后减一
+};
+
+// ==========================================================
+// 依赖计数：提交时 +1，任务做完 -1，归零就是这一组任务全部完成。
+// 可以 JobSystem::Wait 等它，也可以用 RunAfter 让别的任务在它归零后才开始。
+// 计数器必须活到 Wait 返回 (一般放在栈上，Wait 之后再离开作用域)；只看 Done() 就销毁是不安全的
+// ==========================================================
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool Done() const { return value.load(std::memory_order_acquire) == 0; }
+    int Value() const { return value.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> value{ 0 };
+    std::mutex mutex;                // 保护 waiting，也保证减到 0 的线程放手之后等待方才返回
+    std::vector<Job> waiting;        // RunAfter 挂在这里的任务，归零时放进队列
+};
+
+struct JobSystemStats {
+    unsigned long long executed = 0;  // 执行的任务数
+    unsigned long long stolen = 0;    // 其中从别人队列偷来的
+};
+
+// ==========================================================
+// 任务系统 (work stealing)
+// 每个工作线程一个双端队列：自己从尾部取 (后进先出，缓存热)，空了就从别人队列的头部偷 (先进先出，偷到的是大块)。
+// 队列 0 给不是工作线程的线程用 (主线程、以后的加载 / 上传线程)，它们提交的任务也能被偷走。
+// Wait 的时候调用线程不闲着，一边等一边执行队列里的任务，所以任务里嵌套 ParallelFor / Wait 也不会死锁。
+// 队列用互斥锁保护 (任务粒度是几十微秒以上，锁的开销可以忽略，而且 TSAN 干净)。
+// 工作线程数默认是核数 - 1，主线程算最后一个
+// ==========================================================
+class JobSystem {
+public:
+    explicit JobSystem(int workerCount = DefaultWorkerCount()) {
+        workerCount = std::max(workerCount, 0);
+        for (int i = 0; i <= workerCount; i++) {
+            queues.push_back(std::make_unique<Queue>());
+            workerStats.push_back(std::make_unique<WorkerStats>());
+        }
+        for (int i = 1; i <= workerCount; i++) workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    // 队列里剩下的任务做完才退出
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+        // 没有工作线程时 (或者工作线程退出后又被挂上的任务) 在析构的线程上做完
+        Job job;
+        while (pop(0, job)) execute(0, job);
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 全局实例，第一次用时创建
+    static JobSystem& Get() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    static int DefaultWorkerCount() {
+        unsigned int cores = std::thread::hardware_concurrency();
+        return cores > 1 ? static_cast<int>(cores) - 1 : 0;
+    }
+
+    int WorkerCount() const { return static_cast<int>(workers.size()); }
+
+    // 提交任务；counter 不为空时先 +1，做完 -1
+    void Run(std::function<void()> function, JobCounter* counter = nullptr) {
+        if (counter) counter->value.fetch_add(1, std::memory_order_relaxed);
+        push(Job{ std::move(function), counter });
+    }
+
+    // dependency 归零之后才开始 (已经是 0 就马上提交)
+    void RunAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter = nullptr) {
+        if (counter) counter->value.fetch_add(1, std::memory_order_relaxed);
+        Job job{ std::move(function), counter };
+        {
+            std::lock_guard<std::mutex> lock(dependency.mutex);
+            if (dependency.value.load(std::memory_order_acquire) != 0) {
+                dependency.waiting.push_back(std::move(job));
+                return;
+            }
+        }
+        push(std::move(job));
+    }
+
+    // 等 counter 归零，等的同时执行队列里的任务
+    void Wait(JobCounter& counter) {
+        int index = currentIndex();
+        int idle = 0;
+        while (!counter.Done()) {
+            Job job;
+            if (pop(index, job)) {
+                execute(index, job);
+                idle = 0;
+                continue;
+            }
+            // 没有能帮的任务，剩下的正在别的线程上跑：先让出几次，再短暂睡一下
+            if (++idle < SPIN_BEFORE_SLEEP) {
+                std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait_for(lock, std::chrono::microseconds(100), [&counter]() { return counter.Done(); });
+            }
+        }
+        // 减到 0 的线程可能还拿着 counter 的锁，等它放手再返回，调用方才能销毁 counter
+        std::lock_guard<std::mutex> lock(counter.mutex);
+    }
+
+    // 并行执行 function(i)，i 属于 [begin, end)，每 grain 个一块 (grain <= 0 时按线程数自动切)，全部做完才返回。
+    // 第一块在调用线程上直接做
+    template<typename F>
+    void ParallelFor(int begin, int end, int grain, F&& function) {
+        ParallelForRange(begin, end, grain, [&function](int chunkBegin, int chunkEnd) {
+            for (int i = chunkBegin; i < chunkEnd; i++) function(i);
+        });
+    }
+
+    // 同上，按块回调 function(chunkBegin, chunkEnd)
+    template<typename F>
+    void ParallelForRange(int begin, int end, int grain, F&& function) {
+        if (end <= begin) return;
+        int count = end - begin;
+        if (grain <= 0) grain = std::max(1, count / ((WorkerCount() + 1) * CHUNKS_PER_THREAD));
+        if (grain >= count || workers.empty()) {
+            function(begin, end);
+            return;
+        }
+        JobCounter counter;
+        for (int start = begin + grain; start < end; start += grain) {
+            int stop = std::min(start + grain, end);
+            Run([&function, start, stop]() { function(start, stop); }, &counter);
+        }
+        function(begin, begin + grain);
+        Wait(counter);
+    }
+
+    JobSystemStats Stats() const {
+        JobSystemStats total;
+        for (const auto& stat : workerStats) {
+            total.executed += stat->executed.load(std::memory_order_relaxed);
+            total.stolen += stat->stolen.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // 第 index 个参与者 (0 = 非工作线程，1.. = 工作线程) 的统计
+    JobSystemStats Stats(int index) const {
+        JobSystemStats result;
+        result.executed = workerStats[index]->executed.load(std::memory_order_relaxed);
+        result.stolen = workerStats[index]->stolen.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void ResetStats() {
+        for (auto& stat : workerStats) {
+            stat->executed.store(0, std::memory_order_relaxed);
+            stat->stolen.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static const int SPIN_BEFORE_SLEEP = 64;
+    static const int CHUNKS_PER_THREAD = 4;   // 自动切块时每个线程分几块，块多一点负载更均衡
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    struct WorkerStats {
+        std::atomic<unsigned long long> executed{ 0 };
+        std::atomic<unsigned long long> stolen{ 0 };
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;   // 0 = 非工作线程共用，i = 第 i 个工作线程
+    std::vector<std::unique_ptr<WorkerStats>> workerStats;
+    std::vector<std::thread> workers;
+    std::atomic<int> pending{ 0 };                // 还在队列里没被取走的任务数
+    bool stopping = false;                        // sleepMutex 保护
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    // 当前线程在这个任务系统里的队列号 (可能同时存在多个 JobSystem，比如基准测试)
+    static JobSystem*& threadSystem() {
+        thread_local JobSystem* system = nullptr;
+        return system;
+    }
+
+    static int& threadIndex() {
+        thread_local int index = 0;
+        return index;
+    }
+
+    int currentIndex() const { return threadSystem() == this ? threadIndex() : 0; }
+
+    void push(Job job) {
+        Queue& queue = *queues[currentIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        pending.fetch_add(1, std::memory_order_release);
+        // 先碰一下锁，避免工作线程检查完条件、还没睡下时错过通知
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+
+    // 先取自己队列的尾部，再从下一个队列开始轮流偷头部
+    bool pop(int index, Job& job) {
+        if (pending.load(std::memory_order_acquire) == 0) return false;
+        {
+            Queue& own = *queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        int count = static_cast<int>(queues.size());
+        for (int offset = 1; offset < count; offset++) {
+            Queue& victim = *queues[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.jobs.empty()) continue;
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            workerStats[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void execute(int index, Job& job) {
+        job.function();
+        workerStats[index]->executed.fetch_add(1, std::memory_order_relaxed);
+        if (job.counter) finish(*job.counter);
+    }
+
+    // 计数减一；归零时把挂在上面的任务放进队列，叫醒在等的线程
+    void finish(JobCounter& counter) {
+        std::vector<Job> released;
+        {
+            std::lock_guard<std::mutex> lock(counter.mutex);
+            if (counter.value.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            released.swap(counter.waiting);
+        }
+        for (Job& job : released) push(std::move(job));
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_all();
+    }
+
+    void workerLoop(int index) {
+        threadSystem() = this;
+        threadIndex() = index;
+        while (true) {
+            Job job;
+            if (pop(index, job)) {
+                execute(index, job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]() { return stopping || pending.load(std::memory_order_acquire) > 0; });
+            if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef LOADSTATS_H
+#define LOADSTATS_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstddef>
+
+// 资源加载的各个阶段
+enum LoadStage {
+    LOAD_PARSE,     // Assimp ReadFile
+    LOAD_CONVERT,   // processNode / processMesh：aiMesh -> Vertex / index，建 VAO
+    LOAD_DECODE,    // stbi_load
+    LOAD_UPLOAD,    // glTexImage2D
+    LOAD_MIPMAP,    // glGenerateMipmap
+    LOAD_SHADER,    // Shader 构造：读文件 + 编译 + 链接
+    LOAD_STAGE_COUNT
+};
+
+inline const char* LoadStageName(int stage) {
+    static const char* names[LOAD_STAGE_COUNT] = { "parse", "convert", "decode", "upload", "mipmap", "shader" };
+    return stage >= 0 && stage < LOAD_STAGE_COUNT ? names[stage] : "unknown";
+}
+
+// 每个阶段累计的时间、次数和处理的数据量
+// bytes 的含义随阶段不同：parse = 模型文件大小，convert = 顶点 + 索引，decode = 解码后的像素，
+// upload = 第 0 层纹素，mipmap = 其余各层 (约为第 0 层的 1/3)，shader = 源码
+struct LoadStats {
+    double ms[LOAD_STAGE_COUNT] = {};
+    size_t bytes[LOAD_STAGE_COUNT] = {};
+    unsigned int count[LOAD_STAGE_COUNT] = {};
+
+    void Reset() { *this = LoadStats(); }
+};
+
+// ==========================================================
+// 加载阶段计时 (基准测试用)，默认关闭，关闭时 LoadStageTimer 什么都不做。
+// 阶段之间有嵌套 (convert 里面会 decode / upload 纹理)，这里记的是"独占"时间：
+// 进入内层阶段时外层暂停计时，出来后继续，所以各阶段加起来等于总时间，不会重复算。
+// finishGpu 打开时 upload / mipmap 结束前 glFinish，记到的是驱动真正做完的时间，
+// 否则只是把命令交给驱动的时间。只在主线程 (GL 上下文所在线程) 用；
+// 后台加载的线程 (uploadService.h) 先 IgnoreCurrentThread，它上面的计时和字节数都不记
+// ==========================================================
+class LoadProfiler {
+public:
+    bool enabled = false;
+    bool finishGpu = false;
+    LoadStats stats;
+
+    static LoadProfiler& Get() {
+        static LoadProfiler instance;
+        return instance;
+    }
+
+    // 返回之前的阶段，Leave 时传回来
+    int Enter(int stage) {
+        charge();
+        int previous = current;
+        current = stage;
+        stats.count[stage]++;
+        return previous;
+    }
+
+    void Leave(int previous) {
+        if (finishGpu && (current == LOAD_UPLOAD || current == LOAD_MIPMAP)) glFinish();
+        charge();
+        current = previous;
+    }
+
+    void AddBytes(int stage, size_t bytes) {
+        if (!ignoredThread() && enabled) stats.bytes[stage] += bytes;
+    }
+
+    static void IgnoreCurrentThread() { ignoredThread() = true; }
+    static bool& ignoredThread() {
+        thread_local bool ignored = false;
+        return ignored;
+    }
+
+private:
+    int current = -1;
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+
+    // 把上次切换到现在的时间记给当前阶段
+    void charge() {
+        auto now = std::chrono::steady_clock::now();
+        if (current >= 0) stats.ms[current] += std::chrono::duration<double, std::milli>(now - last).count();
+        last = now;
+    }
+};
+
+class LoadStageTimer {
+public:
+    explicit LoadStageTimer(int stage) : active(!LoadProfiler::ignoredThread() && LoadProfiler::Get().enabled) {
+        if (active) previous = LoadProfiler::Get().Enter(stage);
+    }
+    ~LoadStageTimer() {
+        if (active) LoadProfiler::Get().Leave(previous);
+    }
+
+    LoadStageTimer(const LoadStageTimer&) = delete;
+    LoadStageTimer& operator=(const LoadStageTimer&) = delete;
+
+private:
+    bool active;
+    int previous = -1;
+};
+
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "shader.h"
+#include "bounds.h"
 
 using namespace std;
 
@@ -30,15 +31,26 @@ public:
     vector<unsigned int> indices;
     vector<TextureInfo>  textures;
     unsigned int VAO;
+    AABB bounds;  // 模型空间的包围盒
 
-    // 构造函数
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<TextureInfo> textures);
+    // 构造函数。upload = false 时不碰 GL (后台加载)，缓冲由上传线程建好再 AttachBuffers
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<TextureInfo> textures, bool upload = true);
 
     // 绘制函数
     void Draw(Shader &shader);
 
+    // 删除 GPU 上的缓冲 (Mesh 会被按值拷贝，所以没有放在析构函数里，由 Model 统一释放)
+    void Release();
+
+    // 后台加载用 (uploadService.h)：上传线程交过来的顶点 / 索引缓冲，只记下名字
+    void AttachBuffers(unsigned int vertexBuffer, unsigned int indexBuffer);
+    // VAO 不在上下文之间共享，缓冲上传完 (fence 过了) 之后在渲染线程上建
+    void CreateVertexArray();
+
 private:
-    unsigned int VBO, EBO;
+    unsigned int VBO = 0, EBO = 0;
     void setupMesh();
+    void setupAttributes();
+    void trackHostMemory();
 };
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "mesh.h"
 #include "shader.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,21 @@
 using namespace std;
 
 unsigned int TextureFromFile(const char *path, const string &directory, bool gamma = false);
+
+// 解码好、还没上传的贴图 (后台加载时留在 Model::pendingTextures 里)
+struct DecodedTexture {
+    string filename;
+    int width = 0, height = 0, components = 0;
+    shared_ptr<unsigned char> pixels;   // stbi_load 分配的，解码失败时为空
+};
+// 只解码不碰 GL，任何线程都能调
+DecodedTexture DecodeTextureFile(const char *path, const string &directory);
+
+enum ModelLoadMode {
+    MODEL_LOAD_IMMEDIATE,   // 构造时直接建缓冲和纹理 (当前线程要有 GL 上下文)
+    MODEL_LOAD_DEFERRED     // 构造时不碰 GL：网格没有缓冲，贴图解码后放进 pendingTextures，由 ModelStreamer 上传
+};
+class JobSystem;
 struct aiNode;
 struct aiScene;
 struct aiMesh;
@@ -28,15 +44,34 @@ public:
     vector<Mesh>    meshes;
     string directory;
     bool gammaCorrection;
+    AABB bounds;  // 所有子网格合起来的包围盒 (模型空间)
+    // MODEL_LOAD_DEFERRED 时和 textures_loaded 一一对应，上传完调 SetTextureIds
+    vector<DecodedTexture> pendingTextures;
 
-    Model(string const &path, bool gamma = false);
+    Model(string const &path, bool gamma = false, ModelLoadMode mode = MODEL_LOAD_IMMEDIATE);
+    // 从已经读好的场景建 (场景归调用者)，贴图路径相对 directory。测试里用合成的场景
+    Model(const aiScene *scene, string const &directory, bool gamma = false, ModelLoadMode mode = MODEL_LOAD_DEFERRED);
     void Draw(Shader &shader);
     void DrawAt(glm::vec3 pos, Shader &shader);
+    // 删除所有网格的缓冲和加载的纹理 (反复加载同一个模型的基准测试用)
+    void Release();
+    // 后台加载：pendingTextures 上传后得到的纹理名 (同样的顺序)，填回 textures_loaded 和各个网格
+    void SetTextureIds(const vector<unsigned int> &ids);
+    bool Loaded() const { return loaded; }
+    // 之后加载的模型转换网格用的任务系统，必须活得比用它的加载长。基准测试按线程数扫描用
+    // nullptr = 立即加载用全局的、后台加载在当前线程上串行转换；设了的话后台加载也用它 (不要传全局的那个)
+    static void SetConversionJobSystem(JobSystem *jobs);
 
 private:
+    ModelLoadMode loadMode;
+    bool loaded = false;      // Assimp 读成功了
     void loadModel(string const &path);
-    void processNode(aiNode *node, const aiScene *scene);
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene);
+    // 展开节点树、转换网格、建 Mesh，最后算包围盒
+    void processScene(const aiScene *scene);
+    // 把节点树展开成要转换的网格 (深度优先)，跳过头发阴影 / 顔影
+    void processNode(aiNode *node, const aiScene *scene, vector<aiMesh*> &out);
+    // vertices / indices 是已经转换好的几何，这里加载材质贴图、建 Mesh (数据被移走)
+    Mesh processMesh(aiMesh *mesh, const aiScene *scene, vector<Vertex> &vertices, vector<unsigned int> &indices);
     vector<TextureInfo> loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName);
 };
 
@@ -0,0 +1,152 @@
+#ifndef MODELSTREAMER_H
+#define MODELSTREAMER_H
+
+#include <glad/glad.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model.h"
+#include "resourceTracker.h"
+#include "uploadService.h"
+
+enum StreamState {
+    STREAM_QUEUED,      // 排在上传线程的队列里
+    STREAM_LOADING,     // 上传线程上：解析 + 解码 + 上传
+    STREAM_UPLOADED,    // 命令都交出去了，等 fence
+    STREAM_RESIDENT,    // 可以画了
+    STREAM_FAILED
+};
+
+inline const char* StreamStateName(int state) {
+    static const char* names[] = { "queued", "loading", "uploaded", "resident", "failed" };
+    return state >= 0 && state <= STREAM_FAILED ? names[state] : "?";
+}
+
+// 一个正在 / 已经流式加载的模型。model 只有在 STREAM_RESIDENT 之后渲染线程才能碰
+struct StreamedModel {
+    std::string path;
+    std::unique_ptr<Model> model;
+    std::atomic<int> state{ STREAM_QUEUED };
+    bool async = false;         // 请求时有没有上传服务
+    GLsync fence = nullptr;
+
+    // 时间 (毫秒)
+    float loadMs = 0.0f;        // 上传线程：Assimp + 转换 + 解码
+    float uploadMs = 0.0f;      // 上传线程：把数据交给驱动
+    float finalizeMs = 0.0f;    // 渲染线程：建 VAO (同步加载时是整个加载)
+    float residentMs = 0.0f;    // 从请求到可以画
+    std::chrono::steady_clock::time_point requestTime;
+};
+
+// ==========================================================
+// 场景运行中加载模型，渲染线程不卡：
+// 上传线程上 Model(MODEL_LOAD_DEFERRED) 解析 + 解码，再经 UploadService 把贴图和顶点 / 索引缓冲传上去，插 fence；
+// 渲染线程每帧 Poll，fence 过了的在这边建 VAO，变成 STREAM_RESIDENT 交出去。
+// 没有上传服务 (没有共享上下文 / 正在录 GL 命令流) 时退回同步加载：下一次 Poll 在渲染线程上整个加载完
+// ==========================================================
+class ModelStreamer {
+public:
+    ModelStreamer() = default;
+    ~ModelStreamer() {
+        for (const std::shared_ptr<StreamedModel>& streamed : inFlight)
+            if (streamed->fence) glDeleteSync(streamed->fence);
+    }
+
+    ModelStreamer(const ModelStreamer&) = delete;
+    ModelStreamer& operator=(const ModelStreamer&) = delete;
+
+    // 换上传服务 (nullptr = 同步加载)，之前发出去的请求还是由原来的服务做完，它必须活到它们都 resident
+    void SetUploadService(UploadService* service) { uploads = service && service->Valid() ? service : nullptr; }
+    bool Async() const { return uploads != nullptr; }
+
+    std::shared_ptr<StreamedModel> Load(const std::string& path, bool gamma = false) {
+        auto streamed = std::make_shared<StreamedModel>();
+        streamed->path = path;
+        streamed->requestTime = std::chrono::steady_clock::now();
+        streamed->async = uploads != nullptr;
+        inFlight.push_back(streamed);
+        if (!uploads) return streamed;
+
+        uploads->Submit([streamed, gamma](UploadService& service) {
+            streamed->state.store(STREAM_LOADING, std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            ResourceOwnerScope owner(streamed->path);
+            auto model = std::make_unique<Model>(streamed->path, gamma, MODEL_LOAD_DEFERRED);
+            auto loaded = std::chrono::steady_clock::now();
+            streamed->loadMs = std::chrono::duration<float, std::milli>(loaded - start).count();
+            if (!model->Loaded()) {
+                streamed->state.store(STREAM_FAILED, std::memory_order_release);
+                return;
+            }
+
+            std::vector<unsigned int> textureIds;
+            for (DecodedTexture& texture : model->pendingTextures) {
+                textureIds.push_back(service.UploadTexture(texture.pixels.get(), texture.width, texture.height,
+                                                           texture.components, texture.filename));
+                texture.pixels.reset();   // 传完马上释放解码的内存
+            }
+            model->SetTextureIds(textureIds);
+            for (Mesh& mesh : model->meshes) {
+                unsigned int vertexBuffer = service.UploadBuffer(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex), RESOURCE_MESH);
+                unsigned int indexBuffer = service.UploadBuffer(mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int), RESOURCE_MESH);
+                mesh.AttachBuffers(vertexBuffer, indexBuffer);
+            }
+            streamed->fence = service.Fence();
+            streamed->uploadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loaded).count();
+            streamed->model = std::move(model);
+            streamed->state.store(STREAM_UPLOADED, std::memory_order_release);
+        });
+        return streamed;
+    }
+
+    // 渲染线程每帧调用：返回这一帧变成 resident 的模型 (失败的也从队列里拿掉，不返回)
+    std::vector<std::shared_ptr<StreamedModel>> Poll() {
+        std::vector<std::shared_ptr<StreamedModel>> ready;
+        for (size_t i = 0; i < inFlight.size();) {
+            std::shared_ptr<StreamedModel>& streamed = inFlight[i];
+            if (finalize(*streamed)) ready.push_back(streamed);
+            int state = streamed->state.load(std::memory_order_acquire);
+            if (state == STREAM_RESIDENT || state == STREAM_FAILED) inFlight.erase(inFlight.begin() + i);
+            else i++;
+        }
+        return ready;
+    }
+
+    // 还没 resident 的请求数
+    int Pending() const { return static_cast<int>(inFlight.size()); }
+
+private:
+    UploadService* uploads = nullptr;
+    std::vector<std::shared_ptr<StreamedModel>> inFlight;
+
+    // 变成 resident 时返回 true
+    bool finalize(StreamedModel& streamed) {
+        int state = streamed.state.load(std::memory_order_acquire);
+        auto start = std::chrono::steady_clock::now();
+        if (!streamed.async && state == STREAM_QUEUED) {
+            // 同步加载：和以前一样整个在渲染线程上做
+            streamed.model = std::make_unique<Model>(streamed.path);
+            if (!streamed.model->Loaded()) {
+                streamed.state.store(STREAM_FAILED, std::memory_order_relaxed);
+                return false;
+            }
+        } else if (state == STREAM_UPLOADED && UploadFenceSignaled(streamed.fence)) {
+            glDeleteSync(streamed.fence);
+            streamed.fence = nullptr;
+            ResourceOwnerScope owner(streamed.path);
+            for (Mesh& mesh : streamed.model->meshes) mesh.CreateVertexArray();
+        } else {
+            return false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        streamed.finalizeMs = std::chrono::duration<float, std::milli>(now - start).count();
+        streamed.residentMs = std::chrono::duration<float, std::milli>(now - streamed.requestTime).count();
+        streamed.state.store(STREAM_RESIDENT, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef LEARNOPENGL_CLION_OUTLINEDATA_H
+#define LEARNOPENGL_CLION_OUTLINEDATA_H
+#include <glm/glm.hpp>
+
+// 描边方式
+enum OutlineMode {
+    OUTLINE_NONE,
+    OUTLINE_HULL,          // 法线外扩 + 正面剔除，整个模型再画一遍 (outline.vert)
+    OUTLINE_SCREEN_SPACE   // 全屏后处理：在深度 / 法线不连续的地方画线 (ssOutline.frag)
+};
+
+// 全局覆盖：按物体自己的设置，或者全部强制成某一种
+enum OutlineOverride {
+    OUTLINE_PER_OBJECT,
+    OUTLINE_ALL_HULL,
+    OUTLINE_ALL_SCREEN_SPACE,
+    OUTLINE_ALL_OFF
+};
+
+struct OutlineData {
+    int overrideMode = OUTLINE_PER_OBJECT;
+    glm::vec3 color = glm::vec3(0.3f);
+    float hullWidth = 0.2f;         // outline.vert 里的“屏幕相对粗细”
+    float thickness = 1.0f;         // 屏幕空间描边的采样半径 (像素)
+    float depthThreshold = 0.05f;   // 线性深度相对差超过它就算轮廓
+    float normalThreshold = 0.4f;   // 1 - dot(n1, n2) 超过它就算折痕
+    bool compare = false;           // A/B 对比：两种方法每隔一段时间自动切换，分别统计耗时
+
+    // 物体最终使用的描边方式
+    OutlineMode Resolve(OutlineMode objectMode) const {
+        if (objectMode == OUTLINE_NONE) return OUTLINE_NONE;
+        switch (overrideMode) {
+            case OUTLINE_ALL_HULL: return OUTLINE_HULL;
+            case OUTLINE_ALL_SCREEN_SPACE: return OUTLINE_SCREEN_SPACE;
+            case OUTLINE_ALL_OFF: return OUTLINE_NONE;
+            default: return objectMode;
+        }
+    }
+};
+
+// 两种描边的 GPU 耗时 (毫秒，A/B 对比时是平均值)
+// 外扩法的代价是多画一遍模型；屏幕空间法的代价是 toon 帧多写一张法线图 + 一次全屏 pass
+struct OutlineTimings {
+    float hullPass = 0.0f;          // 外扩描边 pass
+    float toonWithHull = 0.0f;      // 外扩模式下的 toon pass
+    float screenPass = 0.0f;        // 屏幕空间描边 pass
+    float toonWithScreen = 0.0f;    // 屏幕空间模式下的 toon pass (多写法线 / 遮罩)
+};
+#endif //LEARNOPENGL_CLION_OUTLINEDATA_H
\ No newline at end of file
@@ -4,6 +4,9 @@
 
 #ifndef LEARNOPENGL_CLION_POINTLIGHTDATA_H
 #define LEARNOPENGL_CLION_POINTLIGHTDATA_H
+// LightBlock 里最多多少个点光源 (和 toon / pbr 着色器里的 MAX_POINT_LIGHTS 一致)
+// 每个 80 字节，128 个加上光源数一共 10 KB 多一点，在 UBO 最小保证的 16 KB 以内
+const int MAX_POINT_LIGHTS = 128;
 // 强烈建议使用 vec4 替代 vec3 + padding，避免编译器对齐差异
 struct PointLightData {
     glm::vec4 position;  // xyz = position, w = padding
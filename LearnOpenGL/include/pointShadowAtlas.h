@@ -0,0 +1,344 @@
+#ifndef POINTSHADOWATLAS_H
+#define POINTSHADOWATLAS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "shader.h"
+#include "renderObject.h"
+#include "shadowCache.h"
+#include "pointLightData.h"
+#include "UBO.h"
+#include "bounds.h"
+
+const int MAX_SHADOW_LIGHTS = 4;
+const int SHADOW_FACE_COUNT = MAX_SHADOW_LIGHTS * 6;
+
+// 对应着色器里的 ShadowBlock (std140, binding = 2)
+// 每个面单独记录“渲染时”用的矩阵和光源位置：预算不够时有的面会晚几帧才更新，
+// 着色器要用它被画出来那一刻的参数去比较，阴影才不会错位
+struct ShadowBlockData {
+    glm::mat4 faceMatrices[SHADOW_FACE_COUNT]; // 光照空间矩阵
+    glm::vec4 faceRects[SHADOW_FACE_COUNT];    // xy = 图集 UV 偏移, zw = UV 大小
+    glm::vec4 faceLightPos[SHADOW_FACE_COUNT]; // xyz = 渲染时的光源位置, w = 远平面
+    glm::vec4 lightShadow[MAX_SHADOW_LIGHTS];  // x = 是否有阴影, y = 图集纹素大小 (UV), z = bias, w = 未用
+};
+
+// 点光源阴影统计
+struct PointShadowStats {
+    unsigned int facesRendered = 0;   // 本帧重画的面数
+    unsigned int facesDeferred = 0;   // 本帧该画但被预算推迟的面数
+    unsigned int facesHidden = 0;     // 本帧视锥和摄像机视锥不相交、直接跳过的面数
+    unsigned int relayouts = 0;       // 分辨率变化导致图集重新排布的次数
+    int resolution[MAX_SHADOW_LIGHTS] = {};   // 每个光源每个面的分辨率
+    float influence[MAX_SHADOW_LIGHTS] = {};  // 屏幕影响力 (0 ~ 1)
+};
+
+// ==========================================================
+// 点光源的立方体阴影，6 个面都塞进一张 2D 深度图集里
+// 1. 每个光源按它在屏幕上的影响力选分辨率 (128 ~ 1024)
+// 2. 每帧最多重画 faceBudget 个面：光源动了的面优先，剩下的按“多久没更新”轮流刷新，
+//    影响力小 (远处) 的光源刷新间隔更长
+// 3. 每个面的静态 / 动态层缓存交给 ShadowCache，投射物按面的视锥剔除
+// 4. 面的视锥和摄像机视锥不相交时，这个面上的阴影不可能落进画面，先不画
+// ==========================================================
+class PointShadowAtlas {
+public:
+    int faceBudget = 8;             // 每帧最多重画多少个面
+    float influenceCutoff = 0.05f;  // 光照衰减到这个比例以下就不算影响范围
+    float bias = 0.05f;             // 世界空间的深度偏移
+    PointShadowStats stats;
+
+    PointShadowAtlas(unsigned int atlasSize = 4096)
+        : atlasSize(atlasSize), cache(atlasSize, atlasSize), shadowUBO(sizeof(ShadowBlockData), 2) {
+        for (int i = 0; i < MAX_SHADOW_LIGHTS; i++) {
+            lights[i].requested = 0;
+            lights[i].resolution = 0;
+            lights[i].lastPos = glm::vec3(0.0f);
+            lights[i].lastFar = 0.0f;
+        }
+        for (int f = 0; f < SHADOW_FACE_COUNT; f++) {
+            faces[f].lastUpdate = -1000000;
+            faces[f].dirty = true;
+        }
+        blockData = ShadowBlockData{};
+    }
+
+    // 换了场景：缓存按物体指针 + 模型矩阵比较，新场景的物体可能落在旧地址上，静态层必须重建。
+    // 所有面也标脏，按脏面优先尽快重画，不用等刷新间隔
+    void Invalidate() {
+        cache.Invalidate();
+        for (int f = 0; f < SHADOW_FACE_COUNT; f++) faces[f].dirty = true;
+    }
+
+    unsigned int DepthMap() const { return cache.depthMap; }
+    const ShadowCacheStats& CacheStats() const { return cache.stats; }
+    // 某个光源 6 个面最近一次更新的剔除结果加起来
+    CullStats LightCull(int light) const {
+        CullStats total;
+        for (int f = 0; f < 6; f++) total.Add(cache.SlotCull(light * 6 + f));
+        return total;
+    }
+
+    // 更新图集并上传 ShadowBlock
+    // fovY: 摄像机竖直视角 (角度)，用来估算屏幕影响力
+    // casters: 场景里所有可能投射阴影的物体，每个面会按自己的视锥剔除
+    void Update(const PointLightData* pointLights, int lightCount,
+                const glm::vec3& cameraPos, const glm::mat4& viewProjection, float fovY,
+                Shader& depthShader, const std::vector<RenderObject*>& casters) {
+        frameIndex++;
+        cache.BeginFrame();
+        stats.facesRendered = 0;
+        stats.facesDeferred = 0;
+        stats.facesHidden = 0;
+        Frustum cameraFrustum(viewProjection);
+        lightCount = std::min(lightCount, MAX_SHADOW_LIGHTS);
+
+        // 1. 选分辨率档位，档位 (不是图集放不下时降档后的实际大小) 变了才重新排布图集
+        bool relayout = lightCount != layoutLightCount;
+        for (int i = 0; i < lightCount; i++) {
+            glm::vec3 pos = glm::vec3(pointLights[i].position);
+            float range = lightRange(pointLights[i]);
+            float influence = screenInfluence(pos, range, cameraPos, cameraFrustum, fovY);
+            int res = pickResolution(influence, lights[i].requested);
+            stats.influence[i] = influence;
+            if (res != lights[i].requested) {
+                lights[i].requested = res;
+                relayout = true;
+            }
+            // 光源动了：它的 6 个面都要尽快重画
+            if (pos != lights[i].lastPos || range != lights[i].lastFar) {
+                lights[i].lastPos = pos;
+                lights[i].lastFar = range;
+                for (int f = 0; f < 6; f++) faces[i * 6 + f].dirty = true;
+            }
+        }
+        for (int i = lightCount; i < MAX_SHADOW_LIGHTS; i++) {
+            lights[i].requested = 0;
+            lights[i].resolution = 0;
+        }
+        if (relayout) {
+            layoutAtlas(lightCount);
+            stats.relayouts++;
+        }
+
+        // 2. 选出本帧要重画的面
+        std::vector<int> candidates;
+        for (int i = 0; i < lightCount; i++) {
+            int interval = refreshInterval(lights[i].resolution);
+            for (int f = 0; f < 6; f++) {
+                int index = i * 6 + f;
+                if (!faces[index].dirty && frameIndex - faces[index].lastUpdate < interval)
+                    continue;
+                // 看不见的面保持 dirty，等它进入画面时再优先画
+                glm::mat4 lightSpace = faceMatrix(lights[i].lastPos, f, lights[i].lastFar);
+                if (!cameraFrustum.Intersects(Frustum::Corners(lightSpace))) {
+                    stats.facesHidden++;
+                    continue;
+                }
+                candidates.push_back(index);
+            }
+        }
+        // 脏的面优先，其余按“最久没更新”排序，这样远处的光源会被轮流刷新
+        std::stable_sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            if (faces[a].dirty != faces[b].dirty) return faces[a].dirty;
+            return faces[a].lastUpdate < faces[b].lastUpdate;
+        });
+        // 图集重新排布后旧内容已经不对了，这一帧必须全部画完，不受预算限制
+        size_t budget = relayout ? candidates.size() : static_cast<size_t>(std::max(faceBudget, 0));
+        size_t renderCount = std::min(budget, candidates.size());
+        stats.facesDeferred = static_cast<unsigned int>(candidates.size() - renderCount);
+
+        // 3. 渲染选中的面
+        for (size_t c = 0; c < renderCount; c++) {
+            int index = candidates[c];
+            int light = index / 6;
+            int face = index % 6;
+            glm::vec3 pos = lights[light].lastPos;
+            float farPlane = lights[light].lastFar;
+            glm::mat4 lightSpace = faceMatrix(pos, face, farPlane);
+
+            depthShader.use();
+            depthShader.setVec3("lightPos", pos);
+            depthShader.setFloat("farPlane", farPlane);
+            const FaceState& fs = faces[index];
+            cache.RenderRegion(index, fs.x, fs.y, fs.size, fs.size, lightSpace, depthShader, casters);
+
+            faces[index].dirty = false;
+            faces[index].lastUpdate = frameIndex;
+            blockData.faceMatrices[index] = lightSpace;
+            blockData.faceLightPos[index] = glm::vec4(pos, farPlane);
+            stats.facesRendered++;
+        }
+
+        // 4. 上传给着色器
+        float texel = 1.0f / static_cast<float>(atlasSize);
+        for (int i = 0; i < MAX_SHADOW_LIGHTS; i++) {
+            stats.resolution[i] = lights[i].resolution;
+            bool enabled = i < lightCount && lights[i].resolution > 0;
+            blockData.lightShadow[i] = glm::vec4(enabled ? 1.0f : 0.0f, texel, bias, 0.0f);
+        }
+        for (int f = 0; f < SHADOW_FACE_COUNT; f++) {
+            blockData.faceRects[f] = glm::vec4(faces[f].x * texel, faces[f].y * texel,
+                                               faces[f].size * texel, faces[f].size * texel);
+        }
+        shadowUBO.SetData(0, sizeof(ShadowBlockData), &blockData);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+private:
+    struct LightState {
+        int requested;   // 按影响力选的档位
+        int resolution;  // 图集里实际分到的大小 (放不下时比 requested 小)
+        glm::vec3 lastPos;
+        float lastFar;
+    };
+    struct FaceState {
+        int x = 0, y = 0, size = 0; // 图集里的像素区域
+        int lastUpdate;
+        bool dirty;
+    };
+
+    static const int MIN_RESOLUTION = 128;
+    static const int MAX_RESOLUTION = 1024;
+
+    unsigned int atlasSize;
+    ShadowCache cache;
+    UBO shadowUBO;
+    ShadowBlockData blockData;
+    LightState lights[MAX_SHADOW_LIGHTS];
+    FaceState faces[SHADOW_FACE_COUNT];
+    int frameIndex = 0;
+    int layoutLightCount = 0;   // 上次排布时的光源数
+
+    // 衰减到 influenceCutoff 时的距离，也就是阴影的远平面
+    float lightRange(const PointLightData& light) const {
+        float maxIntensity = std::max(std::max(light.diffuse.x, light.diffuse.y), light.diffuse.z);
+        float target = maxIntensity / influenceCutoff; // constant + linear*d + quadratic*d^2 = target
+        float c = light.constant - target;
+        float range;
+        if (light.quadratic > 1e-6f)
+            range = (-light.linear + std::sqrt(light.linear * light.linear - 4.0f * light.quadratic * c)) / (2.0f * light.quadratic);
+        else if (light.linear > 1e-6f)
+            range = -c / light.linear;
+        else
+            range = 100.0f;
+        return glm::clamp(range, 1.0f, 100.0f);
+    }
+
+    // 光源影响球在屏幕上占的比例 (0 ~ 1)，完全在视锥外的光源影响力为 0
+    static float screenInfluence(const glm::vec3& pos, float range, const glm::vec3& cameraPos,
+                                 const Frustum& cameraFrustum, float fovY) {
+        if (!cameraFrustum.Intersects(pos, range)) return 0.0f;
+        float dist = glm::length(pos - cameraPos);
+        if (dist <= range) return 1.0f;
+        // 投影半径 / 半屏高
+        float projected = range / (dist * std::tan(glm::radians(fovY) * 0.5f));
+        return glm::clamp(projected, 0.0f, 1.0f);
+    }
+
+    // 影响力 -> 分辨率，带 20% 的滞后区间，防止在阈值附近来回跳导致图集反复重排
+    static int pickResolution(float influence, int current) {
+        const float thresholds[] = { 0.5f, 0.25f, 0.1f };   // 1024, 512, 256，剩下是 128
+        int res = MIN_RESOLUTION;
+        int tier = 3;
+        for (int t = 0; t < 3; t++) {
+            if (influence >= thresholds[t]) { res = MAX_RESOLUTION >> t; tier = t; break; }
+        }
+        if (current == 0 || current == res) return res;
+        // 落在当前档位边界的滞后区间里就保持不变
+        int currentTier = 0;
+        while ((MAX_RESOLUTION >> currentTier) > current) currentTier++;
+        float boundary = thresholds[std::min(tier, currentTier)];
+        if (std::abs(influence - boundary) < boundary * 0.2f) return current;
+        return res;
+    }
+
+    // 分辨率越低 (越远) 刷新越慢: 1024 每帧, 512 每 2 帧, 256 每 4 帧, 128 每 8 帧
+    static int refreshInterval(int resolution) {
+        int interval = 1;
+        for (int r = MAX_RESOLUTION; r > resolution && r > MIN_RESOLUTION; r >>= 1) interval <<= 1;
+        return interval;
+    }
+
+    // 把所有面按 2 的幂大小从大到小塞进图集
+    // 以最小块为单位，按 Morton (Z) 顺序排，面积从大到小排列时每个块天然对齐，不会有缝隙
+    void layoutAtlas(int lightCount) {
+        // 从请求的档位开始，放不下就把影响力最小的光源降一档，直到总面积不超过图集。
+        // 降档只改实际大小，不改 requested，下一帧档位没变就不会再排一次。
+        // 影响力一样时先降分辨率大的、再降编号大的；0 号是主光源 (toon 着色只用它)，其它光源都降到最小了才动它
+        long long capacity = static_cast<long long>(atlasSize) * atlasSize;
+        layoutLightCount = lightCount;
+        for (int i = 0; i < MAX_SHADOW_LIGHTS; i++) lights[i].resolution = lights[i].requested;
+        while (true) {
+            long long total = 0;
+            for (int i = 0; i < lightCount; i++)
+                total += 6LL * lights[i].resolution * lights[i].resolution;
+            if (total <= capacity) break;
+            int victim = -1;
+            for (int i = lightCount - 1; i >= 1; i--) {
+                if (lights[i].resolution <= MIN_RESOLUTION) continue;
+                if (victim < 0 || stats.influence[i] < stats.influence[victim] ||
+                    (stats.influence[i] == stats.influence[victim] && lights[i].resolution > lights[victim].resolution))
+                    victim = i;
+            }
+            if (victim < 0 && lights[0].resolution > MIN_RESOLUTION) victim = 0;
+            if (victim < 0) break; // 都是最小分辨率了，图集太小
+            lights[victim].resolution >>= 1;
+        }
+
+        std::vector<int> order;
+        for (int f = 0; f < lightCount * 6; f++) order.push_back(f);
+        std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+            return lights[a / 6].resolution > lights[b / 6].resolution;
+        });
+
+        long long cursor = 0; // 以最小块为单位的面积游标
+        long long cells = capacity / (MIN_RESOLUTION * MIN_RESOLUTION);
+        for (int index : order) {
+            int size = lights[index / 6].resolution;
+            long long area = static_cast<long long>(size / MIN_RESOLUTION) * (size / MIN_RESOLUTION);
+            FaceState& fs = faces[index];
+            if (cursor + area > cells) { fs.size = 0; continue; }
+            unsigned int cx = 0, cy = 0;
+            mortonDecode(static_cast<unsigned int>(cursor), cx, cy);
+            fs.x = static_cast<int>(cx) * MIN_RESOLUTION;
+            fs.y = static_cast<int>(cy) * MIN_RESOLUTION;
+            fs.size = size;
+            fs.dirty = true;
+            cursor += area;
+        }
+        for (int f = lightCount * 6; f < SHADOW_FACE_COUNT; f++) faces[f].size = 0;
+    }
+
+    static void mortonDecode(unsigned int code, unsigned int& x, unsigned int& y) {
+        x = 0; y = 0;
+        for (int bit = 0; bit < 16; bit++) {
+            x |= ((code >> (2 * bit)) & 1u) << bit;
+            y |= ((code >> (2 * bit + 1)) & 1u) << bit;
+        }
+    }
+
+    // 立方体第 face 个面的光照空间矩阵 (顺序: +X -X +Y -Y +Z -Z，和立方体贴图一致)
+    static glm::mat4 faceMatrix(const glm::vec3& pos, int face, float farPlane) {
+        static const glm::vec3 dirs[6] = {
+            glm::vec3( 1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+            glm::vec3( 0.0f, 1.0f, 0.0f), glm::vec3( 0.0f,-1.0f, 0.0f),
+            glm::vec3( 0.0f, 0.0f, 1.0f), glm::vec3( 0.0f, 0.0f,-1.0f)
+        };
+        static const glm::vec3 ups[6] = {
+            glm::vec3(0.0f,-1.0f, 0.0f), glm::vec3(0.0f,-1.0f, 0.0f),
+            glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f,-1.0f),
+            glm::vec3(0.0f,-1.0f, 0.0f), glm::vec3(0.0f,-1.0f, 0.0f)
+        };
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.05f, farPlane);
+        return projection * glm::lookAt(pos, pos + dirs[face], ups[face]);
+    }
+};
+
+#endif
@@ -9,6 +9,36 @@ struct PostProcessingData {
     int amount = 10;
     float gamma = 1.2f;
     float bloomStrength = 0.4;
+    int bloomMode = 0;              // 0 = mip 链, 1 = 旧的 ping-pong 高斯, 2 = 计算着色器高斯 (见 BloomRenderer)
+    int bloomMips = 6;              // mip 链的级数，级数越多光晕越大
+    float bloomFilterRadius = 0.005f; // 升采样 tent 滤波半径 (UV)
+    int bloomBlurRadius = 16;       // 计算着色器高斯的半径 (像素)
+    float bloomThreshold = 1.0f;    // 亮度超过它才发光
+    float bloomKnee = 0.5f;         // 阈值附近的软过渡宽度
+    // 自动曝光 (见 AutoExposure)：打开后 exposure 变成在自动曝光基础上的补偿
+    bool autoExposure = true;
+    float exposureKey = 0.18f;        // 平均亮度映射到中灰
+    float exposureMinLogLum = -8.0f;  // 直方图覆盖的 log2 亮度范围
+    float exposureMaxLogLum = 4.0f;
+    float exposureLowPercent = 0.1f;  // 忽略最暗的 10% 和最亮的 10% 像素
+    float exposureHighPercent = 0.9f;
+    float adaptSpeedUp = 3.0f;        // 变亮 / 变暗的适应速度 (1/秒)
+    float adaptSpeedDown = 1.0f;
+    // 最终合成 (见 PostProcessor)
+    bool fusedPost = true;            // 所有效果合并成一个 pass；关掉后每个效果单独一个 pass，用来对比
+    bool colorGrading = false;
+    float saturation = 1.0f;
+    float contrast = 1.0f;
+    bool vignette = false;
+    float vignetteStrength = 0.4f;
+    float vignetteRadius = 0.5f;
     PostProcessingData() = default;
 };
+
+// 场景帧只剩一个颜色附件后省下的带宽 (估算)
+struct SceneBandwidthStats {
+    unsigned long long fragments = 0; // 场景帧通过深度测试的片元数 (GL_SAMPLES_PASSED)
+    double savedBytes = 0.0;          // 每帧少写的字节：每个片元 8 字节 + 清屏一整张 RGBA16F
+    double savedMemory = 0.0;         // 少分配的显存
+};
 #endif //LEARNOPENGL_CLION_POSTPROCESSINGDATA_H
\ No newline at end of file
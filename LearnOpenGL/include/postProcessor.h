@@ -0,0 +1,175 @@
+#ifndef POSTPROCESSOR_H
+#define POSTPROCESSOR_H
+
+#include <glad/glad.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shader.h"
+#include "screenQuad.h"
+#include "gpuTimer.h"
+#include "postProcessingData.h"
+#include "renderTargetPool.h"
+
+// screen.frag 里的效果开关，一个组合对应一个编译好的变体
+enum PostFeature {
+    POST_BLOOM         = 1 << 0,
+    POST_TONEMAP       = 1 << 1,
+    POST_AUTO_EXPOSURE = 1 << 2,  // 只修改 POST_TONEMAP，不单独成 pass
+    POST_COLOR_GRADING = 1 << 3,
+    POST_VIGNETTE      = 1 << 4,
+    POST_GAMMA         = 1 << 5
+};
+
+// 合并 / 不合并两种方式的耗时和估算带宽，GUI 里对比
+struct PostStats {
+    float fusedMs = 0.0f;
+    float separateMs = 0.0f;
+    int passes = 0;              // 当前方式下实际跑了几个 pass
+    double fusedBytes = 0.0;     // 合并成一个 pass 时每帧的读写字节数 (估算)
+    double separateBytes = 0.0;  // 每个效果单独一个 pass 时的读写字节数 (估算)
+    unsigned int variants = 0;   // 已经编译的着色器变体数
+};
+
+// ==========================================================
+// 最终的后处理 (泛光合成 / 曝光 / 色调映射 / 调色 / 暗角 / 伽马)
+// 所有效果都在 screen.frag 里，用开关组合拼成 #define 编译，变体第一次用到时才编译并缓存。
+// 合并模式：一个 pass 读场景 + 泛光，直接写默认帧缓冲。
+// 不合并模式：每个效果单独一个 pass，中间结果放在 RGBA16F 里 (从 RenderTargetPool 借)，
+// 只用来测量合并省下的时间和带宽
+// ==========================================================
+class PostProcessor {
+public:
+    PostStats stats;
+
+    explicit PostProcessor(RenderTargetPool& targets) : targets(targets) {
+        glGenFramebuffers(1, &intermediateFBO);
+    }
+
+    ~PostProcessor() {
+        glDeleteFramebuffers(1, &intermediateFBO);
+    }
+
+    // 当前设置下打开了哪些效果 (色调映射和伽马总是打开)
+    static unsigned int FeatureMask(const PostProcessingData& settings) {
+        unsigned int mask = POST_TONEMAP | POST_GAMMA;
+        if (settings.bloomStrength > 0.0f) mask |= POST_BLOOM;
+        if (settings.autoExposure) mask |= POST_AUTO_EXPOSURE;
+        if (settings.colorGrading) mask |= POST_COLOR_GRADING;
+        if (settings.vignette) mask |= POST_VIGNETTE;
+        return mask;
+    }
+
+    // 把最终画面画到 outputFBO (默认帧缓冲或者无窗口模式的 FBO，backbuffer 大小)
+    void Render(unsigned int sceneTexture, unsigned int bloomTexture, unsigned int exposureTexture,
+                ScreenQuad& screenQuad, const PostProcessingData& settings, unsigned int outputFBO = 0) {
+        unsigned int mask = FeatureMask(settings);
+        std::vector<unsigned int> passes = settings.fusedPost ? std::vector<unsigned int>{ mask } : splitPasses(mask);
+        GpuTimer& timer = settings.fusedPost ? fusedTimer : separateTimer;
+
+        timer.Begin();
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, bloomTexture);
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, exposureTexture);
+        glViewport(0, 0, targets.Width(), targets.Height());
+        unsigned int input = sceneTexture;
+        for (size_t i = 0; i < passes.size(); i++) {
+            bool last = i + 1 == passes.size();
+            unsigned int output = 0;
+            if (last) {
+                glBindFramebuffer(GL_FRAMEBUFFER, outputFBO);
+            } else {
+                output = targets.Acquire(RenderTargetDesc(GL_RGBA16F));
+                glBindFramebuffer(GL_FRAMEBUFFER, intermediateFBO);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, output, 0);
+            }
+            Shader& shader = program(passes[i]);
+            shader.use();
+            shader.setInt("scene", 0);
+            shader.setInt("bloomBlur", 1);
+            shader.setInt("exposureTexture", 2);
+            shader.setFloat("exposure", settings.exposure);
+            shader.setFloat("gamma", settings.gamma);
+            shader.setFloat("bloomStrength", settings.bloomStrength);
+            shader.setFloat("saturation", settings.saturation);
+            shader.setFloat("contrast", settings.contrast);
+            shader.setFloat("vignetteStrength", settings.vignetteStrength);
+            shader.setFloat("vignetteRadius", settings.vignetteRadius);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, input);
+            screenQuad.Draw();
+            input = output;
+        }
+        glEnable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        timer.End();
+
+        stats.fusedMs = fusedTimer.Average();
+        stats.separateMs = separateTimer.Average();
+        stats.passes = static_cast<int>(passes.size());
+        double pixels = static_cast<double>(targets.Width()) * targets.Height();
+        stats.fusedBytes = estimateBytes({ mask }, pixels);
+        stats.separateBytes = estimateBytes(splitPasses(mask), pixels);
+        stats.variants = static_cast<unsigned int>(programs.size());
+    }
+
+    void ResetTimings() {
+        fusedTimer.ResetAverage();
+        separateTimer.ResetAverage();
+    }
+
+private:
+    RenderTargetPool& targets;
+    unsigned int intermediateFBO;
+    std::map<unsigned int, std::unique_ptr<Shader>> programs;
+    GpuTimer fusedTimer;
+    GpuTimer separateTimer;
+
+    // 按 screen.frag 里的顺序把效果拆成单独的 pass (自动曝光跟着色调映射走)
+    static std::vector<unsigned int> splitPasses(unsigned int mask) {
+        static const unsigned int order[] = { POST_BLOOM, POST_TONEMAP, POST_COLOR_GRADING, POST_VIGNETTE, POST_GAMMA };
+        std::vector<unsigned int> passes;
+        for (unsigned int feature : order) {
+            if (!(mask & feature)) continue;
+            unsigned int pass = feature;
+            if (feature == POST_TONEMAP) pass |= mask & POST_AUTO_EXPOSURE;
+            passes.push_back(pass);
+        }
+        return passes;
+    }
+
+    // 每个 pass：读一张 RGBA16F (8 字节)，有泛光再读半分辨率的 R11G11B10F (每个屏幕像素约 1 字节)；
+    // 中间结果写 RGBA16F (8 字节)，最后一个写 backbuffer (RGBA8，4 字节)
+    static double estimateBytes(const std::vector<unsigned int>& passes, double pixels) {
+        double bytes = 0.0;
+        for (size_t i = 0; i < passes.size(); i++) {
+            bytes += pixels * 8.0;
+            if (passes[i] & POST_BLOOM) bytes += pixels * 1.0;
+            bytes += pixels * (i + 1 == passes.size() ? 4.0 : 8.0);
+        }
+        return bytes;
+    }
+
+    Shader& program(unsigned int mask) {
+        auto it = programs.find(mask);
+        if (it != programs.end()) return *it->second;
+        static const std::pair<unsigned int, const char*> names[] = {
+            { POST_BLOOM, "POST_BLOOM" }, { POST_TONEMAP, "POST_TONEMAP" },
+            { POST_AUTO_EXPOSURE, "POST_AUTO_EXPOSURE" }, { POST_COLOR_GRADING, "POST_COLOR_GRADING" },
+            { POST_VIGNETTE, "POST_VIGNETTE" }, { POST_GAMMA, "POST_GAMMA" }
+        };
+        std::string defines;
+        for (const auto& name : names)
+            if (mask & name.first) defines += std::string("#define ") + name.second + "\n";
+        std::unique_ptr<Shader>& shader = programs[mask];
+        shader = std::make_unique<Shader>("shaders/screen.vert", "shaders/screen.frag", defines);
+        return *shader;
+    }
+};
+
+#endif
\ No newline at end of file
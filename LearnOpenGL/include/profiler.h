@@ -0,0 +1,269 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 一个计时范围在某一帧里的结果，时间都相对于帧开始 (毫秒)
+struct ProfileEvent {
+    const char* name = "";
+    int depth = 0;            // 嵌套层数，0 = 最外层
+    double cpuStart = 0.0, cpuEnd = 0.0;
+    double gpuStart = 0.0, gpuEnd = 0.0;
+};
+
+struct ProfileFrame {
+    unsigned long long index = 0;
+    double cpuStart = 0.0;    // 帧开始时刻，相对于 Profiler 创建 (毫秒)
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    std::vector<ProfileEvent> events;
+};
+
+struct ProfilerStats {
+    unsigned int resolvedFrames = 0;
+    unsigned int droppedFrames = 0;  // GPU 落后太多，查询被复用之前还没结果，这一帧的 GPU 数据丢掉
+    unsigned int overflowScopes = 0; // 一帧里超过 MAX_SCOPES 的范围不计时
+};
+
+// ==========================================================
+// CPU + GPU 分段计时
+// CPU：steady_clock；GPU：每个范围前后各一个 glQueryCounter 时间戳 (不是 GL_TIME_ELAPSED，
+// 所以可以嵌套，也可以套在别的 GpuTimer 外面)。
+// 查询按帧排成一个环 (FRAME_LATENCY 帧)，EndFrame 时只读已经好了的旧帧，不会让 CPU 等 GPU；
+// 环转一圈回来还没好的帧就丢掉。
+// 结果：LastFrame() 是最近一帧完整的 CPU + GPU 数据，History() 给 GUI 画曲线；
+// StartCapture 录几帧，结束后写成 Chrome trace (chrome://tracing 或 ui.perfetto.dev 打开)
+// ==========================================================
+class Profiler {
+public:
+    static const int FRAME_LATENCY = 3;  // 同时在 GPU 上排队的帧数
+    static const int MAX_SCOPES = 64;    // 每帧最多多少个计时范围
+    static const int HISTORY_SIZE = 240; // GUI 曲线保留的帧数
+
+    bool enabled = true;
+    ProfilerStats stats;
+
+    Profiler() : origin(std::chrono::steady_clock::now()) {
+        for (FrameSlot& slot : slots) glGenQueries(2 * (MAX_SCOPES + 1), slot.queries);
+    }
+
+    ~Profiler() {
+        for (FrameSlot& slot : slots) glDeleteQueries(2 * (MAX_SCOPES + 1), slot.queries);
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void BeginFrame() {
+        active = enabled;
+        if (!active) return;
+        FrameSlot& slot = slots[current];
+        if (slot.pending) {
+            slot.pending = false; // 这个槽位的结果一直没等到，直接覆盖
+            stats.droppedFrames++;
+        }
+        slot.index = frameIndex++;
+        slot.cpuStart = now();
+        slot.scopeCount = 0;
+        depth = 0;
+        glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+    }
+
+    void EndFrame() {
+        if (!active) return;
+        FrameSlot& slot = slots[current];
+        slot.cpuEnd = now();
+        glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+        slot.pending = true;
+        current = (current + 1) % FRAME_LATENCY;
+        active = false;
+        resolve(false);
+    }
+
+    // 返回范围的编号，EndScope 时传回来 (一般用下面的 ProfileScope)
+    int BeginScope(const char* name) {
+        if (!active) return -1;
+        FrameSlot& slot = slots[current];
+        if (slot.scopeCount >= MAX_SCOPES) {
+            stats.overflowScopes++;
+            return -1;
+        }
+        int id = slot.scopeCount++;
+        ScopeRecord& scope = slot.scopes[id];
+        scope.name = name;
+        scope.depth = depth++;
+        scope.cpuStart = now();
+        glQueryCounter(slot.queries[2 + 2 * id], GL_TIMESTAMP);
+        return id;
+    }
+
+    void EndScope(int id) {
+        if (!active || id < 0) return;
+        FrameSlot& slot = slots[current];
+        ScopeRecord& scope = slot.scopes[id];
+        scope.cpuEnd = now();
+        glQueryCounter(slot.queries[3 + 2 * id], GL_TIMESTAMP);
+        depth--;
+    }
+
+    // 阻塞读回所有还没读的帧 (glFinish 之后调用，基准测试用)
+    void Flush() { resolve(true); }
+
+    const ProfileFrame& LastFrame() const { return lastFrame; }
+    const std::deque<ProfileFrame>& History() const { return history; }
+
+    // 录接下来 frames 帧，录完写到 path
+    void StartCapture(int frames, const std::string& path) {
+        captureRemaining = frames;
+        capturePath = path;
+        captured.clear();
+    }
+
+    bool IsCapturing() const { return captureRemaining > 0; }
+    const std::string& CapturePath() const { return capturePath; }
+
+    // Chrome trace-event 格式：CPU 和 GPU 各一条线程轨道，GPU 的时间对齐到同一帧 CPU 开始的时刻
+    static bool WriteChromeTrace(const std::string& path, const std::vector<ProfileFrame>& frames) {
+        std::ofstream file(path);
+        if (!file) {
+            std::cout << "ERROR::PROFILER:: Failed to open " << path << std::endl;
+            return false;
+        }
+        file << std::fixed << std::setprecision(3);
+        file << "{\"traceEvents\": [\n";
+        file << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"CPU\"}},\n";
+        file << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2, \"args\": {\"name\": \"GPU\"}}";
+        for (const ProfileFrame& frame : frames) {
+            double base = frame.cpuStart * 1000.0; // 微秒
+            writeTraceEvent(file, "frame", 1, base, frame.cpuMs * 1000.0);
+            writeTraceEvent(file, "frame", 2, base, frame.gpuMs * 1000.0);
+            for (const ProfileEvent& event : frame.events) {
+                writeTraceEvent(file, event.name, 1, base + event.cpuStart * 1000.0, (event.cpuEnd - event.cpuStart) * 1000.0);
+                writeTraceEvent(file, event.name, 2, base + event.gpuStart * 1000.0, (event.gpuEnd - event.gpuStart) * 1000.0);
+            }
+        }
+        file << "\n], \"displayTimeUnit\": \"ms\"}\n";
+        return static_cast<bool>(file);
+    }
+
+private:
+    struct ScopeRecord {
+        const char* name = "";
+        int depth = 0;
+        double cpuStart = 0.0, cpuEnd = 0.0;
+    };
+
+    // 一帧的查询：[0] 帧开始，[1] 帧结束，[2 + 2i] / [3 + 2i] 第 i 个范围的开始 / 结束
+    struct FrameSlot {
+        unsigned int queries[2 * (MAX_SCOPES + 1)];
+        ScopeRecord scopes[MAX_SCOPES];
+        int scopeCount = 0;
+        bool pending = false;
+        unsigned long long index = 0;
+        double cpuStart = 0.0, cpuEnd = 0.0;
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    FrameSlot slots[FRAME_LATENCY];
+    int current = 0;
+    int depth = 0;
+    bool active = false;
+    unsigned long long frameIndex = 0;
+    ProfileFrame lastFrame;
+    std::deque<ProfileFrame> history;
+    int captureRemaining = 0;
+    std::string capturePath;
+    std::vector<ProfileFrame> captured;
+
+    double now() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    // 从最老的帧开始读。帧结束的时间戳是这一帧最后一个查询，它好了前面的也都好了
+    void resolve(bool wait) {
+        for (int i = 0; i < FRAME_LATENCY; i++) {
+            FrameSlot& slot = slots[(current + i) % FRAME_LATENCY];
+            if (!slot.pending) continue;
+            if (!wait) {
+                GLint available = 0;
+                glGetQueryObjectiv(slot.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available) break;
+            }
+            readSlot(slot);
+        }
+    }
+
+    void readSlot(FrameSlot& slot) {
+        slot.pending = false;
+        GLuint64 frameStart = 0, frameEnd = 0;
+        glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &frameStart);
+        glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &frameEnd);
+
+        ProfileFrame frame;
+        frame.index = slot.index;
+        frame.cpuStart = slot.cpuStart;
+        frame.cpuMs = slot.cpuEnd - slot.cpuStart;
+        frame.gpuMs = toMs(frameStart, frameEnd);
+        frame.events.reserve(slot.scopeCount);
+        for (int i = 0; i < slot.scopeCount; i++) {
+            const ScopeRecord& scope = slot.scopes[i];
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(slot.queries[2 + 2 * i], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(slot.queries[3 + 2 * i], GL_QUERY_RESULT, &end);
+            ProfileEvent event;
+            event.name = scope.name;
+            event.depth = scope.depth;
+            event.cpuStart = scope.cpuStart - slot.cpuStart;
+            event.cpuEnd = scope.cpuEnd - slot.cpuStart;
+            event.gpuStart = toMs(frameStart, start);
+            event.gpuEnd = toMs(frameStart, end);
+            frame.events.push_back(event);
+        }
+        stats.resolvedFrames++;
+
+        if (captureRemaining > 0) {
+            captured.push_back(frame);
+            if (--captureRemaining == 0) {
+                if (WriteChromeTrace(capturePath, captured))
+                    std::cout << "Profiler trace written to " << capturePath << std::endl;
+                captured.clear();
+            }
+        }
+        history.push_back(frame);
+        if (history.size() > HISTORY_SIZE) history.pop_front();
+        lastFrame = std::move(frame);
+    }
+
+    static double toMs(GLuint64 from, GLuint64 to) {
+        return to > from ? (to - from) / 1000000.0 : 0.0;
+    }
+
+    static void writeTraceEvent(std::ostream& out, const char* name, int tid, double ts, double dur) {
+        out << ",\n  {\"name\": \"" << name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid
+            << ", \"ts\": " << ts << ", \"dur\": " << dur << "}";
+    }
+};
+
+// 作用域计时：构造时开始，析构时结束
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, const char* name) : profiler(profiler), id(profiler.BeginScope(name)) {}
+    ~ProfileScope() { profiler.EndScope(id); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    int id;
+};
+
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define RENDEROBJECT_H
 
 #include "model.h"
+#include "outlineData.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -19,6 +20,12 @@ public:
     glm::vec3 scale;
     glm::vec2 uvScale;
 
+    // 阴影相关
+    bool castShadow; // 是否投射阴影
+    bool isStatic;   // 静态物体：阴影只在光源或它自己变化时重画 (见 ShadowCache)
+
+    OutlineMode outline; // 描边方式 (可以被 OutlineData 全局覆盖)
+
     // 构造函数
     // 传入已经加载好的 Model 指针，而不是路径
     RenderObject(Model* modelPtr, unsigned int texID = 0, unsigned int normalMapID = 0)
@@ -29,11 +36,51 @@ public:
         rotation = glm::vec3(0.0f);
         scale    = glm::vec3(1.0f); // ⚠️ 默认缩放必须是 1，否则看不见！
         uvScale  = glm::vec2(1.0f);
+        castShadow = true;
+        isStatic   = false;
+        outline    = OUTLINE_NONE;
+    }
+
+    // 计算模型矩阵
+    glm::mat4 GetModelMatrix() const {
+        glm::mat4 modelMat = glm::mat4(1.0f);
+        modelMat = glm::translate(modelMat, position);
+        // 欧拉角旋转 (注意顺序: Z -> Y -> X 或 X -> Y -> Z，这里分开写没问题)
+        if(rotation.x != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+        if(rotation.y != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+        if(rotation.z != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+        modelMat = glm::scale(modelMat, scale);
+        return modelMat;
+    }
+
+    // 世界空间包围盒
+    AABB GetWorldBounds() const {
+        return model->bounds.Transformed(GetModelMatrix());
     }
 
     // 【改进 3】Shader 作为参数传入
     // 这样你可以用同一个 Shader 画不同的物体（批处理思想）
     void Draw(Shader& shader) {
+        prepare(shader);
+        model->Draw(shader);
+    }
+
+    // 只画和视锥相交的子网格 (阴影帧用)，结果记到 stats 里
+    void DrawCulled(Shader& shader, const Frustum& frustum, CullStats& stats) {
+        glm::mat4 modelMat = prepare(shader);
+        for (Mesh& mesh : model->meshes) {
+            if (!frustum.Intersects(mesh.bounds.Transformed(modelMat))) {
+                stats.meshesCulled++;
+                continue;
+            }
+            mesh.Draw(shader);
+            stats.meshesSubmitted++;
+        }
+    }
+
+private:
+    // 绑定手动设置的纹理、设置矩阵等 uniform，返回模型矩阵
+    glm::mat4 prepare(Shader& shader) {
         // 1. 如果有手动设置的纹理，先绑定
         shader.use();
         if (textureID != 0) {
@@ -54,20 +101,12 @@ public:
         }
 
         // 2. 计算矩阵
-        glm::mat4 modelMat = glm::mat4(1.0f);
-        modelMat = glm::translate(modelMat, position);
-        // 欧拉角旋转 (注意顺序: Z -> Y -> X 或 X -> Y -> Z，这里分开写没问题)
-        if(rotation.x != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-        if(rotation.y != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-        if(rotation.z != 0) modelMat = glm::rotate(modelMat, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-        modelMat = glm::scale(modelMat, scale);
+        glm::mat4 modelMat = GetModelMatrix();
 
         // 3. 设置 Uniform
         shader.setVec2("uvScale", uvScale);
         shader.setMat4("model", modelMat);
-
-        // 4. 绘制
-        model->Draw(shader);
+        return modelMat;
     }
 };
 
@@ -0,0 +1,202 @@
+#ifndef RENDERTARGETPOOL_H
+#define RENDERTARGETPOOL_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <vector>
+
+#include "resourceTracker.h"
+
+// 一张渲染目标的描述：格式 + 相对于 backbuffer 的缩放 + 采样数
+struct RenderTargetDesc {
+    GLenum internalFormat = GL_RGBA16F;
+    float scale = 1.0f;          // 0.5 = 半分辨率
+    int samples = 1;             // > 1 时分配 GL_TEXTURE_2D_MULTISAMPLE
+    GLenum filter = GL_LINEAR;   // 深度 / 法线之类的用 GL_NEAREST
+
+    RenderTargetDesc() = default;
+    RenderTargetDesc(GLenum internalFormat, float scale = 1.0f, int samples = 1, GLenum filter = GL_LINEAR)
+        : internalFormat(internalFormat), scale(scale), samples(samples), filter(filter) {}
+
+    bool operator==(const RenderTargetDesc& other) const {
+        return internalFormat == other.internalFormat && scale == other.scale
+               && samples == other.samples && filter == other.filter;
+    }
+};
+
+// 池里的一张纹理 (GUI 里列出来)
+struct RenderTargetEntry {
+    RenderTargetDesc desc;
+    unsigned int texture = 0;
+    int width = 0, height = 0;
+    bool inUse = false;          // 本帧已经借出去了
+    int idleFrames = 0;          // 连续多少帧没人用
+};
+
+struct RenderTargetPoolStats {
+    unsigned int allocations = 0;   // 总共创建过多少张纹理
+    unsigned int resizes = 0;       // backbuffer 尺寸变化次数
+    unsigned int evictions = 0;     // 太久没用被释放的纹理数
+};
+
+// ==========================================================
+// 渲染目标池
+// 所有和屏幕尺寸相关的纹理都按描述 (RenderTargetDesc) 从这里拿，尺寸 = backbuffer * scale。
+// 借出去的纹理在下一帧 BeginFrame 时自动还回来；同样的描述按同样的顺序 Acquire，
+// 每帧拿到的就是同一张纹理，不会重新分配。
+// 窗口尺寸变了只记下来，下一帧 BeginFrame 时把旧纹理全部释放，用到时再按新尺寸分配；
+// 连续 EVICT_FRAMES 帧没人用的纹理 (比如切换了泛光模式) 也会被释放。
+// 纹理被释放过 Generation() 就会变，缓存了附件的帧缓冲要重新挂载
+// ==========================================================
+class RenderTargetPool {
+public:
+    RenderTargetPoolStats stats;
+
+    RenderTargetPool(int width, int height) : width(width), height(height), pendingWidth(width), pendingHeight(height) {}
+
+    ~RenderTargetPool() {
+        for (const RenderTargetEntry& entry : entries) release(entry);
+    }
+
+    // 窗口最小化时尺寸是 0，这时保持原来的尺寸
+    void Resize(int newWidth, int newHeight) {
+        if (newWidth <= 0 || newHeight <= 0) return;
+        pendingWidth = newWidth;
+        pendingHeight = newHeight;
+    }
+
+    // 每帧开始时调用：还回上一帧借出的纹理，处理尺寸变化和长时间不用的纹理
+    void BeginFrame() {
+        if (pendingWidth != width || pendingHeight != height) {
+            width = pendingWidth;
+            height = pendingHeight;
+            stats.resizes++;
+            releaseAll();
+            return;
+        }
+        for (size_t i = 0; i < entries.size();) {
+            RenderTargetEntry& entry = entries[i];
+            if (!entry.inUse) entry.idleFrames++;
+            else entry.idleFrames = 0;
+            entry.inUse = false;
+            if (entry.idleFrames > EVICT_FRAMES) {
+                release(entry);
+                entries.erase(entries.begin() + i);
+                stats.evictions++;
+                generation++;
+                continue;
+            }
+            i++;
+        }
+    }
+
+    // 借一张符合描述的纹理，本帧内不会再借给别人
+    unsigned int Acquire(const RenderTargetDesc& desc) {
+        for (RenderTargetEntry& entry : entries) {
+            if (entry.inUse || !(entry.desc == desc)) continue;
+            entry.inUse = true;
+            return entry.texture;
+        }
+        RenderTargetEntry entry;
+        entry.desc = desc;
+        SizeOf(desc, entry.width, entry.height);
+        entry.texture = allocate(desc, entry.width, entry.height);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, entry.texture, EntryBytes(entry), RESOURCE_RENDER_TARGET,
+                                     std::string("render target ") + FormatName(desc.internalFormat));
+        entry.inUse = true;
+        entries.push_back(entry);
+        stats.allocations++;
+        return entry.texture;
+    }
+
+    // 某个描述在当前 backbuffer 下的实际尺寸
+    void SizeOf(const RenderTargetDesc& desc, int& outWidth, int& outHeight) const {
+        outWidth = std::max(1, static_cast<int>(width * desc.scale));
+        outHeight = std::max(1, static_cast<int>(height * desc.scale));
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    unsigned int Generation() const { return generation; }
+    const std::vector<RenderTargetEntry>& Entries() const { return entries; }
+
+    // 池里所有纹理占用的显存 (估算，不含驱动的对齐和压缩)
+    size_t MemoryBytes() const {
+        size_t total = 0;
+        for (const RenderTargetEntry& entry : entries) total += EntryBytes(entry);
+        return total;
+    }
+
+    static size_t EntryBytes(const RenderTargetEntry& entry) {
+        return static_cast<size_t>(entry.width) * entry.height * entry.desc.samples * BytesPerPixel(entry.desc.internalFormat);
+    }
+
+    static size_t BytesPerPixel(GLenum format) {
+        switch (format) {
+            case GL_RGBA32F: return 16;
+            case GL_RGBA16F: return 8;
+            case GL_RG16F: return 4;
+            case GL_R16F: return 2;
+            case GL_R8: return 1;
+            default: return 4; // RGBA8, R32F, R11F_G11F_B10F, DEPTH24_STENCIL8, DEPTH_COMPONENT24 ...
+        }
+    }
+
+    static const char* FormatName(GLenum format) {
+        switch (format) {
+            case GL_RGBA32F: return "RGBA32F";
+            case GL_RGBA16F: return "RGBA16F";
+            case GL_RGBA8: return "RGBA8";
+            case GL_RG16F: return "RG16F";
+            case GL_R16F: return "R16F";
+            case GL_R32F: return "R32F";
+            case GL_R8: return "R8";
+            case GL_R11F_G11F_B10F: return "R11G11B10F";
+            case GL_DEPTH24_STENCIL8: return "D24S8";
+            case GL_DEPTH_COMPONENT24: return "D24";
+            case GL_DEPTH_COMPONENT32F: return "D32F";
+            default: return "?";
+        }
+    }
+
+private:
+    static const int EVICT_FRAMES = 120;
+
+    int width, height;
+    int pendingWidth, pendingHeight;
+    unsigned int generation = 0;
+    std::vector<RenderTargetEntry> entries;
+
+    void releaseAll() {
+        for (const RenderTargetEntry& entry : entries) release(entry);
+        entries.clear();
+        generation++;
+    }
+
+    static void release(const RenderTargetEntry& entry) {
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, entry.texture);
+        glDeleteTextures(1, &entry.texture);
+    }
+
+    // 不可变存储 (glTexStorage2D)：计算着色器的 image 绑定也能直接用
+    static unsigned int allocate(const RenderTargetDesc& desc, int w, int h) {
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        if (desc.samples > 1) {
+            glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, texture);
+            glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, desc.samples, desc.internalFormat, w, h, GL_TRUE);
+            glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+        } else {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexStorage2D(GL_TEXTURE_2D, 1, desc.internalFormat, w, h);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+            // 防止模糊 / 升采样时边缘漏色
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        return texture;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,723 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shader.h"
+#include "camera.h"
+#include "model.h"
+#include "screenQuad.h"
+#include "skybox.h"
+#include "UBO.h"
+#include "pointLightData.h"
+#include "renderObject.h"
+#include "texture.h"
+#include "pointShadowAtlas.h"
+#include "outlineData.h"
+#include "gpuTimer.h"
+#include "bloomRenderer.h"
+#include "dynamicResolution.h"
+#include "renderTargetPool.h"
+#include "autoExposure.h"
+#include "postProcessor.h"
+#include "postProcessingData.h"
+#include "profiler.h"
+#include "glStats.h"
+#include "glCapture.h"
+#include "sceneGenerator.h"
+#include "commandBuffer.h"
+#include "jobSystem.h"
+#include "modelStreamer.h"
+
+// 和着色器里的 LightBlock (std140) 一致：光源数组后面跟着实际的光源数
+struct LightBlockData {
+    PointLightData pointLights[MAX_POINT_LIGHTS];
+    int lightCount;
+    int padding[3];
+};
+
+// 一帧里按顺序执行的几大块 pass，基准测试按这个分别统计
+enum RenderPass {
+    PASS_SHADOWS,        // 点光源阴影图集
+    PASS_SCENE,          // 描边 + toon + pbr + 天空盒 + 光源 + 地板
+    PASS_SCREEN_OUTLINE, // 屏幕空间描边
+    PASS_UPSCALE,        // 动态分辨率放大
+    PASS_AUTO_EXPOSURE,
+    PASS_BLOOM,
+    PASS_POST,           // 最终合成
+    PASS_COUNT
+};
+
+inline const char* RenderPassName(int pass) {
+    static const char* names[PASS_COUNT] = {
+        "shadows", "scene", "screen_outline", "upscale", "auto_exposure", "bloom", "post"
+    };
+    return pass >= 0 && pass < PASS_COUNT ? names[pass] : "?";
+}
+
+// ==========================================================
+// 整个场景的渲染：资源加载 + 每帧从阴影到后处理的全部 pass
+// 不依赖窗口：结果画到 outputFBO (默认帧缓冲或者无窗口模式下自己建的 FBO)，
+// 输入 (摄像机、光源、各种设置) 由外面改好再调用 RenderFrame。
+// 构造前必须已经有当前的 GL 4.5 上下文，工作目录是 LearnOpenGL (相对路径加载资源)
+// ==========================================================
+class Renderer {
+public:
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+    static const unsigned int SHADOW_ATLAS_SIZE = 4096; // 点光源阴影图集分辨率，所有光源的 6 个面都在里面
+    static const int OUTLINE_COMPARE_FRAMES = 120;      // A/B 对比时每种描边连续跑多少帧再切换
+
+    // 外面 (GUI / 输入 / 脚本) 直接改这些
+    PostProcessingData postProcessingData;
+    PointLightData lightData = {
+        glm::vec4(-2.0f, 5.0f, -1.0f, 0.0f), // position
+        glm::vec4(0.3f, 0.3f, 0.3f, 0.0f), // ambient
+        glm::vec4(glm::vec3(1.2f), 0.0f), // diffuse
+        glm::vec4(glm::vec3(2.0f), 0.0f), // specular
+        1.0f, 0.09f, 0.032f, 0.0f          // constant, linear, quadratic, padding
+    };
+    OutlineData outlineData;
+    // 场景 pass 的物体先在工作线程上并行录成 draw 包 (commandBuffer.h)，GL 线程只负责解码提交
+    CommandRecordingSettings recording;
+    // 场景运行中加载模型 (modelStreamer.h)，变成 resident 后在 RenderFrame 开头放进场景，排在角色后面一排
+    ModelStreamer streamer;
+    // 每帧的统计 (给 GUI 看)
+    OutlineTimings outlineTimings;
+    SceneBandwidthStats bandwidthStats;
+    CommandRecordingStats recordingStats;
+    // 每块 pass 和整帧的 GPU 时间 (毫秒)，来自 profiler，结果晚几帧到，要准确对应某一帧见 CollectTimings
+    float passMs[PASS_COUNT] = {};
+    float frameMs = 0.0f;
+
+    Renderer(int width, int height) : renderTargets(width, height), bloom(renderTargets),
+                                      dynamicResolution(width, height), postProcessor(renderTargets) {
+        // 编译时打开了 ENTRO_GL_STATS 才有用，否则是空函数
+        GlStats::Get().Install();
+        postProcessingData.exposure = 0.7f;
+        postProcessingData.amount = 10;
+        postProcessingData.gamma = 2.2f;
+        postProcessingData.bloomStrength = 0.4f;
+
+        reflectionShader.use();
+        reflectionShader.setInt("skybox", 0); // 天空盒通常绑在 0 号纹理位
+        skyboxShader.use();
+        skyboxShader.setInt("skybox", 0);
+
+        floor.scale = glm::vec3(10.0f, 1.0f, 10.0f);
+        floor.uvScale = glm::vec2(20.0f);
+        tianyi.scale = glm::vec3(0.2f);
+        light.position = lightData.position;
+        YYB.scale = glm::vec3(0.2f);
+        YYB.position = glm::vec3(3.0f, 0.0f, 0.0f);
+        sphere.position = glm::vec3(-3.0f, 1.0f, 0.0f);
+        sphere.scale = glm::vec3(1.0f);
+        // 地板和球不会动，阴影只需要画一次，之后走缓存
+        floor.isStatic = true;
+        sphere.isStatic = true;
+        // 两个角色默认用外扩描边，可以在 GUI 里整体切换成屏幕空间描边
+        tianyi.outline = OUTLINE_HULL;
+        YYB.outline = OUTLINE_HULL;
+        UseDefaultScene();
+
+        // 场景帧缓冲：HDR 颜色 + 法线 / 遮罩 + 深度模板纹理，附件在纹理重新分配后再挂
+        // 屏幕空间描边直接画回场景颜色 (只挂 colorBuffer，不挂深度，这样才能同时采样场景深度)
+        glGenFramebuffers(1, &framebuffer);
+        glGenFramebuffers(1, &outlineFBO);
+        glGenFramebuffers(1, &upscaleFBO);
+
+        // 开启混合
+        glEnable(GL_BLEND);
+        // 设置混合方程式：SrcAlpha * SrcColor + (1 - SrcAlpha) * DestColor
+        // 翻译：新颜色的浓度取决于它的透明度，剩下的浓度留给背景色
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    ~Renderer() {
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteFramebuffers(1, &outlineFBO);
+        glDeleteFramebuffers(1, &upscaleFBO);
+    }
+
+    // 换成按种子生成的压力测试场景 (见 sceneGenerator.h)，光源也用生成的，lightData 不再起作用
+    void GenerateScene(const SceneGeneratorSettings& settings) {
+        SceneModels models;
+        models.cube = &cubeModel;
+        models.sphere = &sphereModel;
+        models.floor = &floorModel;
+        models.characters = { &ourModel, &YYBModel };
+        generatedScene = std::make_unique<GeneratedScene>(settings, models);
+        std::vector<RenderObject>& objects = generatedScene->objects;
+        groundObjects = { &objects[0] };
+        // 角色走 toon (只用 0 号光源)，方块和球走 pbr，pbr 对 lightCount 个光源逐个累加
+        toonObjects.clear();
+        pbrObjects.clear();
+        for (size_t i = 1; i < objects.size(); i++) {
+            bool character = std::find(models.characters.begin(), models.characters.end(), objects[i].model) != models.characters.end();
+            (character ? toonObjects : pbrObjects).push_back(&objects[i]);
+        }
+        sceneObjects.clear();
+        for (RenderObject& object : objects) sceneObjects.push_back(&object);
+        addStreamedObjects();
+        pointShadows.Invalidate();
+    }
+
+    // 回到默认的演示场景：两个角色 + 球 + 地板 + 4 个光源
+    void UseDefaultScene() {
+        generatedScene.reset();
+        toonObjects = { &tianyi, &YYB };
+        pbrObjects = { &sphere };
+        groundObjects = { &floor };
+        // 场景里的所有物体都交给阴影帧，由光源视锥决定谁真的要画
+        sceneObjects = { &tianyi, &YYB, &sphere, &floor };
+        addStreamedObjects();
+        pointShadows.Invalidate();
+    }
+
+    const GeneratedScene* Scene() const { return generatedScene.get(); }
+
+    // 录制用的任务系统，默认是全局的那个 (基准测试换成指定线程数的)，必须活得比 Renderer 长
+    void SetJobSystem(JobSystem& jobSystem) { jobs = &jobSystem; }
+
+    // 流式加载用的上传线程 (uploadService.h)，nullptr 时在渲染线程上同步加载。必须活得比发出去的请求长
+    void SetUploadService(UploadService* service) { streamer.SetUploadService(service); }
+
+    // 输出尺寸变了 (窗口缩放)，渲染目标在下一帧开始时重新分配
+    void Resize(int width, int height) { renderTargets.Resize(width, height); }
+    int Width() const { return renderTargets.Width(); }
+    int Height() const { return renderTargets.Height(); }
+
+    // 画一帧到 outputFBO (backbuffer 大小，整屏覆盖写，不需要先清)
+    void RenderFrame(Camera& camera, float deltaTime, unsigned int outputFBO = 0) {
+        // 录制时在这里分帧 (上一帧 RenderFrame 之后的调用，比如读回，算在上一帧里)
+        GlCapture::Get().BeginFrame();
+        glEnable(GL_DEPTH_TEST);
+        frameTimer.Begin();
+        profiler.BeginFrame();
+        GlStats::Get().BeginFrame();
+        // 上一帧之后传完的模型 (同步加载时就是在这里整个加载)
+        for (const std::shared_ptr<StreamedModel>& streamed : streamer.Poll()) addStreamed(streamed);
+        // 还回上一帧借的渲染目标，窗口尺寸变了就在这里生效
+        renderTargets.BeginFrame();
+        int screenWidth = renderTargets.Width();
+        int screenHeight = renderTargets.Height();
+        dynamicResolution.Resize(screenWidth, screenHeight);
+        unsigned int colorBuffer = renderTargets.Acquire(sceneColorDesc);
+        unsigned int normalMaskBuffer = renderTargets.Acquire(normalMaskDesc);
+        unsigned int sceneDepthTexture = renderTargets.Acquire(sceneDepthDesc);
+        if (!sceneTargetsAttached || sceneTargetsGeneration != renderTargets.Generation()) {
+            attachSceneTargets(colorBuffer, normalMaskBuffer, sceneDepthTexture);
+            sceneTargetsGeneration = renderTargets.Generation();
+            sceneTargetsAttached = true;
+        }
+        // 本帧的渲染分辨率 (由上几帧的 GPU 时间决定)
+        int renderWidth = dynamicResolution.RenderWidth();
+        int renderHeight = dynamicResolution.RenderHeight();
+
+        // 设置 View/Projection 矩阵
+        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)screenWidth / (float)screenHeight, NEAR_PLANE, FAR_PLANE);
+        glm::mat4 view = camera.GetViewMatrix();
+
+        // 配置UBO
+        matricesUBO.SetMat4(0, projection);
+        matricesUBO.SetMat4(sizeof(glm::mat4), view);
+
+        int lightCount = 4;
+        if (generatedScene) {
+            lightCount = std::min(static_cast<int>(generatedScene->lights.size()), MAX_POINT_LIGHTS);
+            std::copy(generatedScene->lights.begin(), generatedScene->lights.begin() + lightCount, allLightsData.pointLights);
+        } else {
+            allLightsData.pointLights[0] = lightData;
+
+            // 填充后 3 个光源 (固定位置光源)
+            for(int i = 1; i < 4; i++)
+            {
+                allLightsData.pointLights[i].position  = glm::vec4(lightPoses[i], 0.0f);
+                allLightsData.pointLights[i].ambient   = glm::vec4(lightColors[i] * 0.1f, 0.0f);
+                allLightsData.pointLights[i].diffuse   = glm::vec4(lightColors[i], 0.0f);
+                allLightsData.pointLights[i].specular  = glm::vec4(lightColors[i], 0.0f);
+                allLightsData.pointLights[i].constant  = 1.0f;
+                allLightsData.pointLights[i].linear    = 0.09f;
+                allLightsData.pointLights[i].quadratic = 0.032f;
+                allLightsData.pointLights[i].padding  = 0.0f;
+            }
+        }
+        allLightsData.lightCount = lightCount;
+        // 只上传用到的光源和光源数，不用每帧传整个 10 KB 的块
+        lightUBO.SetData(0, lightCount * sizeof(PointLightData), allLightsData.pointLights);
+        lightUBO.SetData(offsetof(LightBlockData, lightCount), sizeof(int), &allLightsData.lightCount);
+
+        // ==============================================
+        // 描边方式：A/B 对比模式下两种方法轮流跑，各自累计平均耗时
+        // ==============================================
+        if (outlineData.compare) {
+            if (!outlineCompareLast) {
+                outlineCompareFrame = 0;
+                hullTimer.ResetAverage();
+                toonHullTimer.ResetAverage();
+                screenOutlineTimer.ResetAverage();
+                toonScreenTimer.ResetAverage();
+            }
+            outlineData.overrideMode = (outlineCompareFrame / OUTLINE_COMPARE_FRAMES) % 2 == 0
+                                       ? OUTLINE_ALL_HULL : OUTLINE_ALL_SCREEN_SPACE;
+            outlineCompareFrame++;
+        }
+        outlineCompareLast = outlineData.compare;
+
+        std::vector<RenderObject*> hullObjects;
+        std::vector<RenderObject*> screenOutlineObjects;
+        std::vector<RenderObject*> plainToonObjects;
+        for (RenderObject* obj : toonObjects) {
+            OutlineMode mode = outlineData.Resolve(obj->outline);
+            if (mode == OUTLINE_HULL) hullObjects.push_back(obj);
+            else if (mode == OUTLINE_SCREEN_SPACE) screenOutlineObjects.push_back(obj);
+            else plainToonObjects.push_back(obj);
+        }
+        // 计时归到哪一种模式：有屏幕空间描边的物体就算屏幕空间，否则算外扩
+        bool screenOutlineFrame = !screenOutlineObjects.empty();
+
+        // ==============================================
+        // 开始录制场景 pass 的 draw 包：工作线程录制的同时，GL 线程去画阴影图集
+        // ==============================================
+        JobCounter recorded;
+        recordingStats = CommandRecordingStats();
+        if (recording.enabled) {
+            const std::vector<RenderObject*>* lists[SCENE_LIST_COUNT] = {
+                &hullObjects, &plainToonObjects, &screenOutlineObjects, &pbrObjects, &groundObjects
+            };
+            for (int i = 0; i < SCENE_LIST_COUNT; i++) {
+                recordingStats.jobs += RecordCommandsAsync(*jobs, *lists[i], sceneCommands[i], recording.grain, recorded);
+                recordingStats.packets += static_cast<unsigned int>(sceneCommands[i].Size());
+            }
+        }
+
+        // ====================================================
+        // 阴影帧
+        // ====================================================
+        // 步骤 1: 渲染点光源阴影图集 (Shadow Map Pass)
+        // 4 个点光源各有 6 个面，按屏幕影响力分配分辨率，每帧只重画预算内的面；
+        // 静态物体 (地板) 只在光源或它自己动了的时候重画，动态物体每次刷新时叠加上去
+
+        // 【重要】MMD 模型通常有很多单面网格。为了防止背面产生错误阴影（Peter Panning），
+        // 渲染阴影贴图时，我们通常剔除正面 (只画背面)，或者不剔除。
+        // 对于 Toon Shading，先试试不剔除
+        glDisable(GL_CULL_FACE);
+        int shadowsScope = beginPass(PASS_SHADOWS);
+        pointShadows.Update(allLightsData.pointLights, lightCount, camera.Position, projection * view, camera.Zoom,
+                            pointShadowDepthShader, sceneObjects);
+        endPass(shadowsScope);
+
+        // ==============================================
+        // 第 1 遍 (Pass 1): 渲染描边
+        // ==============================================
+        int sceneScope = beginPass(PASS_SCENE);
+        if (recording.enabled) {
+            auto waitStart = std::chrono::steady_clock::now();
+            jobs->Wait(recorded);
+            recordingStats.waitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glViewport(0, 0, renderWidth, renderHeight);
+        // 清屏：颜色附件分别清，法线 / 遮罩附件清成 0 (没有物体需要描边)
+        const float sceneClearColor[4] = { 0.05f, 0.05f, 0.05f, 1.0f };
+        const float maskClearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        glDrawBuffers(2, maskedAttachments);
+        glClearBufferfv(GL_COLOR, 0, sceneClearColor);
+        glClearBufferfv(GL_COLOR, 1, maskClearColor);
+        glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        glDrawBuffers(2, sceneAttachments);
+        sceneFragments.Begin();
+
+        if (!hullObjects.empty()) {
+            ProfileScope scope(profiler, "outline_hull");
+            hullTimer.Begin();
+            outlineShader.use();
+            outlineShader.setFloat("outlineWidth", outlineData.hullWidth);
+            outlineShader.setVec3("color", outlineData.color);
+            glEnable(GL_CULL_FACE);
+            glCullFace(GL_FRONT);
+            drawList(SCENE_LIST_HULL, hullObjects, outlineShader);
+            hullTimer.End();
+        }
+
+        // ==============================================
+        // 第 2 遍 (Pass 2): 正常渲染 Toon 模型
+        // ==============================================
+        GpuTimer& toonTimer = screenOutlineFrame ? toonScreenTimer : toonHullTimer;
+        int toonScope = profiler.BeginScope("toon");
+        toonTimer.Begin();
+        shader.use();
+        glDisable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+        shader.setFloat("material.shininess", 256.0f);
+        // 3. 绑定阴影图集 (toon 和 pbr 都从 10 号纹理位读)
+        glActiveTexture(GL_TEXTURE10);
+        glBindTexture(GL_TEXTURE_2D, pointShadows.DepthMap());
+        // 外扩描边的物体录一次，描边和 toon 各提交一遍
+        drawList(SCENE_LIST_HULL, hullObjects, shader);
+        drawList(SCENE_LIST_PLAIN_TOON, plainToonObjects, shader);
+        // 屏幕空间描边的物体额外写出法线和遮罩
+        if (screenOutlineFrame) {
+            glDrawBuffers(2, maskedAttachments);
+            drawList(SCENE_LIST_SCREEN_OUTLINE, screenOutlineObjects, shader);
+            glDrawBuffers(2, sceneAttachments);
+        }
+        toonTimer.End();
+        profiler.EndScope(toonScope);
+
+        // ------------------------------------------------
+        // pbr
+        // ------------------------------------------------
+        int pbrScope = profiler.BeginScope("pbr");
+        if (!pbrObjects.empty()) {
+            pbrShader.use();
+            pbrShader.setVec3("viewPos", camera.Position);
+
+            // --- 1. Albedo (Diffsue) ---
+            rustedIronBaseTex.bind(0);
+            pbrShader.setInt("material.texture_diffuse1", 0);
+            // --- 2. Normal ---
+            rustedIronNormalTex.bind(1);
+            pbrShader.setInt("material.texture_normal1", 1);
+            pbrShader.setBool("useNormalMap", true);
+            // --- 3. Metallic ---
+            rustedIronMetalTex.bind(2);
+            pbrShader.setInt("metallicMap", 2);
+            // --- 4. Roughness ---
+            rustedIronRoughTex.bind(3);
+            pbrShader.setInt("roughnessMap", 3);
+            // --- 5. AO (Ambient Occlusion) ---
+            // 使用白色纹理代替 AO，防止模型变黑
+            whiteTex.bind(4);
+            pbrShader.setInt("aoMap", 4);
+            // 4. 设置纹理缩放
+            // 假设球体比较小，不需要像地板那样重复纹理，设为 1.0
+            pbrShader.setVec2("uvScale", glm::vec2(1.0f));
+
+            drawList(SCENE_LIST_PBR, pbrObjects, pbrShader);
+        }
+        profiler.EndScope(pbrScope);
+
+        // ==============================================
+        // 天空盒  光源  地板
+        // ==============================================
+        {
+            ProfileScope scope(profiler, "skybox");
+            skybox.Draw(skyboxShader, view, projection);
+        }
+        {
+            ProfileScope scope(profiler, "light_cubes");
+            light.position = lightData.position;
+            lightCubeShader.use();
+            for(int i = 0; i < lightCount; i++) {
+                const PointLightData& pointLight = allLightsData.pointLights[i];
+                light.position = pointLight.position; // 隐式转换 vec4 -> vec3 (取前3个分量)
+                lightCubeShader.setVec3("color", glm::vec3(pointLight.diffuse));
+                light.Draw(lightCubeShader);
+            }
+        }
+        {
+            ProfileScope scope(profiler, "floor");
+            drawList(SCENE_LIST_GROUND, groundObjects, shader);
+        }
+        sceneFragments.End();
+        endPass(sceneScope);
+        // 以前每个片元还要多写一份 RGBA16F 高亮，每帧还要多清一张全屏 RGBA16F
+        bandwidthStats.fragments = sceneFragments.Last();
+        bandwidthStats.savedBytes = static_cast<double>(bandwidthStats.fragments) * 8.0
+                                    + static_cast<double>(screenWidth) * screenHeight * 8.0;
+        bandwidthStats.savedMemory = static_cast<double>(screenWidth) * screenHeight * 8.0;
+
+        // ==============================================
+        // 屏幕空间描边：在场景深度 / 法线不连续的地方画线，直接叠加到场景颜色上
+        // ==============================================
+        // 没跑的 pass 也照样打时间戳，记成 0 左右，统计的时候每帧都有值
+        int screenOutlineScope = beginPass(PASS_SCREEN_OUTLINE);
+        if (screenOutlineFrame) {
+            screenOutlineTimer.Begin();
+            glBindFramebuffer(GL_FRAMEBUFFER, outlineFBO);
+            glDisable(GL_DEPTH_TEST);
+            ssOutlineShader.use();
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, sceneDepthTexture);
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, normalMaskBuffer);
+            ssOutlineShader.setInt("depthTexture", 0);
+            ssOutlineShader.setInt("normalMask", 1);
+            ssOutlineShader.setVec3("color", outlineData.color);
+            ssOutlineShader.setFloat("thickness", outlineData.thickness);
+            ssOutlineShader.setFloat("depthThreshold", outlineData.depthThreshold);
+            ssOutlineShader.setFloat("normalThreshold", outlineData.normalThreshold);
+            ssOutlineShader.setFloat("nearPlane", NEAR_PLANE);
+            ssOutlineShader.setFloat("farPlane", FAR_PLANE);
+            ssOutlineShader.setIVec2("renderSize", renderWidth, renderHeight);
+            screenQuad.Draw();
+            glActiveTexture(GL_TEXTURE0);
+            glEnable(GL_DEPTH_TEST);
+            screenOutlineTimer.End();
+        }
+        endPass(screenOutlineScope);
+        outlineTimings.hullPass = hullTimer.Average();
+        outlineTimings.toonWithHull = toonHullTimer.Average();
+        outlineTimings.screenPass = screenOutlineTimer.Average();
+        outlineTimings.toonWithScreen = toonScreenTimer.Average();
+
+        // ==============================================
+        // 后处理
+        // ==============================================
+        // 动态分辨率：子区域放大回全分辨率 (同时做对比度自适应锐化)，之后的后处理都在全分辨率上
+        unsigned int sceneTexture = colorBuffer;
+        int upscaleScope = beginPass(PASS_UPSCALE);
+        if (!dynamicResolution.IsFullResolution()) {
+            unsigned int upscaledBuffer = renderTargets.Acquire(sceneColorDesc);
+            glBindFramebuffer(GL_FRAMEBUFFER, upscaleFBO);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, upscaledBuffer, 0);
+            glViewport(0, 0, screenWidth, screenHeight);
+            glDisable(GL_DEPTH_TEST);
+            glDisable(GL_BLEND);
+            upscaleShader.use();
+            upscaleShader.setInt("scene", 0);
+            upscaleShader.setVec2("renderSize", glm::vec2(renderWidth, renderHeight));
+            upscaleShader.setFloat("sharpness", dynamicResolution.settings.sharpness);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, colorBuffer);
+            screenQuad.Draw();
+            glEnable(GL_BLEND);
+            glEnable(GL_DEPTH_TEST);
+            sceneTexture = upscaledBuffer;
+        }
+        endPass(upscaleScope);
+
+        int exposureScope = beginPass(PASS_AUTO_EXPOSURE);
+        if (postProcessingData.autoExposure)
+            autoExposure.Compute(sceneTexture, screenWidth, screenHeight, deltaTime, postProcessingData);
+        endPass(exposureScope);
+
+        // 泛光：直接从 HDR 场景颜色提取高亮并模糊
+        int bloomScope = beginPass(PASS_BLOOM);
+        unsigned int bloomTexture = bloom.Render(sceneTexture, screenQuad, postProcessingData);
+        endPass(bloomScope);
+        int postScope = beginPass(PASS_POST);
+        postProcessor.Render(sceneTexture, bloomTexture, autoExposure.ExposureTexture(), screenQuad, postProcessingData, outputFBO);
+        endPass(postScope);
+        frameTimer.End();
+        if (frameTimer.ConsumeFresh())
+            dynamicResolution.Update(frameTimer.Milliseconds());
+        profiler.EndFrame();
+        GlStats::Get().EndFrame();
+        updatePassTimings();
+    }
+
+    // 等 GPU 做完 (glFinish) 之后调用，passMs / frameMs 就是刚画完这一帧的，不再晚几帧
+    void CollectTimings() {
+        frameTimer.Collect();
+        profiler.Flush();
+        updatePassTimings();
+    }
+
+    // 下面这些给 GUI 用
+    RenderTargetPool renderTargets;
+    BloomRenderer bloom;
+    DynamicResolution dynamicResolution;
+    AutoExposure autoExposure;
+    PostProcessor postProcessor;
+    PointShadowAtlas pointShadows{SHADOW_ATLAS_SIZE};
+    // 每块 pass 的 CPU / GPU 分段计时 (GUI 时间线 + Chrome trace)
+    Profiler profiler;
+
+private:
+    // ---  资源加载 ---
+    Texture wallTex{"textures/wall.jpg"};
+    Texture brickWallTex{"textures/brickwall.jpg"};
+    Texture brickWallNormalTex{"textures/brickwall_normal.jpg"};
+    Texture whiteTex{"textures/white.png"};
+    Texture rustedIronBaseTex{"textures/rustediron1-alt2-bl/rustediron2_basecolor.png"};
+    Texture rustedIronNormalTex{"textures/rustediron1-alt2-bl/rustediron2_normal.png"};
+    Texture rustedIronMetalTex{"textures/rustediron1-alt2-bl/rustediron2_metallic.png"};
+    Texture rustedIronRoughTex{"textures/rustediron1-alt2-bl/rustediron2_roughness.png"};
+
+    Shader shader{"shaders/shader.vert", "shaders/toon_shader.frag"};
+    Shader pbrShader{"shaders/shader.vert", "shaders/pbr_shader.frag"};
+    Shader outlineShader{"shaders/outline.vert", "shaders/outline.frag"};
+    Shader lightCubeShader{"shaders/light_cube.vert", "shaders/light_cube.frag"};
+    Shader skyboxShader{"shaders/skybox.vert", "shaders/skybox.frag"};
+    Shader pointShadowDepthShader{"shaders/pointShadowDepth.vert", "shaders/pointShadowDepth.frag"};
+    Shader ssOutlineShader{"shaders/screen.vert", "shaders/ssOutline.frag"};
+    Shader upscaleShader{"shaders/screen.vert", "shaders/upscale.frag"};
+    Shader reflectionShader{"shaders/reflection.vert", "shaders/reflection.frag"};
+    //天空盒
+    Skybox skybox{std::vector<std::string>{
+        "textures/skybox/right.jpg",
+        "textures/skybox/left.jpg",
+        "textures/skybox/top.jpg",
+        "textures/skybox/bottom.jpg",
+        "textures/skybox/front.jpg",
+        "textures/skybox/back.jpg"
+    }};
+    ScreenQuad screenQuad;
+
+    // 加载模型
+    Model ourModel{"objects/TDA/TDA.pmx"};
+    Model YYBModel{"objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx"};
+    Model cubeModel{"objects/cube.obj"};
+    Model sphereModel{"objects/sphere.obj"};
+    Model floorModel{"objects/floor.obj"};
+    RenderObject tianyi{&ourModel};
+    RenderObject YYB{&YYBModel};
+    RenderObject light{&cubeModel};
+    RenderObject sphere{&sphereModel};
+    RenderObject floor{&floorModel, brickWallTex.ID, brickWallNormalTex.ID};
+    // 当前场景按着色器分好的物体 (默认场景或者生成的场景)
+    std::vector<RenderObject*> toonObjects;
+    std::vector<RenderObject*> pbrObjects;
+    std::vector<RenderObject*> groundObjects;
+    std::vector<RenderObject*> sceneObjects;
+    std::unique_ptr<GeneratedScene> generatedScene;
+    // 流式加载进来的模型，deque 保证加新的时旧物体的地址不变
+    std::vector<std::shared_ptr<StreamedModel>> streamedModels;
+    std::deque<RenderObject> streamedObjects;
+    LightBlockData allLightsData{};
+
+    glm::vec3 lightPoses[4] = {
+        glm::vec3( 0.7f,  0.2f,  2.0f),
+        glm::vec3( 2.3f, -3.3f, -4.0f),
+        glm::vec3(-4.0f,  2.0f, -12.0f),
+        glm::vec3( 0.0f,  0.0f, -3.0f)
+    };
+    glm::vec3 lightColors[4] = {
+        glm::vec3(1.0f, 1.0f, 1.0f), // 白
+        glm::vec3(1.0f, 0.0f, 0.0f), // 红
+        glm::vec3(0.0f, 1.0f, 0.0f), // 绿
+        glm::vec3(0.0f, 0.0f, 1.0f)  // 蓝
+    };
+
+    UBO matricesUBO{2 * sizeof(glm::mat4), 0};
+    UBO lightUBO{sizeof(LightBlockData), 1};
+
+    // 场景帧缓冲 (纹理从 renderTargets 借)
+    const RenderTargetDesc sceneColorDesc{GL_RGBA16F};
+    const RenderTargetDesc normalMaskDesc{GL_RGBA8, 1.0f, 1, GL_NEAREST};
+    const RenderTargetDesc sceneDepthDesc{GL_DEPTH24_STENCIL8, 1.0f, 1, GL_NEAREST};
+    unsigned int framebuffer = 0, outlineFBO = 0, upscaleFBO = 0;
+    unsigned int sceneTargetsGeneration = 0;
+    bool sceneTargetsAttached = false;
+    // 场景帧缓冲默认只写颜色，画屏幕空间描边的物体时才打开法线 / 遮罩附件
+    const unsigned int sceneAttachments[2] = { GL_COLOR_ATTACHMENT0, GL_NONE };
+    const unsigned int maskedAttachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+
+    // 统计场景帧写了多少片元，用来估算去掉高亮附件省下的带宽
+    GpuQuery sceneFragments{GL_SAMPLES_PASSED};
+    // 描边耗时 (每种模式下各自计时，互不干扰)
+    GpuTimer hullTimer, toonHullTimer, screenOutlineTimer, toonScreenTimer;
+    int outlineCompareFrame = 0;
+    bool outlineCompareLast = false;
+    GpuFrameTimer frameTimer;
+
+    // 场景 pass 的几组物体，每组一个命令列表
+    enum SceneList {
+        SCENE_LIST_HULL,            // 外扩描边 (描边 + toon 各画一遍)
+        SCENE_LIST_PLAIN_TOON,
+        SCENE_LIST_SCREEN_OUTLINE,  // 屏幕空间描边 (额外写法线 / 遮罩)
+        SCENE_LIST_PBR,
+        SCENE_LIST_GROUND,
+        SCENE_LIST_COUNT
+    };
+    CommandBuffer sceneCommands[SCENE_LIST_COUNT];
+    GlCommandExecutor commandExecutor;
+    JobSystem* jobs = &JobSystem::Get();
+
+    // 画一组物体：录制打开时提交录好的包，否则逐个直接画。着色器由调用方 use
+    void drawList(SceneList list, const std::vector<RenderObject*>& objects, Shader& listShader) {
+        if (!recording.enabled) {
+            for (RenderObject* obj : objects) obj->Draw(listShader);
+            return;
+        }
+        auto submitStart = std::chrono::steady_clock::now();
+        commandExecutor.Submit(sceneCommands[list], listShader);
+        recordingStats.submitMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - submitStart).count();
+    }
+
+    // 新 resident 的模型：在默认场景两个角色后面排一排，和角色一样用 toon + 外扩描边
+    void addStreamed(const std::shared_ptr<StreamedModel>& streamed) {
+        streamedModels.push_back(streamed);
+        streamedObjects.emplace_back(streamed->model.get());
+        RenderObject& object = streamedObjects.back();
+        object.scale = glm::vec3(0.2f);
+        object.position = glm::vec3(-3.0f + 3.0f * static_cast<float>(streamedObjects.size() - 1), 0.0f, -3.0f);
+        object.outline = OUTLINE_HULL;
+        toonObjects.push_back(&object);
+        sceneObjects.push_back(&object);
+    }
+
+    // 换场景时流式加载进来的模型留在场景里
+    void addStreamedObjects() {
+        for (RenderObject& object : streamedObjects) {
+            toonObjects.push_back(&object);
+            sceneObjects.push_back(&object);
+        }
+    }
+
+    // 一块 pass 的开始 / 结束：profiler 计时 + GL 调用统计记到这个 pass
+    int beginPass(RenderPass pass) {
+        GlStats::Get().SetPass(pass, RenderPassName(pass));
+        return profiler.BeginScope(RenderPassName(pass));
+    }
+
+    void endPass(int scope) {
+        profiler.EndScope(scope);
+        GlStats::Get().SetPass(-1, nullptr);
+    }
+
+    // 从 profiler 最近一帧的最外层范围里取出各块 pass 的 GPU 时间
+    void updatePassTimings() {
+        const ProfileFrame& frame = profiler.LastFrame();
+        for (int i = 0; i < PASS_COUNT; i++) passMs[i] = 0.0f;
+        for (const ProfileEvent& event : frame.events) {
+            if (event.depth != 0) continue;
+            for (int i = 0; i < PASS_COUNT; i++)
+                if (std::strcmp(event.name, RenderPassName(i)) == 0)
+                    passMs[i] += static_cast<float>(event.gpuEnd - event.gpuStart);
+        }
+        frameMs = frameTimer.Milliseconds();
+    }
+
+    // 场景帧缓冲：一个 HDR 颜色附件 + 法线 / 遮罩 + 深度模板纹理
+    // 高亮不再单独输出，泛光直接从 colorBuffer 里提取
+    // 纹理由 RenderTargetPool 分配，这里只负责挂载 (第一帧和纹理重新分配之后调用)
+    void attachSceneTargets(unsigned int colorBuffer, unsigned int normalMaskBuffer, unsigned int depthTexture) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        // 颜色必须是 GL_RGBA16F 浮点格式
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorBuffer, 0);
+        // 法线 / 遮罩 (屏幕空间描边用)：rgb = 法线, a = 需要描边，8 位就够了
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalMaskBuffer, 0);
+        // 深度缓冲：屏幕空间描边要采样深度，所以用纹理而不是 RBO
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+
+        // 默认只写颜色，法线 / 遮罩按需打开
+        glDrawBuffers(2, sceneAttachments);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, outlineFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorBuffer, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::FRAMEBUFFER:: Outline framebuffer is not complete!" << std::endl;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,241 @@
+#ifndef RESOURCETRACKER_H
+#define RESOURCETRACKER_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum ResourceCategory {
+    RESOURCE_TEXTURE,        // 模型 / 材质贴图
+    RESOURCE_MESH,           // 顶点 / 索引缓冲
+    RESOURCE_RENDER_TARGET,  // 帧缓冲附件：渲染目标池、阴影图集、模糊中间图 ...
+    RESOURCE_UNIFORM,        // UBO
+    RESOURCE_SKYBOX,
+    RESOURCE_BUFFER,         // 其余 GPU 缓冲 (SSBO、全屏四边形 ...)
+    RESOURCE_CPU_MESH,       // Mesh 在内存里保留的顶点 / 索引数组
+    RESOURCE_CATEGORY_COUNT
+};
+
+// 同一个数字在不同种类的 GL 对象里可以重复，记录按 (种类, 名字) 区分
+enum ResourceKind {
+    RESOURCE_KIND_TEXTURE,
+    RESOURCE_KIND_BUFFER,
+    RESOURCE_KIND_HOST       // CPU 内存，名字由调用方自己定 (Mesh 用它的 VAO)
+};
+
+inline const char* ResourceCategoryName(int category) {
+    static const char* names[RESOURCE_CATEGORY_COUNT] = {
+        "texture", "mesh", "render_target", "uniform", "skybox", "buffer", "cpu_mesh"
+    };
+    return category >= 0 && category < RESOURCE_CATEGORY_COUNT ? names[category] : "?";
+}
+
+inline bool IsCpuResource(int category) { return category == RESOURCE_CPU_MESH; }
+
+struct ResourceRecord {
+    ResourceCategory category = RESOURCE_BUFFER;
+    ResourceKind kind = RESOURCE_KIND_BUFFER;
+    unsigned int id = 0;
+    size_t bytes = 0;
+    std::string owner;       // 模型 / 贴图路径，或者用途
+    double allocatedAt = 0.0; // 相对于 tracker 创建的秒数
+};
+
+struct ResourceCategoryStats {
+    size_t currentBytes = 0;
+    size_t peakBytes = 0;
+    unsigned int liveCount = 0;
+    unsigned int allocations = 0;
+    unsigned int releases = 0;
+    double releasedLifetime = 0.0; // 已释放资源的存活时间总和 (秒)，除以 releases 是平均寿命
+};
+
+// ==========================================================
+// 显存 / 内存记账：每次分配都登记大小、类别、归属 (模型 / 贴图路径) 和分配时间，释放时注销。
+// 各处分配代码自己调用 Track / Release；大小是按格式估算的，不含驱动的对齐、压缩和内部副本。
+// Model 加载时用 ResourceOwnerScope 把路径设成当前归属，里面的 Mesh 不用知道自己属于谁。
+// 可以多线程调用 (后台加载线程也会分配)
+// ==========================================================
+class ResourceTracker {
+public:
+    static ResourceTracker& Get() {
+        static ResourceTracker instance;
+        return instance;
+    }
+
+    // owner 为空时用当前的 ResourceOwnerScope。同一个对象再登记一次就覆盖 (比如纹理重新分配了存储)
+    void Track(ResourceKind kind, unsigned int id, size_t bytes, ResourceCategory category, const std::string& owner = "") {
+        if (id == 0 && kind != RESOURCE_KIND_HOST) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t k = key(kind, id);
+        auto found = records.find(k);
+        if (found != records.end()) remove(found->second);
+        ResourceRecord record;
+        record.category = category;
+        record.kind = kind;
+        record.id = id;
+        record.bytes = bytes;
+        record.owner = owner.empty() && currentOwner() ? *currentOwner() : owner;
+        record.allocatedAt = now();
+        ResourceCategoryStats& stats = categories[category];
+        stats.currentBytes += bytes;
+        stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+        stats.liveCount++;
+        stats.allocations++;
+        size_t& total = IsCpuResource(category) ? cpuBytes : gpuBytes;
+        size_t& peak = IsCpuResource(category) ? peakCpuBytes : peakGpuBytes;
+        total += bytes;
+        peak = std::max(peak, total);
+        records[k] = std::move(record);
+    }
+
+    void Release(ResourceKind kind, unsigned int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = records.find(key(kind, id));
+        if (found == records.end()) return;
+        ResourceCategoryStats& stats = categories[found->second.category];
+        stats.releases++;
+        stats.releasedLifetime += now() - found->second.allocatedAt;
+        remove(found->second);
+        records.erase(found);
+    }
+
+    // 贴图的显存：宽 x 高 x 每像素字节，有完整 mipmap 链时再加 1/3
+    static size_t TextureBytes(int width, int height, GLenum internalFormat, bool mipmapped, int layers = 1) {
+        size_t bytes = static_cast<size_t>(width) * height * layers * BytesPerPixel(internalFormat);
+        return mipmapped ? bytes + bytes / 3 : bytes;
+    }
+
+    // 驱动一般把 3 通道补成 4 通道存
+    static size_t BytesPerPixel(GLenum internalFormat) {
+        switch (internalFormat) {
+            case GL_RED: case GL_R8: return 1;
+            case GL_RG: case GL_RG8: case GL_R16F: return 2;
+            case GL_RGBA32F: return 16;
+            case GL_RGBA16F: case GL_RGB16F: return 8;
+            default: return 4; // RGB / RGBA / RGBA8 / RG16F / R32F / R11F_G11F_B10F / 深度 ...
+        }
+    }
+
+    ResourceCategoryStats CategoryStats(int category) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return categories[category];
+    }
+
+    size_t GpuBytes() const { std::lock_guard<std::mutex> lock(mutex); return gpuBytes; }
+    size_t PeakGpuBytes() const { std::lock_guard<std::mutex> lock(mutex); return peakGpuBytes; }
+    size_t CpuBytes() const { std::lock_guard<std::mutex> lock(mutex); return cpuBytes; }
+    size_t PeakCpuBytes() const { std::lock_guard<std::mutex> lock(mutex); return peakCpuBytes; }
+
+    // 当前所有存活的记录，按大小从大到小
+    std::vector<ResourceRecord> LiveRecords() const {
+        std::vector<ResourceRecord> live;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            live.reserve(records.size());
+            for (const auto& entry : records) live.push_back(entry.second);
+        }
+        std::sort(live.begin(), live.end(), [](const ResourceRecord& a, const ResourceRecord& b) { return a.bytes > b.bytes; });
+        return live;
+    }
+
+    double Now() const { return now(); }
+
+    // 写成 JSON：总量、每个类别的当前 / 峰值，以及每条存活的记录
+    bool Dump(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            std::cout << "ERROR::RESOURCE:: Failed to open " << path << std::endl;
+            return false;
+        }
+        std::vector<ResourceRecord> live = LiveRecords();
+        double time = now();
+        file << std::fixed << std::setprecision(3);
+        file << "{\n";
+        file << "  \"gpu_bytes\": " << GpuBytes() << ", \"peak_gpu_bytes\": " << PeakGpuBytes() << ",\n";
+        file << "  \"cpu_bytes\": " << CpuBytes() << ", \"peak_cpu_bytes\": " << PeakCpuBytes() << ",\n";
+        file << "  \"categories\": {\n";
+        for (int i = 0; i < RESOURCE_CATEGORY_COUNT; i++) {
+            ResourceCategoryStats stats = CategoryStats(i);
+            file << "    \"" << ResourceCategoryName(i) << "\": {\"current_bytes\": " << stats.currentBytes
+                 << ", \"peak_bytes\": " << stats.peakBytes << ", \"live\": " << stats.liveCount
+                 << ", \"allocations\": " << stats.allocations << ", \"releases\": " << stats.releases
+                 << ", \"mean_lifetime_s\": " << (stats.releases ? stats.releasedLifetime / stats.releases : 0.0) << "}"
+                 << (i + 1 < RESOURCE_CATEGORY_COUNT ? ",\n" : "\n");
+        }
+        file << "  },\n";
+        file << "  \"live\": [\n";
+        for (size_t i = 0; i < live.size(); i++) {
+            const ResourceRecord& record = live[i];
+            file << "    {\"category\": \"" << ResourceCategoryName(record.category) << "\", \"id\": " << record.id
+                 << ", \"bytes\": " << record.bytes << ", \"age_s\": " << time - record.allocatedAt
+                 << ", \"owner\": \"" << escape(record.owner) << "\"}" << (i + 1 < live.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    // 给 ResourceOwnerScope 用
+    static const std::string*& currentOwner() {
+        thread_local const std::string* owner = nullptr;
+        return owner;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, ResourceRecord> records;
+    ResourceCategoryStats categories[RESOURCE_CATEGORY_COUNT];
+    size_t gpuBytes = 0, peakGpuBytes = 0;
+    size_t cpuBytes = 0, peakCpuBytes = 0;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+    static uint64_t key(ResourceKind kind, unsigned int id) {
+        return (static_cast<uint64_t>(kind) << 32) | id;
+    }
+
+    double now() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void remove(const ResourceRecord& record) {
+        ResourceCategoryStats& stats = categories[record.category];
+        stats.currentBytes -= record.bytes;
+        stats.liveCount--;
+        (IsCpuResource(record.category) ? cpuBytes : gpuBytes) -= record.bytes;
+    }
+
+    static std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+};
+
+// 作用域内登记的资源默认归属于 owner (比如正在加载的模型路径)，可以嵌套
+class ResourceOwnerScope {
+public:
+    explicit ResourceOwnerScope(const std::string& owner) : owner(owner), previous(ResourceTracker::currentOwner()) {
+        ResourceTracker::currentOwner() = &this->owner;
+    }
+    ~ResourceOwnerScope() { ResourceTracker::currentOwner() = previous; }
+
+    ResourceOwnerScope(const ResourceOwnerScope&) = delete;
+    ResourceOwnerScope& operator=(const ResourceOwnerScope&) = delete;
+
+private:
+    std::string owner;
+    const std::string* previous;
+};
+
+#endif
\ No newline at end of file
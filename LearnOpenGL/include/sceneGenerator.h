@@ -0,0 +1,185 @@
+#ifndef SCENEGENERATOR_H
+#define SCENEGENERATOR_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "model.h"
+#include "renderObject.h"
+#include "pointLightData.h"
+#include "resourceTracker.h"
+
+// 压力测试场景的参数，同样的参数 (包括种子) 生成的场景完全一样
+struct SceneGeneratorSettings {
+    unsigned int seed = 1;
+    int objects = 100;            // 不算地板
+    int lights = 4;               // 最多 MAX_POINT_LIGHTS，前 MAX_SHADOW_LIGHTS 个有阴影
+    int materials = 8;            // 不同的漫反射纹理数 (纹理切换次数随它变)
+    float characterRatio = 0.02f; // 物体里 PMX 角色的比例，角色子网格多，很重
+    float spacing = 2.5f;         // 每个物体平均占的边长：场景随物体数变大，密度不变
+};
+
+// 生成场景要用的模型 (由 Renderer 提供，已经加载好，这里不拥有)
+struct SceneModels {
+    Model* cube = nullptr;
+    Model* sphere = nullptr;
+    Model* floor = nullptr;
+    std::vector<Model*> characters;
+};
+
+// 只用 mt19937 的原始输出自己换算成浮点数：
+// std::uniform_real_distribution 的算法各家标准库不一样，换个编译器场景就变了
+class SceneRandom {
+public:
+    explicit SceneRandom(unsigned int seed) : engine(seed) {}
+
+    float Float(float min, float max) {
+        return min + (max - min) * ((engine() >> 8) * (1.0f / 16777216.0f));
+    }
+
+    int Int(int count) { return count > 0 ? static_cast<int>(engine() % static_cast<unsigned int>(count)) : 0; }
+
+private:
+    std::mt19937 engine;
+};
+
+// ==========================================================
+// 按种子生成的压力测试场景：一块地板 + N 个物体 (方块 / 球 / PMX 角色) + M 个点光源 + K 种材质
+// 物体随机摆在正方形区域里 (边长随 sqrt(N) 增长)，材质是程序生成的 64x64 棋盘格纹理，
+// 每个非角色物体随机分到一种 (角色保留自己的贴图)。
+// 光源在物体上方随机分布，颜色随机，衰减按区域大小选。
+// 角色用 toon 着色器画，方块和球用 pbr 着色器 (逐个光源累加，扫光源数时着色开销才会跟着变)；
+// 都不描边，所有物体都投射阴影；地板是静态的
+// ==========================================================
+class GeneratedScene {
+public:
+    SceneGeneratorSettings settings;
+    std::vector<RenderObject> objects;  // objects[0] 是地板
+    std::vector<PointLightData> lights;
+    float extent = 0.0f;                // 区域边长
+
+    GeneratedScene(const SceneGeneratorSettings& settings, const SceneModels& models) : settings(settings) {
+        SceneRandom random(settings.seed);
+        int objectCount = std::max(0, settings.objects);
+        int lightCount = std::clamp(settings.lights, 1, MAX_POINT_LIGHTS);
+        int materialCount = std::max(1, settings.materials);
+        extent = std::max(10.0f, std::sqrt(static_cast<float>(objectCount)) * settings.spacing);
+        float half = extent * 0.5f;
+
+        for (int i = 0; i < materialCount; i++) materialTextures.push_back(createMaterialTexture(random));
+
+        // 地板 (floor.obj 大约 2.8 x 2.3，按短边缩放到盖住整个区域)
+        objects.reserve(objectCount + 1);
+        RenderObject floor(models.floor, materialTextures[0]);
+        floor.scale = glm::vec3(half / 1.14f, 1.0f, half / 1.14f);
+        floor.uvScale = glm::vec2(extent * 0.5f);
+        floor.isStatic = true;
+        objects.push_back(floor);
+
+        for (int i = 0; i < objectCount; i++) {
+            glm::vec3 position(random.Float(-half, half), 0.0f, random.Float(-half, half));
+            float yaw = random.Float(0.0f, 360.0f);
+            bool character = !models.characters.empty() && random.Float(0.0f, 1.0f) < settings.characterRatio;
+            if (character) {
+                RenderObject object(models.characters[random.Int(static_cast<int>(models.characters.size()))]);
+                object.position = position;
+                object.rotation = glm::vec3(0.0f, yaw, 0.0f);
+                object.scale = glm::vec3(0.2f);
+                objects.push_back(object);
+                continue;
+            }
+            unsigned int material = materialTextures[random.Int(materialCount)];
+            if (random.Float(0.0f, 1.0f) < 0.5f) {
+                // cube.obj 边长 0.2
+                float size = random.Float(0.5f, 1.5f);
+                RenderObject object(models.cube, material);
+                object.scale = glm::vec3(size / 0.2f);
+                object.position = position + glm::vec3(0.0f, size * 0.5f, 0.0f);
+                object.rotation = glm::vec3(0.0f, yaw, 0.0f);
+                objects.push_back(object);
+            } else {
+                // sphere.obj 半径 1
+                float radius = random.Float(0.3f, 0.8f);
+                RenderObject object(models.sphere, material);
+                object.scale = glm::vec3(radius);
+                object.position = position + glm::vec3(0.0f, radius, 0.0f);
+                objects.push_back(object);
+            }
+        }
+
+        // 光源越多每个越暗，整体亮度大致不变
+        float intensity = std::min(1.5f, 3.0f / std::sqrt(static_cast<float>(lightCount)));
+        for (int i = 0; i < lightCount; i++) {
+            glm::vec3 color = hueToRGB(random.Float(0.0f, 1.0f)) * intensity;
+            PointLightData light{};
+            light.position = glm::vec4(random.Float(-half, half), random.Float(1.5f, 5.0f), random.Float(-half, half), 0.0f);
+            light.ambient = glm::vec4(color * 0.05f, 0.0f);
+            light.diffuse = glm::vec4(color, 0.0f);
+            light.specular = glm::vec4(color, 0.0f);
+            light.constant = 1.0f;
+            light.linear = 0.14f;      // 大约 30 单位的影响范围
+            light.quadratic = 0.07f;
+            lights.push_back(light);
+        }
+    }
+
+    ~GeneratedScene() {
+        for (unsigned int texture : materialTextures) ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, texture);
+        glDeleteTextures(static_cast<GLsizei>(materialTextures.size()), materialTextures.data());
+    }
+
+    GeneratedScene(const GeneratedScene&) = delete;
+    GeneratedScene& operator=(const GeneratedScene&) = delete;
+
+    int MaterialCount() const { return static_cast<int>(materialTextures.size()); }
+
+private:
+    static const int MATERIAL_SIZE = 64;
+    static const int MATERIAL_LEVELS = 7; // 64 -> 1
+
+    std::vector<unsigned int> materialTextures;
+
+    static glm::vec3 hueToRGB(float hue) {
+        glm::vec3 rgb(std::fabs(hue * 6.0f - 3.0f) - 1.0f,
+                      2.0f - std::fabs(hue * 6.0f - 2.0f),
+                      2.0f - std::fabs(hue * 6.0f - 4.0f));
+        return glm::vec3(std::clamp(rgb.x, 0.0f, 1.0f), std::clamp(rgb.y, 0.0f, 1.0f), std::clamp(rgb.z, 0.0f, 1.0f));
+    }
+
+    // 两种颜色的棋盘格，格子 8 像素
+    static unsigned int createMaterialTexture(SceneRandom& random) {
+        glm::vec3 a = glm::vec3(0.25f) + hueToRGB(random.Float(0.0f, 1.0f)) * 0.75f;
+        glm::vec3 b = a * random.Float(0.4f, 0.8f);
+        std::vector<unsigned char> pixels(MATERIAL_SIZE * MATERIAL_SIZE * 4);
+        for (int y = 0; y < MATERIAL_SIZE; y++) {
+            for (int x = 0; x < MATERIAL_SIZE; x++) {
+                const glm::vec3& c = ((x / 8 + y / 8) % 2 == 0) ? a : b;
+                unsigned char* p = &pixels[(y * MATERIAL_SIZE + x) * 4];
+                p[0] = static_cast<unsigned char>(c.x * 255.0f);
+                p[1] = static_cast<unsigned char>(c.y * 255.0f);
+                p[2] = static_cast<unsigned char>(c.z * 255.0f);
+                p[3] = 255;
+            }
+        }
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, MATERIAL_LEVELS, GL_RGBA8, MATERIAL_SIZE, MATERIAL_SIZE);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, MATERIAL_SIZE, MATERIAL_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glGenerateMipmap(GL_TEXTURE_2D);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, texture, ResourceTracker::TextureBytes(MATERIAL_SIZE, MATERIAL_SIZE, GL_RGBA8, true),
+                                     RESOURCE_TEXTURE, "generated material");
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return texture;
+    }
+};
+
+#endif
\ No newline at end of file
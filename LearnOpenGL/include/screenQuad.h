@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "resourceTracker.h"
+
 class ScreenQuad {
 private:
     unsigned int VAO, VBO;
@@ -13,6 +15,7 @@ public:
     }
 
     ~ScreenQuad() {
+        ResourceTracker::Get().Release(RESOURCE_KIND_BUFFER, VBO);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
     }
@@ -43,6 +46,7 @@ private:
         glBindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
+        ResourceTracker::Get().Track(RESOURCE_KIND_BUFFER, VBO, sizeof(quadVertices), RESOURCE_BUFFER, "screen quad");
         
         // Pos
         glEnableVertexAttribArray(0);
@@ -8,14 +8,18 @@
 #include <sstream>
 #include <iostream>
 
+#include "loadStats.h"
+
 class Shader
 {
 public:
     unsigned int ID;
     // constructor generates the shader on the fly
+    // defines 会插在两个阶段的 #version 后面 (比如 "#define POST_BLOOM\n")，同一份源码可以编译出不同的变体
     // ------------------------------------------------------------------------
-    Shader(const char* vertexPath, const char* fragmentPath)
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines = "")
     {
+        LoadStageTimer loadTimer(LOAD_SHADER);
         // 1. retrieve the vertex/fragment source code from filePath
         std::string vertexCode;
         std::string fragmentCode;
@@ -37,13 +41,14 @@ public:
             vShaderFile.close();
             fShaderFile.close();
             // convert stream into string
-            vertexCode   = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
+            vertexCode   = injectDefines(vShaderStream.str(), defines);
+            fragmentCode = injectDefines(fShaderStream.str(), defines);
         }
         catch (std::ifstream::failure& e)
         {
             std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
         }
+        LoadProfiler::Get().AddBytes(LOAD_SHADER, vertexCode.size() + fragmentCode.size());
         const char* vShaderCode = vertexCode.c_str();
         const char * fShaderCode = fragmentCode.c_str();
         // 2. compile shaders
@@ -68,6 +73,38 @@ public:
         glDeleteShader(vertex);
         glDeleteShader(fragment);
     }
+    // 计算着色器 (Compute Shader) 只有一个阶段，单独一个构造函数
+    // ------------------------------------------------------------------------
+    explicit Shader(const char* computePath)
+    {
+        LoadStageTimer loadTimer(LOAD_SHADER);
+        std::string computeCode;
+        std::ifstream cShaderFile;
+        cShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            cShaderFile.open(computePath);
+            std::stringstream cShaderStream;
+            cShaderStream << cShaderFile.rdbuf();
+            cShaderFile.close();
+            computeCode = cShaderStream.str();
+        }
+        catch (std::ifstream::failure& e)
+        {
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        }
+        LoadProfiler::Get().AddBytes(LOAD_SHADER, computeCode.size());
+        const char* cShaderCode = computeCode.c_str();
+        unsigned int compute = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(compute, 1, &cShaderCode, NULL);
+        glCompileShader(compute);
+        checkCompileErrors(compute, "COMPUTE");
+        ID = glCreateProgram();
+        glAttachShader(ID, compute);
+        glLinkProgram(ID);
+        checkCompileErrors(ID, "PROGRAM");
+        glDeleteShader(compute);
+    }
     // activate the shader
     // ------------------------------------------------------------------------
     void use()
@@ -91,6 +128,13 @@ public:
         glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
     }
 
+    // ------------------------------------------------------------------------
+    // 传递 float 数组 (比如模糊核的权重)
+    void setFloatArray(const std::string &name, const float* values, int count) const
+    {
+        glUniform1fv(glGetUniformLocation(ID, name.c_str()), count, values);
+    }
+
     // ------------------------------------------------------------------------
     // 传递 vec2
     void setVec2(const std::string &name, const glm::vec2 &value) const
@@ -101,6 +145,11 @@ public:
     {
         glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
     }
+    // 传递 ivec2 (比如像素尺寸)
+    void setIVec2(const std::string &name, int x, int y) const
+    {
+        glUniform2i(glGetUniformLocation(ID, name.c_str()), x, y);
+    }
     // ------------------------------------------------------------------------
     // 传递 vec3
     void setVec3(const std::string &name, const glm::vec3 &value) const
@@ -141,6 +190,16 @@ public:
     }
 
 private:
+    // #version 必须是第一行，所以 defines 放在它的下一行
+    static std::string injectDefines(const std::string& code, const std::string& defines)
+    {
+        if (defines.empty()) return code;
+        size_t version = code.find("#version");
+        size_t lineEnd = version == std::string::npos ? std::string::npos : code.find('\n', version);
+        if (lineEnd == std::string::npos) return defines + code;
+        return code.substr(0, lineEnd + 1) + defines + code.substr(lineEnd + 1);
+    }
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
     void checkCompileErrors(unsigned int shader, std::string type)
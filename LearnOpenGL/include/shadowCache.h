@@ -0,0 +1,242 @@
+#ifndef SHADOWCACHE_H
+#define SHADOWCACHE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <iostream>
+
+#include "shader.h"
+#include "renderObject.h"
+#include "bounds.h"
+#include "resourceTracker.h"
+
+// 阴影缓存的统计数据 (在 GUI 里显示)
+struct ShadowCacheStats {
+    unsigned int updates = 0;          // 总共更新了多少次区域 (整张图也算一个区域)
+    unsigned int cacheHits = 0;        // 静态层直接复用的次数
+    unsigned int fullHits = 0;         // 连合成都省掉的次数 (没有动态物体且什么都没变)
+    // 静态层失效原因
+    unsigned int invalidForced = 0;    // 首帧 / 手动 Invalidate() / 区域位置变了
+    unsigned int invalidLight = 0;     // 光源矩阵变了
+    unsigned int invalidStaticSet = 0; // 静态物体增加或减少
+    unsigned int invalidStaticMoved = 0; // 某个静态物体的变换变了
+    // 当前帧 (BeginFrame 时清零)
+    unsigned int staticDrawn = 0;      // 本帧画进静态层的物体数
+    unsigned int dynamicDrawn = 0;     // 本帧画进动态层的物体数
+    CullStats frameCull;               // 本帧所有区域的投射物剔除结果加起来
+};
+
+// ==========================================================
+// 静态 / 动态分离的阴影贴图
+// 静态物体 (isStatic = true) 只在光源或静态物体自己变化时才重画到 staticDepth；
+// 每次更新把 staticDepth 拷贝 (Blit) 到最终的 depthMap，再把动态物体叠加画上去。
+// 这样阴影帧的开销只和“真正动了的东西”有关。
+// 一张贴图可以被切成多个区域 (slot)，每个区域单独缓存，给阴影图集用。
+// 投射物由光源视锥决定：包围盒和光源视锥不相交的物体 / 子网格不会被画，
+// 和摄像机看不看得见无关 (摄像机外的物体也可能把影子投进画面)。
+// ==========================================================
+class ShadowCache {
+public:
+    unsigned int depthMap;   // 最终合成的深度图，着色器采样这个
+    ShadowCacheStats stats;
+
+    ShadowCache(unsigned int width, unsigned int height) : width(width), height(height) {
+        createDepthTarget(staticFBO, staticDepth);
+        createDepthTarget(FBO, depthMap);
+    }
+
+    ~ShadowCache() {
+        glDeleteFramebuffers(1, &staticFBO);
+        glDeleteFramebuffers(1, &FBO);
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, staticDepth);
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, depthMap);
+        glDeleteTextures(1, &staticDepth);
+        glDeleteTextures(1, &depthMap);
+    }
+
+    unsigned int Width() const { return width; }
+    unsigned int Height() const { return height; }
+
+    // 强制所有区域下次更新时重建静态层 (比如换了场景)
+    void Invalidate() {
+        for (SlotState& slot : slots) slot.forceRebuild = true;
+    }
+
+    // 每帧开始时调用，清零本帧计数
+    void BeginFrame() {
+        stats.staticDrawn = 0;
+        stats.dynamicDrawn = 0;
+        stats.frameCull = CullStats();
+    }
+
+    // 某个区域最近一次更新时的剔除结果
+    CullStats SlotCull(unsigned int slotIndex) const {
+        return slotIndex < slots.size() ? slots[slotIndex].cull : CullStats();
+    }
+
+    // 整张贴图当一个区域来渲染
+    void Render(const glm::mat4& lightSpaceMatrix, Shader& depthShader, const std::vector<RenderObject*>& casters) {
+        RenderRegion(0, 0, 0, width, height, lightSpaceMatrix, depthShader, casters);
+    }
+
+    // 渲染贴图里的一个区域：casters 里和光源视锥相交的物体按 isStatic 分到静态层 / 动态层
+    // 调用前需要自己设置好剔除等状态，结束后绑定的 FBO 是 depthMap 所在的 FBO
+    void RenderRegion(unsigned int slotIndex, int x, int y, int w, int h,
+                      const glm::mat4& lightSpaceMatrix, Shader& depthShader, const std::vector<RenderObject*>& casters) {
+        if (slotIndex >= slots.size()) slots.resize(slotIndex + 1);
+        SlotState& slot = slots[slotIndex];
+        stats.updates++;
+
+        Frustum frustum(lightSpaceMatrix);
+        CullStats cull;
+        std::vector<RenderObject*> statics;
+        std::vector<RenderObject*> dynamics;
+        for (RenderObject* obj : casters) {
+            if (!obj->castShadow) continue;
+            cull.objectsTested++;
+            if (!frustum.Intersects(obj->GetWorldBounds())) {
+                cull.objectsCulled++;
+                continue;
+            }
+            if (obj->isStatic) statics.push_back(obj);
+            else dynamics.push_back(obj);
+        }
+
+        // 视口只管坐标映射，清屏和 Blit 之外的像素还要靠裁剪测试挡住，免得画到别的区域
+        glViewport(x, y, w, h);
+        glScissor(x, y, w, h);
+        glEnable(GL_SCISSOR_TEST);
+        depthShader.use();
+        depthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
+        // 1. 静态层：检查是否需要重建
+        if (slot.x != x || slot.y != y || slot.w != w || slot.h != h) {
+            slot.forceRebuild = true;
+            slot.x = x; slot.y = y; slot.w = w; slot.h = h;
+        }
+        bool rebuilt = checkStaticLayer(slot, lightSpaceMatrix, statics);
+        if (rebuilt) {
+            glBindFramebuffer(GL_FRAMEBUFFER, staticFBO);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            for (RenderObject* obj : statics) obj->DrawCulled(depthShader, frustum, cull);
+            cull.objectsSubmitted += static_cast<unsigned int>(statics.size());
+            stats.staticDrawn += static_cast<unsigned int>(statics.size());
+        } else {
+            stats.cacheHits++;
+        }
+
+        // 2. 合成：静态层没变且上一次也没有动态物体时，depthMap 里已经是正确结果了
+        bool needComposite = rebuilt || !dynamics.empty() || slot.hadDynamics;
+        slot.hadDynamics = !dynamics.empty();
+        if (!needComposite) {
+            recordCull(slot, cull);
+            stats.fullHits++;
+            glDisable(GL_SCISSOR_TEST);
+            glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+            return;
+        }
+
+        // 深度拷贝：两个附件格式完全一致，直接 Blit
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, FBO);
+        glBlitFramebuffer(x, y, x + w, y + h, x, y, x + w, y + h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+        // 3. 动态层：直接在拷贝好的深度上叠加绘制，深度测试自然完成合并
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+        for (RenderObject* obj : dynamics) obj->DrawCulled(depthShader, frustum, cull);
+        cull.objectsSubmitted += static_cast<unsigned int>(dynamics.size());
+        stats.dynamicDrawn += static_cast<unsigned int>(dynamics.size());
+        recordCull(slot, cull);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+private:
+    // 每个区域上一次重建静态层时的状态
+    struct SlotState {
+        bool forceRebuild = true;
+        bool hadDynamics = false;
+        int x = -1, y = -1, w = 0, h = 0;
+        glm::mat4 cachedLightSpace = glm::mat4(1.0f);
+        std::vector<const RenderObject*> cachedStatics;
+        std::vector<glm::mat4> cachedStaticModels;
+        CullStats cull;
+    };
+
+    unsigned int width, height;
+    unsigned int staticFBO, staticDepth;
+    unsigned int FBO;
+    std::vector<SlotState> slots;
+
+    void recordCull(SlotState& slot, const CullStats& cull) {
+        slot.cull = cull;
+        stats.frameCull.Add(cull);
+    }
+
+    // 返回 true 表示静态层需要重画，同时记录失效原因并更新缓存的状态
+    bool checkStaticLayer(SlotState& slot, const glm::mat4& lightSpaceMatrix, const std::vector<RenderObject*>& statics) {
+        bool invalid = true;
+        if (slot.forceRebuild) {
+            stats.invalidForced++;
+        } else if (lightSpaceMatrix != slot.cachedLightSpace) {
+            stats.invalidLight++;
+        } else if (!sameStaticSet(slot, statics)) {
+            stats.invalidStaticSet++;
+        } else if (staticMoved(slot, statics)) {
+            stats.invalidStaticMoved++;
+        } else {
+            invalid = false;
+        }
+        if (!invalid) return false;
+
+        slot.forceRebuild = false;
+        slot.cachedLightSpace = lightSpaceMatrix;
+        slot.cachedStatics.assign(statics.begin(), statics.end());
+        slot.cachedStaticModels.clear();
+        for (RenderObject* obj : statics) slot.cachedStaticModels.push_back(obj->GetModelMatrix());
+        return true;
+    }
+
+    static bool sameStaticSet(const SlotState& slot, const std::vector<RenderObject*>& statics) {
+        if (statics.size() != slot.cachedStatics.size()) return false;
+        for (size_t i = 0; i < statics.size(); i++)
+            if (statics[i] != slot.cachedStatics[i]) return false;
+        return true;
+    }
+
+    static bool staticMoved(const SlotState& slot, const std::vector<RenderObject*>& statics) {
+        for (size_t i = 0; i < statics.size(); i++)
+            if (statics[i]->GetModelMatrix() != slot.cachedStaticModels[i]) return true;
+        return false;
+    }
+
+    void createDepthTarget(unsigned int& fbo, unsigned int& tex) {
+        glGenFramebuffers(1, &fbo);
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        // 两张深度图必须是同一个内部格式，Blit 才能成功，所以这里写死 DEPTH_COMPONENT24
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, tex, ResourceTracker::TextureBytes(width, height, GL_DEPTH_COMPONENT24, false),
+                                     RESOURCE_RENDER_TARGET, "shadow atlas");
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // 超出范围的地方不做阴影 (设为白色，深度 1.0)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        float borderColor[] = { 1.0, 1.0, 1.0, 1.0 };
+        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, tex, 0);
+        // 不需要任何颜色数据
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cout << "ERROR::SHADOWCACHE:: Framebuffer is not complete!" << std::endl;
+        // 先清一遍，没画过的区域就是“没有遮挡”
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+};
+
+#endif
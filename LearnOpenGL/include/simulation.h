@@ -0,0 +1,349 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <glm/glm.hpp>
+
+#include "camera.h"
+#include "pointLightData.h"
+
+// ==========================================================
+// 三缓冲：一个写线程、一个读线程，都不用锁也不会互相等。
+// 写线程一直在写自己那份，写好 Publish 和中间那份交换；读线程 Update 时如果中间那份是新的就换过来。
+// 读线程拿到的永远是完整的一份 (不会读到写了一半的)，而且是 Update 那一刻最新的
+// ==========================================================
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) { slots[0] = slots[1] = slots[2] = initial; }
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // 写线程用
+    T& WriteBuffer() { return slots[back]; }
+    void Publish() {
+        int previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // 读线程用：有新发布的就换过来，返回是否换了
+    bool Update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        int previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& ReadBuffer() const { return slots[front]; }
+
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;       // 中间那份还没被读线程拿走
+    T slots[3];
+    int back = 0;                     // 只有写线程碰
+    std::atomic<int> middle{ 1 };
+    int front = 2;                    // 只有读线程碰
+};
+
+// 模拟线程处理的按键 (按位存在 SimulationInput::keys 里)
+enum SimulationKey {
+    SIM_KEY_FORWARD,
+    SIM_KEY_BACKWARD,
+    SIM_KEY_LEFT,
+    SIM_KEY_RIGHT,
+    SIM_KEY_LIGHT_LEFT,      // 光源 -X
+    SIM_KEY_LIGHT_RIGHT,     // 光源 +X
+    SIM_KEY_LIGHT_FORWARD,   // 光源 -Z
+    SIM_KEY_LIGHT_BACKWARD,  // 光源 +Z
+    SIM_KEY_LIGHT_UP,
+    SIM_KEY_LIGHT_DOWN,
+    SIM_KEY_COUNT
+};
+
+// 主线程攒下来、还没交给模拟的输入。按键是当前状态，鼠标和滚轮是累计量
+struct SimulationInput {
+    unsigned int keys = 0;
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+    float scroll = 0.0f;
+    unsigned long long sequence = 0;                  // 每来一笔输入 (按键变化 / 鼠标 / 滚轮) 加一
+    std::chrono::steady_clock::time_point time;       // 最早一笔还没处理的输入是什么时候来的
+};
+
+// 模拟线程发布给渲染线程的一份完整状态，发布后就不再改
+struct SceneSnapshot {
+    Camera camera;
+    PointLightData light = {};
+    unsigned long long tick = 0;              // 第几步模拟
+    unsigned long long inputSequence = 0;     // 已经用到的输入批次
+    unsigned long long lightRevision = 0;     // 已经用到的 SetLight 次数
+    std::chrono::steady_clock::time_point inputTime;    // inputSequence 那批输入到达的时间 (算输入延迟)
+    std::chrono::steady_clock::time_point publishTime;
+};
+
+struct SimulationSettings {
+    bool threaded = true;     // 关掉就回到原来的做法：主线程每帧按帧时间走一步
+    int tickRate = 240;       // 模拟线程固定步长的频率 (Hz)
+    bool lateLatch = true;    // 渲染取快照前等模拟线程吃掉刚推过去的输入 (最多 Simulation::LATCH_TIMEOUT)
+};
+
+struct SimulationStats {
+    float stepMs = 0.0f;             // 模拟一步的 CPU 时间
+    float ticksPerSecond = 0.0f;
+    float snapshotAgeMs = 0.0f;      // 渲染拿到快照时，它已经发布了多久
+    float inputLatencyMs = 0.0f;     // 输入到达 -> 带着它的快照被渲染线程拿到
+    float latchWaitMs = 0.0f;
+};
+
+// ==========================================================
+// 模拟线程：摄像机和光源归它管 (主线程不再直接改)，按固定频率一步步走，每步发布一份 SceneSnapshot。
+// 主线程 (窗口事件只能在主线程上取) 只把输入推过来，渲染时拿最新的快照；帧慢了不影响模拟，模拟也不等渲染。
+// 输入一到就立刻应用鼠标 / 滚轮并重新发布 (不等下一步)，按住的键按固定步长积分。
+// settings.threaded 关掉时不开线程，主线程调 Advance 按帧时间走一步，和以前的行为一样
+// ==========================================================
+class Simulation {
+public:
+    static constexpr float LIGHT_SPEED = 5.0f;   // 光源移动速度 (每秒)
+    static constexpr std::chrono::microseconds LATCH_TIMEOUT{ 1000 };
+
+    Simulation(const Camera& camera, const PointLightData& light) : camera(camera), light(light), snapshots(initialSnapshot()) {}
+    ~Simulation() { Stop(); }
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // 按 settings.threaded 开 / 停模拟线程 (每帧调用，切换时才有动作)
+    void Apply(const SimulationSettings& newSettings) {
+        tickRate.store(std::max(newSettings.tickRate, 1), std::memory_order_relaxed);
+        if (newSettings.threaded && !running) Start();
+        else if (!newSettings.threaded && running) Stop();
+    }
+    bool Threaded() const { return running; }
+
+    // ---------- 主线程：推输入 ----------
+    void SetKeys(unsigned int keys) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (keys == pending.keys) return;
+        pending.keys = keys;
+        touchInput();
+        wake.notify_one();
+    }
+    void AddMouse(float xoffset, float yoffset) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.mouseX += xoffset;
+        pending.mouseY += yoffset;
+        touchInput();
+        wake.notify_one();
+    }
+    void AddScroll(float yoffset) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.scroll += yoffset;
+        touchInput();
+        wake.notify_one();
+    }
+    // GUI 直接改了光源 (位置 / 颜色 / 衰减)，覆盖模拟里的光源
+    void SetLight(const PointLightData& edited) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lightOverride = edited;
+        lightRevisionPending++;
+        wake.notify_one();
+    }
+    unsigned long long LightRevision() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lightRevisionPending;
+    }
+
+    // 不开线程时主线程每帧调用：按帧时间走一步并发布
+    void Advance(float deltaTime) {
+        if (!running) step(deltaTime, true);
+    }
+
+    // ---------- 渲染线程：拿最新快照 ----------
+    // 返回的引用一直有效，直到下一次 Acquire
+    const SceneSnapshot& Acquire(bool lateLatch) {
+        auto start = std::chrono::steady_clock::now();
+        float latchWaitMs = 0.0f;
+        if (running && lateLatch) {
+            // 等模拟线程把已经推过去的输入用掉再取，省掉最多一整步的延迟
+            std::unique_lock<std::mutex> lock(mutex);
+            unsigned long long wanted = pending.sequence;
+            published.wait_until(lock, start + LATCH_TIMEOUT, [&]() { return consumedSequence >= wanted; });
+            latchWaitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        bool fresh = snapshots.Update();
+        const SceneSnapshot& snapshot = snapshots.ReadBuffer();
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.latchWaitMs = latchWaitMs;
+        stats.snapshotAgeMs = std::chrono::duration<float, std::milli>(now - snapshot.publishTime).count();
+        if (fresh && snapshot.inputSequence > renderedSequence) {
+            stats.inputLatencyMs = std::chrono::duration<float, std::milli>(now - snapshot.inputTime).count();
+            renderedSequence = snapshot.inputSequence;
+        }
+        return snapshot;
+    }
+
+    SimulationStats Stats() const {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        return stats;
+    }
+
+private:
+    // ---------- 只有模拟这一侧碰 (线程开着时是模拟线程，关着时是主线程) ----------
+    Camera camera;
+    PointLightData light;
+    unsigned long long tick = 0;
+    unsigned long long lightRevision = 0;
+    SimulationInput input;                    // 最近一次取走的输入 (按键状态一直沿用)
+
+    // ---------- 主线程和模拟线程共享，mutex 保护 ----------
+    mutable std::mutex mutex;
+    std::condition_variable wake;             // 有新输入 / 光源覆盖 / 要退出，叫醒模拟线程
+    std::condition_variable published;        // 发布了新快照，叫醒 late latch
+    SimulationInput pending;
+    PointLightData lightOverride = {};
+    unsigned long long lightRevisionPending = 0;
+    unsigned long long consumedSequence = 0;
+    bool stopping = false;
+
+    TripleBuffer<SceneSnapshot> snapshots;
+    std::thread thread;
+    bool running = false;                     // 只在主线程上改 (Start / Stop)
+    std::atomic<int> tickRate{ 240 };
+
+    mutable std::mutex statsMutex;
+    SimulationStats stats;
+    unsigned long long renderedSequence = 0;  // 渲染线程用
+
+    SceneSnapshot initialSnapshot() const {
+        SceneSnapshot snapshot;
+        snapshot.camera = camera;
+        snapshot.light = light;
+        snapshot.publishTime = std::chrono::steady_clock::now();
+        snapshot.inputTime = snapshot.publishTime;
+        return snapshot;
+    }
+
+    void touchInput() {
+        if (pending.sequence == consumedSequence) pending.time = std::chrono::steady_clock::now();
+        pending.sequence++;
+    }
+
+    void Start() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = false;
+        }
+        running = true;
+        thread = std::thread([this]() { loop(); });
+    }
+
+    void Stop() {
+        if (!running) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+        running = false;
+    }
+
+    // 固定步长；落后太多 (比如调试器停住) 就不追了，直接从现在重新算
+    void loop() {
+        using clock = std::chrono::steady_clock;
+        clock::time_point next = clock::now();
+        clock::time_point rateStart = next;
+        int ticksSinceRate = 0;
+        while (true) {
+            std::chrono::nanoseconds period(1000000000LL / tickRate.load(std::memory_order_relaxed));
+            next += period;
+            clock::time_point now = clock::now();
+            if (now - next > period * 8) next = now;
+            float dt = std::chrono::duration<float>(period).count();
+            step(dt, true);
+            ticksSinceRate++;
+            if (now - rateStart >= std::chrono::milliseconds(500)) {
+                std::lock_guard<std::mutex> lock(statsMutex);
+                stats.ticksPerSecond = ticksSinceRate / std::chrono::duration<float>(now - rateStart).count();
+                rateStart = now;
+                ticksSinceRate = 0;
+            }
+            // 两步之间来了新输入就被叫醒：只应用输入、重新发布，不推进时间
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping && clock::now() < next) {
+                bool woken = wake.wait_until(lock, next, [this]() {
+                    return stopping || pending.sequence != consumedSequence || lightRevisionPending != lightRevision;
+                });
+                if (!woken || stopping) break;
+                lock.unlock();
+                step(0.0f, false);
+                lock.lock();
+            }
+            if (stopping) return;
+        }
+    }
+
+    // 取走输入，走 dt 秒，发布。advance = false 时只应用鼠标 / 滚轮 / 光源覆盖，记下新的按键状态
+    void step(float dt, bool advance) {
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            input.keys = pending.keys;
+            input.mouseX = pending.mouseX;
+            input.mouseY = pending.mouseY;
+            input.scroll = pending.scroll;
+            input.sequence = pending.sequence;
+            input.time = pending.time;
+            pending.mouseX = pending.mouseY = pending.scroll = 0.0f;
+            if (lightRevisionPending != lightRevision) {
+                light = lightOverride;
+                lightRevision = lightRevisionPending;
+            }
+        }
+        if (input.mouseX != 0.0f || input.mouseY != 0.0f) camera.ProcessMouseMovement(input.mouseX, input.mouseY);
+        if (input.scroll != 0.0f) camera.ProcessMouseScroll(input.scroll);
+        if (advance) {
+            tick++;
+            if (held(SIM_KEY_FORWARD)) camera.ProcessKeyboard(FORWARD, dt);
+            if (held(SIM_KEY_BACKWARD)) camera.ProcessKeyboard(BACKWARD, dt);
+            if (held(SIM_KEY_LEFT)) camera.ProcessKeyboard(LEFT, dt);
+            if (held(SIM_KEY_RIGHT)) camera.ProcessKeyboard(RIGHT, dt);
+            float lightStep = LIGHT_SPEED * dt;
+            if (held(SIM_KEY_LIGHT_LEFT)) light.position.x -= lightStep;
+            if (held(SIM_KEY_LIGHT_RIGHT)) light.position.x += lightStep;
+            if (held(SIM_KEY_LIGHT_FORWARD)) light.position.z -= lightStep;
+            if (held(SIM_KEY_LIGHT_BACKWARD)) light.position.z += lightStep;
+            if (held(SIM_KEY_LIGHT_UP)) light.position.y += lightStep;
+            if (held(SIM_KEY_LIGHT_DOWN)) light.position.y -= lightStep;
+        }
+
+        SceneSnapshot& snapshot = snapshots.WriteBuffer();
+        snapshot.camera = camera;
+        snapshot.light = light;
+        snapshot.tick = tick;
+        snapshot.inputSequence = input.sequence;
+        snapshot.inputTime = input.time;
+        snapshot.lightRevision = lightRevision;
+        snapshot.publishTime = std::chrono::steady_clock::now();
+        snapshots.Publish();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            consumedSequence = input.sequence;
+        }
+        published.notify_all();
+        if (advance) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.stepMs = std::chrono::duration<float, std::milli>(snapshot.publishTime - start).count();
+        }
+    }
+
+    bool held(SimulationKey key) const { return (input.keys & (1u << key)) != 0; }
+};
+
+#endif
\ No newline at end of file
@@ -7,6 +7,9 @@
 
 #include "shader.h"
 #include "stb_image.h" // 确保你的 include 目录里有这个
+#include "loadStats.h"
+#include "resourceTracker.h"
+#include "jobSystem.h"
 
 #include <vector>
 #include <string>
@@ -25,6 +28,8 @@ public:
 
     // 析构函数：清理 GPU 资源
     ~Skybox() {
+        ResourceTracker::Get().Release(RESOURCE_KIND_BUFFER, VBO);
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, cubemapTexture);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
         glDeleteTextures(1, &cubemapTexture);
@@ -114,6 +119,7 @@ private:
         glBindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), &skyboxVertices, GL_STATIC_DRAW);
+        ResourceTracker::Get().Track(RESOURCE_KIND_BUFFER, VBO, sizeof(skyboxVertices), RESOURCE_SKYBOX, "skybox");
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         glBindVertexArray(0);
@@ -125,23 +131,44 @@ private:
         glGenTextures(1, &textureID);
         glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
-        int width, height, nrChannels;
+        // 六个面互不相关，先在任务系统上并行解码，再在当前线程 (有 GL 上下文) 依次上传。
+        // LoadProfiler 只能在主线程用，所以整段并行解码算一次 LOAD_DECODE
+        struct Face {
+            unsigned char* data = nullptr;
+            int width = 0, height = 0, nrChannels = 0;
+        };
+        vector<Face> decoded(faces.size());
+        {
+            LoadStageTimer timer(LOAD_DECODE);
+            JobSystem::Get().ParallelFor(0, static_cast<int>(faces.size()), 1, [&faces, &decoded](int i) {
+                // stbi_load 不需要 #define STB_IMAGE_IMPLEMENTATION，因为 Model.cpp 里已经定义过了
+                // 如果链接报错，请检查是否有一个 cpp 定义了该宏
+                Face& face = decoded[i];
+                face.data = stbi_load(faces[i].c_str(), &face.width, &face.height, &face.nrChannels, 0);
+            });
+        }
+
+        size_t totalBytes = 0;
         for (unsigned int i = 0; i < faces.size(); i++) {
-            // stbi_load 不需要 #define STB_IMAGE_IMPLEMENTATION，因为 Model.cpp 里已经定义过了
-            // 如果链接报错，请检查是否有一个 cpp 定义了该宏
-            unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-            if (data) {
+            Face& face = decoded[i];
+            if (face.data) {
                 // 这里的格式根据图片通道数自动判断，防止 jpg/png 混合加载时出错
                 GLenum format = GL_RGB;
-                if (nrChannels == 4) format = GL_RGBA;
-
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 
-                             0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data
-                );
-                stbi_image_free(data);
+                if (face.nrChannels == 4) format = GL_RGBA;
+
+                {
+                    LoadStageTimer timer(LOAD_UPLOAD);
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 
+                                 0, format, face.width, face.height, 0, format, GL_UNSIGNED_BYTE, face.data
+                    );
+                }
+                size_t bytes = static_cast<size_t>(face.width) * face.height * face.nrChannels;
+                LoadProfiler::Get().AddBytes(LOAD_DECODE, bytes);
+                LoadProfiler::Get().AddBytes(LOAD_UPLOAD, bytes);
+                totalBytes += ResourceTracker::TextureBytes(face.width, face.height, format, false);
+                stbi_image_free(face.data);
             } else {
                 cout << "Cubemap texture failed to load at path: " << faces[i] << endl;
-                stbi_image_free(data);
             }
         }
         
@@ -150,6 +177,8 @@ private:
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, textureID, totalBytes, RESOURCE_SKYBOX,
+                                     faces.empty() ? "skybox" : faces[0]);
 
         return textureID;
     }
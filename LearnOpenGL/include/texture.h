@@ -4,6 +4,8 @@
 #include <glad/glad.h>
 #include <iostream>
 #include "stb_image.h" // 确保这一行能找到你的 stb_image.h
+#include "loadStats.h"
+#include "resourceTracker.h"
 
 class Texture {
 public:
@@ -32,7 +34,11 @@ public:
 
         // 加载图片数据
         // --------------------------------------------------------------------
-        unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
+        unsigned char* data;
+        {
+            LoadStageTimer timer(LOAD_DECODE);
+            data = stbi_load(path, &width, &height, &nrChannels, 0);
+        }
 
         if (data) {
             // 自动判断图片格式 (JPG通常是RGB, PNG通常是RGBA)
@@ -45,8 +51,20 @@ public:
                 format = GL_RGBA;
 
             // 生成纹理
-            glTexImage2D(type, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(type); // 自动生成多级渐远纹理
+            {
+                LoadStageTimer timer(LOAD_UPLOAD);
+                glTexImage2D(type, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+            }
+            {
+                LoadStageTimer timer(LOAD_MIPMAP);
+                glGenerateMipmap(type); // 自动生成多级渐远纹理
+            }
+            size_t bytes = static_cast<size_t>(width) * height * nrChannels;
+            LoadProfiler::Get().AddBytes(LOAD_DECODE, bytes);
+            LoadProfiler::Get().AddBytes(LOAD_UPLOAD, bytes);
+            LoadProfiler::Get().AddBytes(LOAD_MIPMAP, bytes / 3);
+            ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, ID, ResourceTracker::TextureBytes(width, height, format, true),
+                                         RESOURCE_TEXTURE, path);
         }
         else {
             std::cout << "Failed to load texture: " << path << std::endl;
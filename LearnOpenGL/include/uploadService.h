@@ -0,0 +1,240 @@
+#ifndef UPLOADSERVICE_H
+#define UPLOADSERVICE_H
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "glStats.h"
+#include "loadStats.h"
+#include "resourceTracker.h"
+
+// 和主上下文共享对象的第二个上下文，由窗口 (隐藏的 GLFW 窗口) 或无窗口 (HeadlessContext) 那边创建
+struct UploadContext {
+    std::function<bool()> makeCurrent;   // 在上传线程上调用一次
+    std::function<void()> release;       // 上传线程退出前调用
+};
+
+struct UploadStats {
+    unsigned long long textures = 0;
+    unsigned long long buffers = 0;
+    unsigned long long bytes = 0;
+    double busyMs = 0.0;                 // 上传线程在任务里花的时间 (解析 + 解码 + 提交)
+};
+
+// fence 过了吗 (不等待)。任何一个共享上下文里都能查
+inline bool UploadFenceSignaled(GLsync fence) {
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+// ==========================================================
+// 后台上传线程：自己一个和主上下文共享的 GL 上下文，大块的纹理 / 缓冲数据在这里交给驱动，
+// 渲染线程上不再有 glTexImage2D / glBufferData 这种会卡住一帧的调用。
+// - 数据先拷进 staging 缓冲 (PBO)，纹理从 GL_PIXEL_UNPACK_BUFFER 分条 glTexSubImage2D，
+//   缓冲用 glCopyBufferSubData；staging 每次 orphan，不用等 GPU 读完上一条
+// - 任务做完插 glFenceSync + glFlush，渲染线程用 UploadFenceSignaled 查，过了才能用这些对象
+//   (GPU 上真的写完了，而且渲染线程下一次绑定时能看到)
+// - VAO 这类容器对象不在上下文之间共享，要在渲染线程上建 (Mesh::CreateVertexArray)
+// - GlStats 的计数和 LoadProfiler 只在渲染线程上记，上传线程上的调用不算；
+//   GlCapture 录不了两个上下文交错的命令流，录制时不要开 (main.cpp 里录制时不建上传服务)
+// ==========================================================
+class UploadService {
+public:
+    static const size_t DEFAULT_STAGING_BYTES = 4 * 1024 * 1024;
+
+    explicit UploadService(UploadContext context, size_t stagingBytes = DEFAULT_STAGING_BYTES)
+        : context(std::move(context)), stagingBytes(std::max<size_t>(stagingBytes, 1)) {
+        thread = std::thread([this]() { loop(); });
+        // 等上传线程把上下文设成当前的，失败了 Valid() 为 false
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return started; });
+    }
+
+    ~UploadService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        thread.join();
+    }
+
+    UploadService(const UploadService&) = delete;
+    UploadService& operator=(const UploadService&) = delete;
+
+    bool Valid() const { return valid; }
+
+    // 任意线程：排一个任务到上传线程，按提交顺序执行。任务里用下面的 Upload* / Fence
+    void Submit(std::function<void(UploadService&)> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        changed.notify_all();
+    }
+
+    // 还没做完的任务数 (包括正在做的)
+    int Pending() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<int>(tasks.size()) + (busy ? 1 : 0);
+    }
+
+    UploadStats Stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    // ---------- 下面只在上传线程 (任务里) 调用 ----------
+
+    // 8 位 1 / 3 / 4 通道图像，建完整的 mipmap 链，参数和 TextureFromFile 一样。pixels 为空时只建名字 (解码失败)
+    unsigned int UploadTexture(const unsigned char* pixels, int width, int height, int components, const std::string& owner) {
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        if (!pixels || width <= 0 || height <= 0) return texture;
+        GLenum format = components == 1 ? GL_RED : components == 3 ? GL_RGB : GL_RGBA;
+        GLenum internalFormat = components == 1 ? GL_R8 : components == 3 ? GL_RGB8 : GL_RGBA8;
+        int levels = 1;
+        while ((std::max(width, height) >> levels) > 0) levels++;
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+        // 每条尽量塞满 staging，至少一行
+        size_t rowBytes = static_cast<size_t>(width) * components;
+        int rowsPerStrip = static_cast<int>(std::max<size_t>(stagingBytes / rowBytes, 1));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging);
+        for (int y = 0; y < height; y += rowsPerStrip) {
+            int rows = std::min(rowsPerStrip, height - y);
+            size_t bytes = rowBytes * rows;
+            stage(GL_PIXEL_UNPACK_BUFFER, pixels + rowBytes * y, bytes);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, rows, format, GL_UNSIGNED_BYTE, nullptr);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // 一张图交一次，驱动可以边收边传，不用攒到任务结束
+        glFlush();
+
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, texture, ResourceTracker::TextureBytes(width, height, format, true),
+                                     RESOURCE_TEXTURE, owner);
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.textures++;
+        stats.bytes += rowBytes * height;
+        return texture;
+    }
+
+    // 不可变的顶点 / 索引缓冲 (GL_STATIC_DRAW)
+    unsigned int UploadBuffer(const void* data, size_t bytes, ResourceCategory category) {
+        unsigned int buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, staging);
+        for (size_t offset = 0; offset < bytes; offset += stagingBytes) {
+            size_t chunk = std::min(stagingBytes, bytes - offset);
+            stage(GL_COPY_READ_BUFFER, static_cast<const unsigned char*>(data) + offset, chunk);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, static_cast<GLintptr>(offset),
+                                static_cast<GLsizeiptr>(chunk));
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        ResourceTracker::Get().Track(RESOURCE_KIND_BUFFER, buffer, bytes, category);
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.buffers++;
+        stats.bytes += bytes;
+        return buffer;
+    }
+
+    // 到这里为止提交的上传全部做完时会过的 fence (已经 flush)，由渲染线程查完删掉
+    GLsync Fence() {
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        return fence;
+    }
+
+private:
+    UploadContext context;
+    size_t stagingBytes;
+    unsigned int staging = 0;
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::function<void(UploadService&)>> tasks;
+    bool started = false;
+    bool valid = false;
+    bool stopping = false;
+    bool busy = false;
+    UploadStats stats;
+
+    // staging 重新分配一块 (orphan，GPU 还在读的旧存储由驱动留着)，写进 data
+    void stage(GLenum target, const void* data, size_t bytes) {
+        glBufferData(target, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        void* mapped = glMapBufferRange(target, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (!mapped) {
+            std::cout << "ERROR::UPLOAD:: Failed to map staging buffer" << std::endl;
+            return;
+        }
+        std::memcpy(mapped, data, bytes);
+        glUnmapBuffer(target);
+    }
+
+    void loop() {
+        bool current = context.makeCurrent && context.makeCurrent();
+        if (current) {
+            GlStats::IgnoreCurrentThread();
+            LoadProfiler::IgnoreCurrentThread();
+            glGenBuffers(1, &staging);
+        } else {
+            std::cout << "ERROR::UPLOAD:: Failed to make the shared upload context current" << std::endl;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            started = true;
+            valid = current;
+        }
+        changed.notify_all();
+
+        // 退出前把排着的任务做完 (等它们的 fence 的人可能还在)
+        while (current) {
+            std::function<void(UploadService&)> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) break;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                busy = true;
+            }
+            auto start = std::chrono::steady_clock::now();
+            task(*this);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.busyMs += ms;
+            busy = false;
+        }
+
+        if (current) {
+            glDeleteBuffers(1, &staging);
+            glFinish();
+            if (context.release) context.release();
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -2,37 +2,35 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <cstdlib>
 
-#include "shader.h"
 #include "camera.h"
+#include "renderer.h"
+#include "simulation.h"
 
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include "model.h"
-#include "screenQuad.h"
-#include "skybox.h"
-#include "UBO.h"
-#include "pointLightData.h"
-#include "renderObject.h"
-#include "texture.h"
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
 #include "Gui.h"
-#include "postProcessingData.h"
+#include "glCapture.h"
+#include "uploadService.h"
 
 using namespace std;
 
 const int SCR_WIDTH = 1600;
 const int SCR_HEIGHT = 1200;
+// 帧缓冲的实际尺寸 (窗口缩放后由回调更新，高 DPI 屏幕上和窗口尺寸不一样)
+int framebufferWidth = SCR_WIDTH;
+int framebufferHeight = SCR_HEIGHT;
 
-// 摄像机
-Camera camera(glm::vec3(0.0f, 2.0f, 3.0f));
+// 摄像机和光源归模拟线程管 (simulation.h)，这里的回调只往它那里推输入
+Simulation* simulation = nullptr;
+SimulationSettings simulationSettings;
 float lastX = SCR_WIDTH / 2.0f;
 float lastY = SCR_HEIGHT / 2.0f;
-const unsigned int SHADOW_WIDTH = 2048, SHADOW_HEIGHT = 2048; // 阴影贴图分辨率，越高锯齿越少
 bool firstMouse = true; // 用于解决第一次进入窗口时的跳变问题
 bool isCursorVisible = false; // 用于控制鼠标状态
 // 时间控制
@@ -45,43 +43,15 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos); // 【新】
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset); // 【新】滚轮回调
 void processInput(GLFWwindow *window);
 GLFWwindow* initWindow();
-void configFrameBuffer(unsigned int &framebuffer, unsigned int* colorBuffers);
+bool startCapture(int argc, char** argv);
+// 这里只记下新尺寸，渲染目标在下一帧开始时由 RenderTargetPool 按需重新分配
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
+    framebufferWidth = width;
+    framebufferHeight = height;
 }
-void initShadowMap(unsigned int& depthMapFBO, unsigned int& depthMap);
 
-glm::vec3 lightPoses[] = {
-    glm::vec3( 0.7f,  0.2f,  2.0f),
-    glm::vec3( 2.3f, -3.3f, -4.0f),
-    glm::vec3(-4.0f,  2.0f, -12.0f),
-    glm::vec3( 0.0f,  0.0f, -3.0f)
-};
-glm::vec3 lightColors[] = {
-    glm::vec3(1.0f, 1.0f, 1.0f), // 白
-    glm::vec3(1.0f, 0.0f, 0.0f), // 红
-    glm::vec3(0.0f, 1.0f, 0.0f), // 绿
-    glm::vec3(0.0f, 0.0f, 1.0f)  // 蓝
-};
-PostProcessingData postProcessingData = {
-    0.7f,
-    10,
-    2.2,
-    0.4f
-};
-PointLightData lightData = {
-    glm::vec4(-2.0f, 5.0f, -1.0f, 0.0f), // position
-    glm::vec4(0.3f, 0.3f, 0.3f, 0.0f), // ambient
-    glm::vec4(glm::vec3(1.2f), 0.0f), // diffuse
-    glm::vec4(glm::vec3(2.0f), 0.0f), // specular
-    1.0f, 0.09f, 0.032f, 0.0f          // constant, linear, quadratic, padding
-};
-
-struct LightBlockData {
-    PointLightData pointLights[4];
-};
-
-int main() {
+int main(int argc, char** argv) {
     GLFWwindow* window = initWindow();
 
     if (!window) return -1;
@@ -94,296 +64,71 @@ int main() {
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     Gui gui = Gui(window);
 
-    // ---  资源加载 ---
-    Texture wallTex = Texture("textures/wall.jpg");
-    Texture brickWallTex = Texture("textures/brickwall.jpg");
-    Texture brickWallNormalTex = Texture("textures/brickwall_normal.jpg");
-
-    Texture whiteTex = Texture("textures/white.png");
-    Texture rustedIronBaseTex = Texture("textures/rustediron1-alt2-bl/rustediron2_basecolor.png");
-    Texture rustedIronNormalTex = Texture("textures/rustediron1-alt2-bl/rustediron2_normal.png");
-    Texture rustedIronMetalTex = Texture("textures/rustediron1-alt2-bl/rustediron2_metallic.png");
-    Texture rustedIronRoughTex = Texture("textures/rustediron1-alt2-bl/rustediron2_roughness.png");
-
-    Shader shader("shaders/shader.vert", "shaders/toon_shader.frag");
-    Shader pbrShader("shaders/shader.vert", "shaders/pbr_shader.frag");
-    Shader outlineShader("shaders/outline.vert", "shaders/outline.frag");
-    Shader screenShader("shaders/screen.vert", "shaders/screen.frag");
-    Shader lightCubeShader("shaders/light_cube.vert", "shaders/light_cube.frag");
-    Shader skyboxShader("shaders/skybox.vert", "shaders/skybox.frag");
-    Shader simpleDepthShader("shaders/simpleDepthShader.vert", "shaders/simpleDepthShader.frag");
-    Shader blurShader("shaders/blur.vert", "shaders/blur.frag");
-    //天空盒
-    vector<string> faces = {
-        "textures/skybox/right.jpg",
-        "textures/skybox/left.jpg",
-        "textures/skybox/top.jpg",
-        "textures/skybox/bottom.jpg",
-        "textures/skybox/front.jpg",
-        "textures/skybox/back.jpg"
-    };
-    Shader reflectionShader("shaders/reflection.vert", "shaders/reflection.frag");
-    reflectionShader.use();
-    reflectionShader.setInt("skybox", 0); // 天空盒通常绑在 0 号纹理位
-    // 这一步会自动加载纹理并配置 VAO
-    Skybox skybox(faces);
-    ScreenQuad screenQuad = ScreenQuad();// 设置 Shader 的 uniform
-    skyboxShader.use();
-    skyboxShader.setInt("skybox", 0);
-
-    // 6. 【核心步骤】加载模型
-    Model ourModel("objects/TDA/TDA.pmx");
-    Model YYBModel("objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx");
-    Model cubeModel("objects/cube.obj");
-    Model sphereModel("objects/sphere.obj");
-    Model floorModel("objects/floor.obj");
-    RenderObject tianyi(&ourModel);
-    RenderObject YYB(&YYBModel);
-    RenderObject light(&cubeModel);
-    RenderObject sphere(&sphereModel);
-    RenderObject floor(&floorModel,brickWallTex.ID,brickWallNormalTex.ID);
-    floor.scale = glm::vec3(10.0f, 1.0f, 10.0f);
-    floor.uvScale = glm::vec2(20.0f);
-
-    tianyi.scale = glm::vec3(0.2f);
-    light.position = lightData.position;
-    YYB.scale = glm::vec3(0.2f);
-    YYB.position = glm::vec3(3.0f, 0.0f, 0.0f);
-
-    UBO matricesUBO(2 * sizeof(glm::mat4), 0);
-    UBO lightUBO(sizeof(LightBlockData), 1);
-
-    // 配置帧缓冲 (Framebuffer)
-    unsigned int framebuffer;
-    unsigned int colorBuffers[2];
-    unsigned int depthMapFBO;
-    unsigned int depthMap;
-    configFrameBuffer(framebuffer, colorBuffers);
-    initShadowMap(depthMapFBO, depthMap);
-    // --- Ping-Pong FBO 初始化 ---
-    unsigned int pingpongFBO[2];
-    unsigned int pingpongColorbuffers[2];
-    glGenFramebuffers(2, pingpongFBO);
-    glGenTextures(2, pingpongColorbuffers);
-    for (unsigned int i = 0; i < 2; i++)
+    // 场景资源和所有 pass 都在 Renderer 里，这里只负责窗口、输入和 GUI
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    // 录制要在 Renderer 建资源之前开始
+    if (!startCapture(argc, argv)) return -1;
+    // Renderer、上传线程和模拟放在块里：GL 资源要在 glfwTerminate 之前、上下文还在的时候析构
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
-        glBindTexture(GL_TEXTURE_2D, pingpongColorbuffers[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pingpongColorbuffers[i], 0);
-
-        // 检查完整性...
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-            cout << "PingPong FBO not complete!" << endl;
-    }
-
-    // 开启混合
-    glEnable(GL_BLEND);
-    // 设置混合方程式：SrcAlpha * SrcColor + (1 - SrcAlpha) * DestColor
-    // 翻译：新颜色的浓度取决于它的透明度，剩下的浓度留给背景色
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    // 7. 渲染循环
-    while (!glfwWindowShouldClose(window))
-    {
-        glEnable(GL_DEPTH_TEST);
-        gui.BeginFrame();
-
-        // 时间
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-
-        // 输入
-        processInput(window);
-
-        // 设置 View/Projection 矩阵
-        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-        glm::mat4 view = camera.GetViewMatrix();
-        // transform
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.0f)); // 放在原点
-        model = glm::scale(model, glm::vec3(0.1));	// 缩放 (如果模型太大或太小，调这里)
-
-        // 配置UBO
-        matricesUBO.SetMat4(0, projection);
-        matricesUBO.SetMat4(sizeof(glm::mat4), view);
-
-        LightBlockData allLightsData{};
-        allLightsData.pointLights[0] = lightData; // 你的 lightData 变量应该改为 PointLightData 类型
-
-        // 填充后 3 个光源 (固定位置光源)
-        for(int i = 1; i < 4; i++)
-        {
-            allLightsData.pointLights[i].position  = glm::vec4(lightPoses[i], 0.0f);
-            allLightsData.pointLights[i].ambient   = glm::vec4(lightColors[i] * 0.1f, 0.0f);
-            allLightsData.pointLights[i].diffuse   = glm::vec4(lightColors[i], 0.0f);
-            allLightsData.pointLights[i].specular  = glm::vec4(lightColors[i], 0.0f);
-            allLightsData.pointLights[i].constant  = 1.0f;
-            allLightsData.pointLights[i].linear    = 0.09f;
-            allLightsData.pointLights[i].quadratic = 0.032f;
-            allLightsData.pointLights[i].padding  = 0.0f;
+        Renderer renderer(framebufferWidth, framebufferHeight);
+        // 后台上传线程：一个隐藏的、和主窗口共享对象的 GLFW 窗口提供它的上下文 (窗口只能在主线程上建)
+        // 录 GL 命令流时不开，流式加载退回同步
+        GLFWwindow* uploadWindow = nullptr;
+        std::unique_ptr<UploadService> uploads;
+        if (!GlCapture::Get().Recording()) {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            uploadWindow = glfwCreateWindow(1, 1, "Upload", NULL, window);
+            glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
         }
-        lightUBO.SetData(0, sizeof(LightBlockData), &allLightsData);
-        // 清屏
-        glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-        // ====================================================
-        // 阴影帧
-        // ====================================================
-        // 2. 正交投影 (覆盖场景范围)
-        float near_plane = 0.1f, far_plane = 10.5f;
-        // 这里的数值决定了阴影覆盖的范围，太小会导致远处没阴影，太大导致精度低
-        glm::mat4 lightProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, near_plane, far_plane);
-        // 3. View 矩阵 (从光的位置看向原点)
-        glm::mat4 lightView = glm::lookAt(glm::vec3(lightData.position), glm::vec3(0.0f), glm::vec3(0.0, 1.0, 0.0));
-        // 4. 合成光照空间矩阵
-        glm::mat4 lightSpaceMatrix = lightProjection * lightView;
-        // 步骤 1: 渲染阴影贴图 (Shadow Map Pass)
-        // 1. 改变视口大小 (对应阴影贴图分辨率)
-        glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-        glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
-        glClear(GL_DEPTH_BUFFER_BIT); // 只清深度
-
-        // 2. 使用深度 Shader
-        simpleDepthShader.use();
-        simpleDepthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
-        simpleDepthShader.setMat4("model", model);
-
-        // 【重要】MMD 模型通常有很多单面网格。为了防止背面产生错误阴影（Peter Panning），
-        // 渲染阴影贴图时，我们通常剔除正面 (只画背面)，或者不剔除。
-        // 对于 Toon Shading，先试试不剔除
-        glDisable(GL_CULL_FACE);
-        tianyi.Draw(simpleDepthShader);
-        floor.Draw(simpleDepthShader);
-
-        // ==============================================
-        // 第 1 遍 (Pass 1): 渲染描边
-        // ==============================================
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-        // 清屏
-        glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-        glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
-
-        outlineShader.use();
-        outlineShader.setFloat("outlineWidth", 0.2f); // 稍微调一点点宽度
-        outlineShader.setVec3("color",glm::vec3(0.3f));
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_FRONT);
-        tianyi.Draw(outlineShader);
-        YYB.Draw(outlineShader);
-
-        // ==============================================
-        // 第 2 遍 (Pass 2): 正常渲染 Toon 模型
-        // ==============================================
-        shader.use();
-        glDisable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        shader.setFloat("material.shininess", 256.0f);
-        shader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
-        // 3. 绑定阴影贴图
-        glActiveTexture(GL_TEXTURE10);
-        glBindTexture(GL_TEXTURE_2D, depthMap);
-        tianyi.Draw(shader);
-        YYB.Draw(shader);
-
-        // ------------------------------------------------
-        // 绘制反射箱子
-        // ------------------------------------------------
-        // reflectionShader.setVec3("cameraPos", camera.Position);
-        // ourModel.DrawAt(glm::vec3(-2.0f, 1.0f, 0.0f),reflectionShader);
-
-        // ------------------------------------------------
-        // pbr
-        // ------------------------------------------------
-        pbrShader.setVec3("viewPos", camera.Position);
-
-        // --- 1. Albedo (Diffsue) ---
-        rustedIronBaseTex.bind(0);
-        pbrShader.setInt("material.texture_diffuse1", 0);
-        // --- 2. Normal ---
-        rustedIronNormalTex.bind(1);
-        pbrShader.setInt("material.texture_normal1", 1);
-        pbrShader.setBool("useNormalMap", true);
-        // --- 3. Metallic ---
-        rustedIronMetalTex.bind(2);   // 建议给 Texture 类加 bind 方法统一调用
-        pbrShader.setInt("metallicMap", 2);
-        // --- 4. Roughness ---
-        rustedIronRoughTex.bind(3);
-        pbrShader.setInt("roughnessMap", 3);
-        // --- 5. AO (Ambient Occlusion) ---
-        // 使用白色纹理代替 AO，防止模型变黑
-        whiteTex.bind(4);
-        pbrShader.setInt("aoMap", 4);
-        // 4. 设置纹理缩放
-        // 假设球体比较小，不需要像地板那样重复纹理，设为 1.0
-        pbrShader.setVec2("uvScale", glm::vec2(1.0f));
-
-        sphere.position = glm::vec3(-3.0f, 1.0f, 0.0f);
-        sphere.scale = glm::vec3(1.0f);
-        sphere.Draw(pbrShader);
-
-        // ==============================================
-        // 天空盒  光源  地板
-        // ==============================================
-        skybox.Draw(skyboxShader, view, projection);
-        light.position = lightData.position;
-        lightCubeShader.use();
-        for(auto & pointLight : allLightsData.pointLights) {
-            light.position = pointLight.position; // 隐式转换 vec4 -> vec3 (取前3个分量)
-            lightCubeShader.setVec3("color", glm::vec3(pointLight.diffuse));
-            light.Draw(lightCubeShader);
+        if (uploadWindow) {
+            UploadContext uploadContext;
+            uploadContext.makeCurrent = [uploadWindow]() { glfwMakeContextCurrent(uploadWindow); return true; };
+            uploadContext.release = []() { glfwMakeContextCurrent(nullptr); };
+            uploads = std::make_unique<UploadService>(uploadContext);
+            renderer.SetUploadService(uploads.get());
         }
-        floor.Draw(shader);
-
-        // ==============================================
-        // 后处理
-        // ==============================================
-        // ... 高斯模糊处理 ...
-        bool horizontal = true, first_iteration = true;
-        blurShader.use();
-
-        for (unsigned int i = 0; i < postProcessingData.amount; i++)
+        Simulation sim(Camera(glm::vec3(0.0f, 2.0f, 3.0f)), renderer.lightData);
+        simulation = &sim;
+        // 7. 渲染循环
+        while (!glfwWindowShouldClose(window))
         {
-            // 绑定当前要写入的 FBO (0 或 1)
-            glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
-            blurShader.setInt("horizontal", horizontal);
-
-            // 第一次循环读 colorBuffers[1] (提取出的高亮)，之后读对方的 pingpongBuffer
-            glBindTexture(GL_TEXTURE_2D, first_iteration ? colorBuffers[1] : pingpongColorbuffers[!horizontal]);
-
-            screenQuad.Draw(); // 画个四边形进行模糊计算
-
-            horizontal = !horizontal; // 切换方向
-            if (first_iteration) first_iteration = false;
-        }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // 清屏
-
-        screenShader.use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, colorBuffers[0]); // 场景原图
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, pingpongColorbuffers[!horizontal]); // 模糊后的光晕图 (取最后一次写入的那个)
-
-        screenShader.setInt("scene", 0);
-        screenShader.setInt("bloomBlur", 1);
-        screenShader.setFloat("exposure", postProcessingData.exposure);
-        screenShader.setFloat("gamma", postProcessingData.gamma);
-
-        screenQuad.Draw();
-
-        if (isCursorVisible) { // 只有鼠标显示的时候才画 UI，或者一直画
-            gui.DrawPanel(lightData,postProcessingData);
+            gui.BeginFrame();
+            renderer.Resize(framebufferWidth, framebufferHeight);
+
+            // 时间
+            float currentFrame = static_cast<float>(glfwGetTime());
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+
+            // 输入：推给模拟，不开模拟线程时在这里按帧时间走一步
+            sim.Apply(simulationSettings);
+            processInput(window);
+            sim.Advance(deltaTime);
+
+            // 拿最新的快照来画。GUI 刚改过光源、模拟还没用上的时候先用自己改的那份，免得闪回去
+            const SceneSnapshot& snapshot = sim.Acquire(simulationSettings.lateLatch);
+            Camera frameCamera = snapshot.camera;
+            if (snapshot.lightRevision == sim.LightRevision()) renderer.lightData = snapshot.light;
+            PointLightData shownLight = renderer.lightData;
+
+            // 画到默认帧缓冲
+            renderer.RenderFrame(frameCamera, deltaTime);
+
+            if (isCursorVisible) { // 只有鼠标显示的时候才画 UI，或者一直画
+                if (renderer.postProcessingData.autoExposure) renderer.autoExposure.ReadResult();
+                gui.DrawPanel(renderer,simulationSettings,sim.Stats(),uploads ? uploads->Stats() : UploadStats());
+                if (memcmp(&shownLight, &renderer.lightData, sizeof(PointLightData)) != 0) sim.SetLight(renderer.lightData);
+            }
+            gui.EndFrame();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
         }
-        gui.EndFrame();
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        GlCapture::Get().Finish();
+        // 上传线程先把排着的做完、放开它的上下文，再删隐藏窗口
+        renderer.SetUploadService(nullptr);
+        uploads.reset();
+        if (uploadWindow) glfwDestroyWindow(uploadWindow);
+        simulation = nullptr;
     }
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -392,7 +137,31 @@ int main() {
     return 0;
 }
 
+// main --capture out.glcap [--capture-start N] [--capture-frames N]
+// 从第 N 帧开始录 GL 命令流 (glCapture.h)，用 main_replay 离线回放
+bool startCapture(int argc, char** argv) {
+    string path;
+    int start = 60, frames = 1; // 默认跳过开头一秒，等自动曝光 / 阴影缓存稳定
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--capture") == 0 && hasValue) path = argv[++i];
+        else if (strcmp(argv[i], "--capture-start") == 0 && hasValue) start = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--capture-frames") == 0 && hasValue) frames = atoi(argv[++i]);
+        else {
+            cout << "Usage: " << argv[0] << " [--capture out.glcap] [--capture-start N] [--capture-frames N]" << endl;
+            return false;
+        }
+    }
+    if (path.empty()) return true;
+    if (start < 0 || frames <= 0) {
+        cout << "ERROR::CAPTURE:: Invalid capture frame range" << endl;
+        return false;
+    }
+    return GlCapture::Get().Start(path, start, frames, 0, framebufferWidth, framebufferHeight);
+}
+
 // --- 键盘输入处理 ---
+// 窗口相关的 (退出、切换鼠标) 直接处理，移动摄像机和光源的键交给模拟
 void processInput(GLFWwindow *window)
 {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -417,45 +186,23 @@ void processInput(GLFWwindow *window)
         altPressedLastFrame = false;
     }
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        camera.ProcessKeyboard(FORWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        camera.ProcessKeyboard(BACKWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        camera.ProcessKeyboard(LEFT, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        camera.ProcessKeyboard(RIGHT, deltaTime);
-
-
-    // ==============================================
-    // 光源控制逻辑
-    // ==============================================
-    float lightSpeed = 5.0f * deltaTime; // 光源移动速度
-
-    // X轴移动 (左/右)
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-        lightData.position.x -= lightSpeed;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        lightData.position.x += lightSpeed;
-
-    // Z轴移动 (上/下)
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-        lightData.position.z -= lightSpeed;
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-        lightData.position.z += lightSpeed;
-
-    // Y轴移动 (垂直升降) - 使用 Right Shift 和 Right Control
-    if (glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
-        lightData.position.y += lightSpeed;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
-        lightData.position.y -= lightSpeed;
+    // 顺序和 SimulationKey 一致：WASD 移动摄像机，方向键在水平面上移动光源，Right Shift / Right Control 升降光源
+    static const int keyMap[SIM_KEY_COUNT] = {
+        GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D,
+        GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_UP, GLFW_KEY_DOWN,
+        GLFW_KEY_RIGHT_SHIFT, GLFW_KEY_RIGHT_CONTROL
+    };
+    unsigned int keys = 0;
+    for (int i = 0; i < SIM_KEY_COUNT; i++)
+        if (glfwGetKey(window, keyMap[i]) == GLFW_PRESS) keys |= 1u << i;
+    simulation->SetKeys(keys);
 }
 
 // --- 鼠标移动回调 ---
 void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
 {
     // 如果鼠标可见（在调参数），就不要旋转摄像机
-    if (isCursorVisible) return;
+    if (isCursorVisible || !simulation) return;
 
     float xpos = static_cast<float>(xposIn);
     float ypos = static_cast<float>(yposIn);
@@ -473,15 +220,15 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
     lastX = xpos;
     lastY = ypos;
 
-    camera.ProcessMouseMovement(xoffset, yoffset);
+    simulation->AddMouse(xoffset, yoffset);
 }
 
 // --- 鼠标滚轮回调 ---
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     // 如果鼠标可见，也别缩放
-    if (isCursorVisible) return;
-    camera.ProcessMouseScroll(static_cast<float>(yoffset));
+    if (isCursorVisible || !simulation) return;
+    simulation->AddScroll(static_cast<float>(yoffset));
 }
 
 GLFWwindow* initWindow() {
@@ -508,73 +255,3 @@ GLFWwindow* initWindow() {
     cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
     return window;
 }
-
-// 修改函数签名，传入一个数组或者两个引用
-void configFrameBuffer(unsigned int &framebuffer, unsigned int* colorBuffers) {
-    glGenFramebuffers(1, &framebuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
-    glGenTextures(2, colorBuffers); // 生成 2 个纹理
-
-    for (unsigned int i = 0; i < 2; i++)
-    {
-        glBindTexture(GL_TEXTURE_2D, colorBuffers[i]);
-        // 必须用 GL_RGBA16F 浮点格式
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        // 防止模糊时边缘发光，设为 CLAMP_TO_EDGE
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        // 把纹理附加到 Framebuffer
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, colorBuffers[i], 0);
-    }
-
-    // 2. 深度缓冲 (RBO) 保持不变
-    unsigned int rbo;
-    glGenRenderbuffers(1, &rbo);
-    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
-
-    // 【核心】告诉 OpenGL 我们要渲染到这两个附件上
-    unsigned int attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
-    glDrawBuffers(2, attachments);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-        cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << endl;
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-};
-
-void initShadowMap(unsigned int& depthMapFBO, unsigned int& depthMap){
-    // 1. 创建 FBO
-    glGenFramebuffers(1, &depthMapFBO);
-
-    // 2. 创建深度纹理
-    glGenTextures(1, &depthMap);
-    glBindTexture(GL_TEXTURE_2D, depthMap);
-    // 注意：这里格式是 GL_DEPTH_COMPONENT
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-
-    // 设置过滤参数
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // 设置环绕参数：超出范围的地方不做阴影 (设为白色，深度 1.0)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    float borderColor[] = { 1.0, 1.0, 1.0, 1.0 };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-    // 3. 把纹理附加到 FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
-
-    // 显式告诉 OpenGL：我们不需要任何颜色数据！
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-}
\ No newline at end of file
@@ -0,0 +1,511 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "camera.h"
+#include "renderer.h"
+#include "headlessContext.h"
+#include "benchStats.h"
+#include "sceneGenerator.h"
+#include "resourceTracker.h"
+#include "jobSystem.h"
+
+using namespace std;
+
+// ==========================================================
+// 脚本化基准测试：同一个场景、同一条摄像机 / 光源路径、固定帧间隔，每次跑的画面完全一样，
+// 不同提交之间的结果可以直接 diff
+//   main_bench [--frames N] [--warmup N] [--width W] [--height H] [--json out.json] [--csv out.csv]
+//              [--objects N --lights M --materials K --seed S --characters R]
+//              [--sweep objects|lights|materials|threads --values 10,100,1000] [--memory memory.json]
+//              [--threads N] [--direct]
+// 给了 --objects / --lights / --materials / --sweep 就用生成的压力测试场景 (sceneGenerator.h)，否则用默认场景。
+// 光源数要在 1 ~ MAX_POINT_LIGHTS 之间，材质数至少 1，超出范围直接报错 (不会悄悄夹住)
+// --sweep 时每个值重新生成一次场景跑一遍，CSV / JSON 里每个值一条汇总，用来画随数量增长的曲线
+// 每帧记录：
+//   cpu  : RenderFrame 本身 (提交命令) 的墙钟时间
+//   wall : RenderFrame + glFinish，也就是这一帧从开始到 GPU 做完
+//   gpu  : 整帧 GPU 时间戳差，外加每块 pass 的 GPU 时间
+// 每帧都 glFinish，GPU 时间正好对应这一帧 (正常运行时不会这样同步，所以 wall 比交互时的帧时间偏大)
+// --memory 在跑完之后 (渲染器还没析构) 把显存 / 内存记账 (resourceTracker.h) 写出来
+// --threads N 用 N 个线程 (N - 1 个工作线程 + 主线程) 并行录制场景的 draw 包 (commandBuffer.h)，默认是全局任务系统；
+// --direct 关掉录制，逐个物体直接提交。--sweep threads 看 CPU 帧时间随线程数的变化，比如
+//   main_bench --objects 10000 --sweep threads --values 1,2,4,8
+// 有 EGL 就无窗口跑，否则开一个隐藏的 GLFW 窗口。必须在 LearnOpenGL 目录下运行
+// ==========================================================
+
+const float FIXED_DELTA_TIME = 1.0f / 60.0f;
+const float CAMERA_ORBIT_SECONDS = 10.0f; // 摄像机绕一圈的时间
+const float LIGHT_ORBIT_SECONDS = 4.0f;   // 主光源绕一圈的时间
+
+struct BenchOptions {
+    int frames = 600;
+    int warmup = 30;
+    int width = 1920;
+    int height = 1080;
+    string json;
+    string csv;
+    string memory;                 // 显存 / 内存记账输出
+    bool generated = false;        // 用生成的场景
+    SceneGeneratorSettings scene;
+    string sweep;                  // objects / lights / materials / threads，空 = 不扫
+    vector<int> sweepValues;
+    int threads = 0;               // 录制用的线程数，0 = 全局任务系统
+    bool direct = false;           // 不录制，直接提交
+};
+
+struct FrameSample {
+    double cpuMs = 0.0;
+    double wallMs = 0.0;
+    double gpuMs = 0.0;
+    double passMs[PASS_COUNT] = {};
+    GlFrameStats gl;               // 只有 ENTRO_GL_STATS 编译进来时才有数
+};
+
+// 扫描中的一个点：参数值 + 这一遍的所有帧
+struct SweepPoint {
+    int value = 0;
+    vector<FrameSample> samples;
+};
+
+bool parseArgs(int argc, char** argv, BenchOptions& options);
+GLFWwindow* initHiddenWindow(int width, int height);
+vector<FrameSample> runFrames(Renderer& renderer, const BenchOptions& options, unsigned int outputFBO);
+void applyPath(float time, float radius, Camera& camera, Renderer& renderer);
+void writeCSV(const string& path, const vector<FrameSample>& samples);
+void writeJSON(const string& path, const BenchOptions& options, const vector<FrameSample>& samples);
+void writeSweepCSV(const string& path, const BenchOptions& options, const vector<SweepPoint>& points);
+void writeSweepJSON(const string& path, const BenchOptions& options, const vector<SweepPoint>& points);
+void printSummary(const vector<FrameSample>& samples);
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+#ifdef ENTRO_HAS_EGL
+    HeadlessContext context(options.width, options.height);
+    if (!context.Valid()) return 1;
+    unsigned int outputFBO = context.Framebuffer();
+#else
+    GLFWwindow* window = initHiddenWindow(options.width, options.height);
+    if (!window) return -1;
+    unsigned int outputFBO = 0;
+#endif
+
+    vector<FrameSample> samples;
+    vector<SweepPoint> points;
+    unique_ptr<JobSystem> jobSystem;
+    {
+        Renderer renderer(options.width, options.height);
+        // 动态分辨率会跟着帧时间变，固定全分辨率才能比较
+        renderer.dynamicResolution.settings.enabled = false;
+        renderer.recording.enabled = !options.direct;
+        // 任务系统要活得比 renderer 长 (析构顺序和声明相反)，所以放在外面的 unique_ptr 里换
+        if (options.threads > 0) {
+            jobSystem = make_unique<JobSystem>(options.threads - 1);
+            renderer.SetJobSystem(*jobSystem);
+        }
+
+        if (!options.sweep.empty()) {
+            for (int value : options.sweepValues) {
+                SceneGeneratorSettings scene = options.scene;
+                if (options.sweep == "objects") scene.objects = value;
+                else if (options.sweep == "lights") scene.lights = value;
+                else if (options.sweep == "materials") scene.materials = value;
+                if (options.sweep == "threads") {
+                    // 先换掉 renderer 手里的指针，再销毁旧的任务系统
+                    renderer.SetJobSystem(JobSystem::Get());
+                    jobSystem = make_unique<JobSystem>(value - 1);
+                    renderer.SetJobSystem(*jobSystem);
+                }
+                renderer.GenerateScene(scene);
+                cout << options.sweep << " = " << value << endl;
+                SweepPoint point;
+                point.value = value;
+                point.samples = runFrames(renderer, options, outputFBO);
+                printSummary(point.samples);
+                points.push_back(std::move(point));
+            }
+        } else {
+            if (options.generated) renderer.GenerateScene(options.scene);
+            samples = runFrames(renderer, options, outputFBO);
+            printSummary(samples);
+        }
+
+        ResourceTracker& tracker = ResourceTracker::Get();
+        cout << fixed << setprecision(1) << "Memory: GPU " << tracker.GpuBytes() / (1024.0 * 1024.0)
+             << " MB (peak " << tracker.PeakGpuBytes() / (1024.0 * 1024.0) << "), CPU "
+             << tracker.CpuBytes() / (1024.0 * 1024.0) << " MB (peak " << tracker.PeakCpuBytes() / (1024.0 * 1024.0) << ")" << endl;
+        if (!options.memory.empty()) tracker.Dump(options.memory);
+    }
+
+    if (!options.sweep.empty()) {
+        if (!options.csv.empty()) writeSweepCSV(options.csv, options, points);
+        if (!options.json.empty()) writeSweepJSON(options.json, options, points);
+    } else {
+        if (!options.csv.empty()) writeCSV(options.csv, samples);
+        if (!options.json.empty()) writeJSON(options.json, options, samples);
+    }
+
+#ifndef ENTRO_HAS_EGL
+    glfwTerminate();
+#endif
+    return 0;
+}
+
+vector<FrameSample> runFrames(Renderer& renderer, const BenchOptions& options, unsigned int outputFBO) {
+    // 生成的场景比默认场景大，摄像机轨道跟着放大
+    const GeneratedScene* scene = renderer.Scene();
+    float radius = scene ? scene->extent * 0.6f : 6.0f;
+    Camera camera(glm::vec3(0.0f, 2.0f, 3.0f));
+    vector<FrameSample> samples;
+    samples.reserve(options.frames);
+    for (int frame = 0; frame < options.warmup + options.frames; frame++) {
+        applyPath(frame * FIXED_DELTA_TIME, radius, camera, renderer);
+        auto start = chrono::steady_clock::now();
+        renderer.RenderFrame(camera, FIXED_DELTA_TIME, outputFBO);
+        auto submitted = chrono::steady_clock::now();
+        glFinish();
+        auto finished = chrono::steady_clock::now();
+        renderer.CollectTimings();
+        if (frame < options.warmup) continue;
+
+        FrameSample sample;
+        sample.cpuMs = chrono::duration<double, milli>(submitted - start).count();
+        sample.wallMs = chrono::duration<double, milli>(finished - start).count();
+        sample.gpuMs = renderer.frameMs;
+        for (int i = 0; i < PASS_COUNT; i++) sample.passMs[i] = renderer.passMs[i];
+        sample.gl = GlStats::Get().LastFrame();
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+// 摄像机绕场景中心转圈并上下起伏，主光源在角色头顶转圈，只和时间有关
+void applyPath(float time, float radius, Camera& camera, Renderer& renderer) {
+    const glm::vec3 target(0.0f, 1.0f, 0.0f);
+    float cameraAngle = glm::radians(360.0f * time / CAMERA_ORBIT_SECONDS);
+    float height = radius / 3.0f;
+    camera.Position = glm::vec3(radius * cos(cameraAngle), height + 0.5f * sin(2.0f * cameraAngle), radius * sin(cameraAngle));
+    glm::vec3 direction = glm::normalize(target - camera.Position);
+    camera.Yaw = glm::degrees(atan2(direction.z, direction.x));
+    camera.Pitch = glm::degrees(asin(direction.y));
+    camera.ProcessMouseMovement(0.0f, 0.0f); // 只为了按新的 Yaw / Pitch 重新算 Front
+
+    float lightAngle = glm::radians(360.0f * time / LIGHT_ORBIT_SECONDS);
+    renderer.lightData.position = glm::vec4(3.0f * cos(lightAngle), 5.0f, 3.0f * sin(lightAngle), 0.0f);
+}
+
+// GeneratedScene 会把超出范围的数量夹住 (sceneGenerator.h)，而 JSON / CSV 里写的是请求的值，
+// 所以超出范围的直接拒绝，保证结果里的数量就是实际跑的
+static bool validCount(const string& what, int value) {
+    if (what == "objects") return value >= 0;
+    if (what == "lights") return value >= 1 && value <= MAX_POINT_LIGHTS;
+    return value >= 1;   // materials / threads
+}
+
+static bool checkCount(const string& what, int value) {
+    if (validCount(what, value)) return true;
+    cout << "ERROR::BENCH:: Invalid " << what << " count " << value;
+    if (what == "lights") cout << " (1 ~ " << MAX_POINT_LIGHTS << ")";
+    cout << endl;
+    return false;
+}
+
+bool parseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue) options.frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue) options.warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && hasValue) options.width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && hasValue) options.height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue) options.csv = argv[++i];
+        else if (strcmp(argv[i], "--memory") == 0 && hasValue) options.memory = argv[++i];
+        else if (strcmp(argv[i], "--objects") == 0 && hasValue) { options.scene.objects = atoi(argv[++i]); options.generated = true; }
+        else if (strcmp(argv[i], "--lights") == 0 && hasValue) { options.scene.lights = atoi(argv[++i]); options.generated = true; }
+        else if (strcmp(argv[i], "--materials") == 0 && hasValue) { options.scene.materials = atoi(argv[++i]); options.generated = true; }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) options.scene.seed = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        else if (strcmp(argv[i], "--characters") == 0 && hasValue) options.scene.characterRatio = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--sweep") == 0 && hasValue) options.sweep = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) options.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--direct") == 0) options.direct = true;
+        else if (strcmp(argv[i], "--values") == 0 && hasValue) {
+            // 逗号分隔的整数列表
+            for (const char* p = argv[++i]; *p;) {
+                char* end = nullptr;
+                options.sweepValues.push_back(static_cast<int>(strtol(p, &end, 10)));
+                if (end == p) break;
+                p = *end == ',' ? end + 1 : end;
+            }
+        }
+        else {
+            cout << "Usage: " << argv[0] << " [--frames N] [--warmup N] [--width W] [--height H]"
+                 << " [--json out.json] [--csv out.csv]"
+                 << " [--objects N] [--lights M] [--materials K] [--seed S] [--characters R]"
+                 << " [--sweep objects|lights|materials|threads --values a,b,c] [--memory out.json]"
+                 << " [--threads N] [--direct]" << endl;
+            return false;
+        }
+    }
+    if (options.threads < 0) {
+        cout << "ERROR::BENCH:: Invalid thread count" << endl;
+        return false;
+    }
+    if (options.frames <= 0 || options.warmup < 0 || options.width <= 0 || options.height <= 0) {
+        cout << "ERROR::BENCH:: Invalid frame count or size" << endl;
+        return false;
+    }
+    if (!checkCount("objects", options.scene.objects) || !checkCount("lights", options.scene.lights) ||
+        !checkCount("materials", options.scene.materials))
+        return false;
+    if (!options.sweep.empty()) {
+        if (options.sweep != "objects" && options.sweep != "lights" && options.sweep != "materials" && options.sweep != "threads") {
+            cout << "ERROR::BENCH:: --sweep must be objects, lights, materials or threads" << endl;
+            return false;
+        }
+        for (int value : options.sweepValues)
+            if (!checkCount(options.sweep, value)) return false;
+        if (options.sweepValues.empty()) {
+            cout << "ERROR::BENCH:: --sweep needs --values" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// 每帧一行，方便画图
+void writeCSV(const string& path, const vector<FrameSample>& samples) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << "frame,cpu_ms,wall_ms,gpu_ms";
+    for (int i = 0; i < PASS_COUNT; i++) file << "," << RenderPassName(i) << "_ms";
+    if (GlStats::Compiled) file << ",gl_draw,gl_state,gl_uniform,gl_upload,gl_upload_bytes";
+    file << "\n" << fixed << setprecision(4);
+    for (size_t f = 0; f < samples.size(); f++) {
+        const FrameSample& s = samples[f];
+        file << f << "," << s.cpuMs << "," << s.wallMs << "," << s.gpuMs;
+        for (int i = 0; i < PASS_COUNT; i++) file << "," << s.passMs[i];
+        if (GlStats::Compiled) {
+            for (int c = 0; c < GLSTAT_CATEGORY_COUNT; c++) file << "," << s.gl.CategoryTotal(c);
+            file << "," << s.gl.bufferBytes + s.gl.textureBytes;
+        }
+        file << "\n";
+    }
+}
+
+static void writeStats(ostream& out, const SampleStats& stats) {
+    out << "{\"mean\": " << stats.mean << ", \"min\": " << stats.min << ", \"max\": " << stats.max
+        << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << "}";
+}
+
+template <typename Getter>
+static SampleStats statsOf(const vector<FrameSample>& samples, Getter getter) {
+    vector<double> values;
+    values.reserve(samples.size());
+    for (const FrameSample& s : samples) values.push_back(getter(s));
+    return SampleStats::Compute(values);
+}
+
+// GL 调用统计：每类调用 / 上传字节数的每帧统计，每个入口的平均次数，每个 pass 每类的平均次数
+static void writeGlJSON(ostream& out, const vector<FrameSample>& samples) {
+    out << "  \"gl\": {\n";
+    for (int c = 0; c < GLSTAT_CATEGORY_COUNT; c++) {
+        out << "    \"" << GlStatCategoryName(c) << "\": ";
+        writeStats(out, statsOf(samples, [c](const FrameSample& s) { return static_cast<double>(s.gl.CategoryTotal(c)); }));
+        out << ",\n";
+    }
+    out << "    \"buffer_bytes\": ";
+    writeStats(out, statsOf(samples, [](const FrameSample& s) { return static_cast<double>(s.gl.bufferBytes); }));
+    out << ",\n    \"texture_bytes\": ";
+    writeStats(out, statsOf(samples, [](const FrameSample& s) { return static_cast<double>(s.gl.textureBytes); }));
+    out << ",\n    \"entry_points\": {";
+    bool first = true;
+    for (int i = 0; i < GLSTAT_COUNT; i++) {
+        double mean = statsOf(samples, [i](const FrameSample& s) { return static_cast<double>(s.gl.calls[i]); }).mean;
+        if (mean == 0.0) continue;
+        out << (first ? "" : ", ") << "\"" << GlStatCallName(i) << "\": " << mean;
+        first = false;
+    }
+    out << "},\n    \"passes\": {";
+    first = true;
+    const GlFrameStats& names = samples.empty() ? GlFrameStats() : samples.back().gl;
+    for (int pass = 0; pass <= GlFrameStats::MAX_PASSES; pass++) {
+        if (!names.passNames[pass]) continue;
+        out << (first ? "" : ", ") << "\"" << names.passNames[pass] << "\": {";
+        for (int c = 0; c < GLSTAT_CATEGORY_COUNT; c++) {
+            double mean = statsOf(samples, [pass, c](const FrameSample& s) { return static_cast<double>(s.gl.passCalls[pass][c]); }).mean;
+            out << "\"" << GlStatCategoryName(c) << "\": " << mean << (c + 1 < GLSTAT_CATEGORY_COUNT ? ", " : "");
+        }
+        out << "}";
+        first = false;
+    }
+    out << "}\n  },\n";
+}
+
+static void writeSceneJSON(ostream& out, const BenchOptions& options) {
+    if (!options.generated && options.sweep.empty()) {
+        out << "  \"scene\": \"default\",\n";
+        return;
+    }
+    const SceneGeneratorSettings& scene = options.scene;
+    out << "  \"scene\": {\"seed\": " << scene.seed << ", \"objects\": " << scene.objects
+        << ", \"lights\": " << scene.lights << ", \"materials\": " << scene.materials
+        << ", \"character_ratio\": " << scene.characterRatio << "},\n";
+}
+
+// 录制方式和线程数 (扫线程数时每个点的线程数就是 value)
+static void writeRecordingJSON(ostream& out, const BenchOptions& options) {
+    int threads = options.threads > 0 ? options.threads : JobSystem::Get().WorkerCount() + 1;
+    out << "  \"recording\": \"" << (options.direct ? "direct" : "parallel") << "\",\n";
+    if (options.sweep != "threads") out << "  \"threads\": " << threads << ",\n";
+}
+
+// 汇总：运行配置 + 每个指标的平均值 / 极值 / 百分位
+void writeJSON(const string& path, const BenchOptions& options, const vector<FrameSample>& samples) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << fixed << setprecision(4);
+    file << "{\n";
+    file << "  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n";
+    file << "  \"version\": \"" << glGetString(GL_VERSION) << "\",\n";
+    file << "  \"width\": " << options.width << ",\n";
+    file << "  \"height\": " << options.height << ",\n";
+    file << "  \"frames\": " << samples.size() << ",\n";
+    file << "  \"warmup\": " << options.warmup << ",\n";
+    writeSceneJSON(file, options);
+    writeRecordingJSON(file, options);
+    if (GlStats::Compiled) writeGlJSON(file, samples);
+    file << "  \"cpu_ms\": ";
+    writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.cpuMs; }));
+    file << ",\n  \"wall_ms\": ";
+    writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.wallMs; }));
+    file << ",\n  \"gpu_ms\": ";
+    writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.gpuMs; }));
+    file << ",\n  \"passes\": {\n";
+    for (int i = 0; i < PASS_COUNT; i++) {
+        file << "    \"" << RenderPassName(i) << "\": ";
+        writeStats(file, statsOf(samples, [i](const FrameSample& s) { return s.passMs[i]; }));
+        file << (i + 1 < PASS_COUNT ? ",\n" : "\n");
+    }
+    file << "  }\n}\n";
+}
+
+// 扫描：每个值一行，主要看中位数和尾部
+void writeSweepCSV(const string& path, const BenchOptions& options, const vector<SweepPoint>& points) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << options.sweep << ",cpu_p50_ms,cpu_p95_ms,wall_p50_ms,gpu_p50_ms,gpu_p95_ms,gpu_p99_ms";
+    for (int i = 0; i < PASS_COUNT; i++) file << "," << RenderPassName(i) << "_p50_ms";
+    file << "\n" << fixed << setprecision(4);
+    for (const SweepPoint& point : points) {
+        SampleStats cpu = statsOf(point.samples, [](const FrameSample& s) { return s.cpuMs; });
+        SampleStats wall = statsOf(point.samples, [](const FrameSample& s) { return s.wallMs; });
+        SampleStats gpu = statsOf(point.samples, [](const FrameSample& s) { return s.gpuMs; });
+        file << point.value << "," << cpu.p50 << "," << cpu.p95 << "," << wall.p50 << ","
+             << gpu.p50 << "," << gpu.p95 << "," << gpu.p99;
+        for (int i = 0; i < PASS_COUNT; i++)
+            file << "," << statsOf(point.samples, [i](const FrameSample& s) { return s.passMs[i]; }).p50;
+        file << "\n";
+    }
+}
+
+void writeSweepJSON(const string& path, const BenchOptions& options, const vector<SweepPoint>& points) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << fixed << setprecision(4);
+    file << "{\n";
+    file << "  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n";
+    file << "  \"width\": " << options.width << ",\n";
+    file << "  \"height\": " << options.height << ",\n";
+    file << "  \"frames\": " << options.frames << ",\n";
+    file << "  \"warmup\": " << options.warmup << ",\n";
+    writeSceneJSON(file, options);
+    writeRecordingJSON(file, options);
+    file << "  \"sweep\": \"" << options.sweep << "\",\n";
+    file << "  \"points\": [\n";
+    for (size_t p = 0; p < points.size(); p++) {
+        const vector<FrameSample>& samples = points[p].samples;
+        file << "    {\"value\": " << points[p].value << ", \"cpu_ms\": ";
+        writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.cpuMs; }));
+        file << ", \"wall_ms\": ";
+        writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.wallMs; }));
+        file << ", \"gpu_ms\": ";
+        writeStats(file, statsOf(samples, [](const FrameSample& s) { return s.gpuMs; }));
+        file << ", \"passes\": {";
+        for (int i = 0; i < PASS_COUNT; i++) {
+            file << "\"" << RenderPassName(i) << "\": ";
+            writeStats(file, statsOf(samples, [i](const FrameSample& s) { return s.passMs[i]; }));
+            if (i + 1 < PASS_COUNT) file << ", ";
+        }
+        file << "}}" << (p + 1 < points.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+}
+
+void printSummary(const vector<FrameSample>& samples) {
+    cout << fixed << setprecision(3);
+    cout << left << setw(16) << "ms" << setw(10) << "mean" << setw(10) << "p50"
+         << setw(10) << "p95" << setw(10) << "p99" << endl;
+    auto row = [](const char* name, const SampleStats& stats) {
+        cout << left << setw(16) << name << setw(10) << stats.mean << setw(10) << stats.p50
+             << setw(10) << stats.p95 << setw(10) << stats.p99 << endl;
+    };
+    row("cpu", statsOf(samples, [](const FrameSample& s) { return s.cpuMs; }));
+    row("wall", statsOf(samples, [](const FrameSample& s) { return s.wallMs; }));
+    row("gpu", statsOf(samples, [](const FrameSample& s) { return s.gpuMs; }));
+    for (int i = 0; i < PASS_COUNT; i++)
+        row(RenderPassName(i), statsOf(samples, [i](const FrameSample& s) { return s.passMs[i]; }));
+    if (!GlStats::Compiled) return;
+    cout << left << setw(16) << "gl calls/frame" << endl;
+    for (int c = 0; c < GLSTAT_CATEGORY_COUNT; c++)
+        row(GlStatCategoryName(c), statsOf(samples, [c](const FrameSample& s) { return static_cast<double>(s.gl.CategoryTotal(c)); }));
+    row("upload KB", statsOf(samples, [](const FrameSample& s) { return (s.gl.bufferBytes + s.gl.textureBytes) / 1024.0; }));
+}
+
+// 没有 EGL 时的退路：隐藏窗口，只是为了拿到 GL 上下文，画到它的默认帧缓冲
+GLFWwindow* initHiddenWindow(int width, int height) {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(width, height, "EntroRenderer Bench", NULL, NULL);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        cout << "Failed to initialize GLAD" << endl;
+        return nullptr;
+    }
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    return window;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include "shader.h"
+#include "screenQuad.h"
+#include "blurKernel.h"
+#include "computeBlur.h"
+
+using namespace std;
+
+// ==========================================================
+// 模糊微基准：不同分辨率 / 半径下三种可分离高斯的 GPU 耗时
+//   frag    : blur.frag，每个纹素单独读 (原来的做法)
+//   folded  : blur.frag，相邻纹素合并成一次双线性采样
+//   compute : blur.comp，共享内存分块
+// 每种都是 水平 + 垂直 两遍算一次，结果是 ITERATIONS 次的平均值
+// 用 glFinish 前后的墙钟时间而不是时间查询：有的驱动 (比如软件光栅) 对计算着色器不报 GL_TIME_ELAPSED
+// ==========================================================
+
+const int ITERATIONS = 20;
+const int WARMUP = 3;
+const int MAX_FRAG_TAPS = 33; // 和 blur.frag 里的 MAX_TAPS 一致
+
+struct Resolution {
+    int width, height;
+};
+
+GLFWwindow* initWindow();
+unsigned int createTarget(int width, int height, const vector<float>* data);
+unsigned int createFBO(unsigned int texture);
+
+// 阻塞等 GPU 做完：基准测试里不在乎停顿，只要数字准
+template <typename Func>
+double timeGpu(Func&& func) {
+    for (int i = 0; i < WARMUP; i++) func();
+    glFinish();
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) func();
+    glFinish();
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+int main() {
+    GLFWwindow* window = initWindow();
+    if (!window) return -1;
+
+    Shader blurShader("shaders/blur.vert", "shaders/blur.frag");
+    ScreenQuad screenQuad;
+    ComputeBlur computeBlur;
+
+    const Resolution resolutions[] = { {1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160} };
+    const int radii[] = { 2, 4, 8, 16, 32, 64 };
+
+    cout << "Separable Gaussian blur, ms per blur (H + V), average of " << ITERATIONS << " runs" << endl;
+    cout << "fetches = texture reads per pixel per direction" << endl;
+    cout << left << setw(12) << "resolution" << setw(8) << "radius"
+         << setw(18) << "frag (fetches)" << setw(18) << "folded (fetches)" << setw(12) << "compute" << endl;
+
+    mt19937 rng(42);
+    uniform_real_distribution<float> dist(0.0f, 4.0f);
+    for (const Resolution& res : resolutions) {
+        // 随机 HDR 噪声当输入，避免驱动对常量纹理走捷径
+        vector<float> noise(static_cast<size_t>(res.width) * res.height * 4);
+        for (float& v : noise) v = dist(rng);
+        unsigned int source = createTarget(res.width, res.height, &noise);
+        unsigned int pingpong[2] = { createTarget(res.width, res.height, nullptr), createTarget(res.width, res.height, nullptr) };
+        unsigned int pingpongFBO[2] = { createFBO(pingpong[0]), createFBO(pingpong[1]) };
+
+        for (int radius : radii) {
+            BlurKernel kernel = BlurKernel::Gaussian(radius);
+            BlurKernel folded = kernel.Folded();
+
+            auto fragmentBlur = [&](const BlurKernel& k) {
+                blurShader.use();
+                blurShader.setInt("image", 0);
+                blurShader.setInt("tapCount", k.TapCount());
+                blurShader.setFloatArray("offsets", k.offsets.data(), k.TapCount());
+                blurShader.setFloatArray("weights", k.weights.data(), k.TapCount());
+                glViewport(0, 0, res.width, res.height);
+                glActiveTexture(GL_TEXTURE0);
+                glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[0]);
+                blurShader.setInt("horizontal", 1);
+                glBindTexture(GL_TEXTURE_2D, source);
+                screenQuad.Draw();
+                glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[1]);
+                blurShader.setInt("horizontal", 0);
+                glBindTexture(GL_TEXTURE_2D, pingpong[0]);
+                screenQuad.Draw();
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            };
+
+            cout << left << setw(12) << (to_string(res.width) + "x" + to_string(res.height)) << setw(8) << radius;
+            cout << fixed << setprecision(3);
+            // 不合并时采样点超过 blur.frag 的上限就跳过
+            if (kernel.TapCount() <= MAX_FRAG_TAPS) {
+                double ms = timeGpu([&] { fragmentBlur(kernel); });
+                cout << setw(18) << (to_string(ms).substr(0, 6) + " (" + to_string(kernel.Fetches()) + ")");
+            } else {
+                cout << setw(18) << "-";
+            }
+            double foldedMs = timeGpu([&] { fragmentBlur(folded); });
+            cout << setw(18) << (to_string(foldedMs).substr(0, 6) + " (" + to_string(folded.Fetches()) + ")");
+            computeBlur.SetKernel(kernel);
+            double computeMs = timeGpu([&] { computeBlur.Blur(source, pingpong[1], res.width, res.height); });
+            cout << setw(12) << computeMs << endl;
+        }
+
+        glDeleteFramebuffers(2, pingpongFBO);
+        glDeleteTextures(2, pingpong);
+        glDeleteTextures(1, &source);
+    }
+
+    glfwTerminate();
+    return 0;
+}
+
+GLFWwindow* initWindow() {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // 不需要显示窗口，只要一个 GL 上下文
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(64, 64, "Blur Bench", NULL, NULL);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        cout << "Failed to initialize GLAD" << endl;
+        return nullptr;
+    }
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    cout << "Renderer: " << glGetString(GL_RENDERER) << endl;
+    return window;
+}
+
+// RGBA16F 目标 (计算着色器的 image 格式要求)
+unsigned int createTarget(int width, int height, const vector<float>* data) {
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+    if (data)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, data->data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+unsigned int createFBO(unsigned int texture) {
+    unsigned int fbo;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        cout << "ERROR::FRAMEBUFFER:: Bench framebuffer is not complete!" << endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return fbo;
+}
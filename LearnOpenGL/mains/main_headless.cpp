@@ -0,0 +1,108 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "camera.h"
+#include "renderer.h"
+#include "headlessContext.h"
+#include "goldenImage.h"
+#include "glCapture.h"
+
+using namespace std;
+
+// ==========================================================
+// 无窗口渲染：不需要显示器 / GLFW 窗口，在 CI 或者只有 Mesa llvmpipe 的机器上也能跑整条管线
+// 用固定的摄像机和固定的帧间隔画 N 帧，打印耗时，最后一帧可以存成 PPM
+//   main_headless [--frames N] [--width W] [--height H] [--out frame.ppm]
+//                 [--capture out.glcap --capture-start N --capture-frames N]
+// 软件光栅可以这样跑：LIBGL_ALWAYS_SOFTWARE=1 ./main_headless --frames 10 --out frame.ppm
+// --capture 录下第 N 帧起的 GL 命令流 (glCapture.h)，用 main_replay 回放
+// 必须在 LearnOpenGL 目录下运行 (资源是相对路径)
+// ==========================================================
+
+const float FIXED_DELTA_TIME = 1.0f / 60.0f; // 固定帧间隔，自动曝光的适应每次跑都一样
+
+struct HeadlessOptions {
+    int frames = 60;
+    int width = 1280;
+    int height = 720;
+    string out;
+    string capture;
+    int captureStart = 10;
+    int captureFrames = 1;
+};
+
+bool parseArgs(int argc, char** argv, HeadlessOptions& options);
+
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+#ifndef ENTRO_HAS_EGL
+    cout << "ERROR::HEADLESS:: Built without EGL, headless rendering is not available" << endl;
+    return 1;
+#else
+    HeadlessContext context(options.width, options.height);
+    if (!context.Valid()) return 1;
+    // 录制要在 Renderer 建资源之前开始
+    if (!options.capture.empty()
+        && !GlCapture::Get().Start(options.capture, options.captureStart, options.captureFrames,
+                                   context.Framebuffer(), context.Width(), context.Height()))
+        return 1;
+
+    {
+        Renderer renderer(options.width, options.height);
+        // 无窗口时没有垂直同步，动态分辨率按实际帧时间调会让每次结果都不一样，固定全分辨率
+        renderer.dynamicResolution.settings.enabled = false;
+        Camera camera(glm::vec3(0.0f, 2.0f, 3.0f));
+
+        double totalMs = 0.0;
+        for (int frame = 0; frame < options.frames; frame++) {
+            auto start = chrono::steady_clock::now();
+            renderer.RenderFrame(camera, FIXED_DELTA_TIME, context.Framebuffer());
+            glFinish();
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            totalMs += elapsed.count();
+        }
+        cout << fixed << setprecision(3)
+             << options.frames << " frames at " << options.width << "x" << options.height
+             << ", average " << (options.frames > 0 ? totalMs / options.frames : 0.0) << " ms/frame" << endl;
+
+        if (!options.out.empty()) {
+            vector<unsigned char> pixels;
+            context.ReadPixels(pixels);
+            if (!WritePPM(options.out, Image::FromGL(pixels, context.Width(), context.Height()))) return 1;
+            cout << "Wrote " << options.out << endl;
+        }
+    }
+    GlCapture::Get().Finish();
+    return 0;
+#endif
+}
+
+bool parseArgs(int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue) options.frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && hasValue) options.width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && hasValue) options.height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) options.out = argv[++i];
+        else if (strcmp(argv[i], "--capture") == 0 && hasValue) options.capture = argv[++i];
+        else if (strcmp(argv[i], "--capture-start") == 0 && hasValue) options.captureStart = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--capture-frames") == 0 && hasValue) options.captureFrames = atoi(argv[++i]);
+        else {
+            cout << "Usage: " << argv[0] << " [--frames N] [--width W] [--height H] [--out frame.ppm]"
+                 << " [--capture out.glcap] [--capture-start N] [--capture-frames N]" << endl;
+            return false;
+        }
+    }
+    if (options.frames < 0 || options.width <= 0 || options.height <= 0 || options.captureStart < 0 || options.captureFrames <= 0) {
+        cout << "ERROR::HEADLESS:: Invalid frame count or size" << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,304 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "jobSystem.h"
+#include "benchStats.h"
+#include "bounds.h"
+#include "stb_image.h"
+
+using namespace std;
+
+// ==========================================================
+// 任务系统 (jobSystem.h) 的扩展性测试：同样的工作量，用 1、2、4 ... 个线程各跑一遍，看加速比
+//   main_job_bench [--threads 1,2,4,8] [--runs N] [--objects N] [--jobs N] [--json out.json]
+// 线程数包括调用线程：N 个线程 = N - 1 个工作线程 + 主线程 (主线程在 Wait 时帮忙)
+// 工作量：
+//   transform_cull : 每个物体算模型矩阵、世界包围盒、视锥测试 (每帧 CPU 工作的样子)，ParallelFor 自动切块
+//   tiny_jobs      : 大量空任务，测每个任务的调度开销 (这一项不会随线程数变快，看的是绝对值)
+//   image_decode   : 内存里的天空盒 JPG 并行解码 (加载器的样子)，找不到图片就跳过
+//   job_graph      : 分层的依赖图，每层等上一层做完 (RunAfter)
+// 每项先跑一遍预热，再跑 --runs 遍取中位数。不需要 GL，在 LearnOpenGL 目录下运行才能找到图片
+// ==========================================================
+
+const char* SKYBOX_FACES[] = {
+    "textures/skybox/right.jpg", "textures/skybox/left.jpg", "textures/skybox/top.jpg",
+    "textures/skybox/bottom.jpg", "textures/skybox/front.jpg", "textures/skybox/back.jpg"
+};
+const int DECODE_COPIES = 4;       // 每遍解码每张图几次，凑够任务数
+const int GRAPH_LAYERS = 16;
+const int GRAPH_WIDTH = 64;        // 每层的任务数
+const int GRAPH_WORK = 20000;      // 每个任务的计算量 (循环次数)
+
+struct JobBenchOptions {
+    vector<int> threads;
+    int runs = 7;
+    int objects = 200000;
+    int jobs = 100000;             // tiny_jobs 的任务数
+    string json;
+};
+
+struct Workload {
+    string name;
+    function<double(JobSystem&)> run;  // 返回值只是为了不让编译器把计算优化掉
+};
+
+struct WorkloadResult {
+    string workload;
+    int threads = 1;
+    SampleStats ms;
+    double speedup = 1.0;
+    double efficiency = 1.0;
+    double stolenRatio = 0.0;      // 被偷走执行的任务比例
+};
+
+// 物体的输入和输出分开放，每个任务只写自己那一段
+struct ObjectData {
+    vector<glm::vec3> positions;
+    vector<glm::vec3> rotations;   // 欧拉角 (弧度)
+    vector<float> scales;
+    vector<glm::mat4> models;
+    vector<unsigned char> visible;
+};
+
+bool parseArgs(int argc, char** argv, JobBenchOptions& options);
+ObjectData makeObjects(int count);
+vector<vector<unsigned char>> loadFiles();
+vector<Workload> makeWorkloads(const JobBenchOptions& options, ObjectData& objects, const vector<vector<unsigned char>>& images);
+void writeJSON(const string& path, const JobBenchOptions& options, const vector<WorkloadResult>& results);
+
+int main(int argc, char** argv) {
+    JobBenchOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    ObjectData objects = makeObjects(options.objects);
+    vector<vector<unsigned char>> images = loadFiles();
+    if (images.empty()) cout << "Skybox images not found, skipping image_decode (run from the LearnOpenGL directory)" << endl;
+    vector<Workload> workloads = makeWorkloads(options, objects, images);
+
+    cout << "Hardware threads: " << thread::hardware_concurrency() << ", runs: " << options.runs << endl;
+    cout << left << setw(16) << "workload" << right << setw(8) << "threads" << setw(12) << "p50 ms"
+         << setw(12) << "min ms" << setw(10) << "speedup" << setw(12) << "efficiency" << setw(10) << "stolen" << endl;
+
+    vector<WorkloadResult> results;
+    volatile double sink = 0.0;   // 结果累加到这里，计算不会被优化掉
+    for (const Workload& workload : workloads) {
+        double baseline = 0.0;
+        for (int threads : options.threads) {
+            JobSystem jobs(threads - 1);
+            sink = sink + workload.run(jobs);   // 预热：线程启动、缓存、分配器
+            jobs.ResetStats();
+
+            vector<double> samples;
+            for (int run = 0; run < options.runs; run++) {
+                auto start = chrono::steady_clock::now();
+                sink = sink + workload.run(jobs);
+                samples.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+            }
+
+            WorkloadResult result;
+            result.workload = workload.name;
+            result.threads = threads;
+            result.ms = SampleStats::Compute(samples);
+            // 加速比相对于列表里的第一个线程数 (默认是 1)；效率 = 加速比 / 线程数的倍数
+            if (baseline == 0.0) baseline = result.ms.p50;
+            result.speedup = result.ms.p50 > 0.0 ? baseline / result.ms.p50 : 0.0;
+            result.efficiency = result.speedup * options.threads.front() / threads;
+            JobSystemStats stats = jobs.Stats();
+            result.stolenRatio = stats.executed ? static_cast<double>(stats.stolen) / stats.executed : 0.0;
+
+            cout << fixed << left << setw(16) << result.workload << right << setw(8) << threads << setprecision(3)
+                 << setw(12) << result.ms.p50 << setw(12) << result.ms.min << setprecision(2)
+                 << setw(10) << result.speedup << setw(11) << result.efficiency * 100.0 << "%"
+                 << setw(9) << result.stolenRatio * 100.0 << "%" << endl;
+            results.push_back(result);
+        }
+    }
+
+    if (!options.json.empty()) writeJSON(options.json, options, results);
+    return 0;
+}
+
+vector<Workload> makeWorkloads(const JobBenchOptions& options, ObjectData& objects, const vector<vector<unsigned char>>& images) {
+    vector<Workload> workloads;
+
+    workloads.push_back({ "transform_cull", [&objects](JobSystem& jobs) {
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 20.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Frustum frustum(projection * view);
+        AABB unitBox(glm::vec3(-0.5f), glm::vec3(0.5f));
+        int count = static_cast<int>(objects.positions.size());
+        jobs.ParallelForRange(0, count, 0, [&objects, &frustum, &unitBox](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), objects.positions[i]);
+                model = glm::rotate(model, objects.rotations[i].y, glm::vec3(0.0f, 1.0f, 0.0f));
+                model = glm::rotate(model, objects.rotations[i].x, glm::vec3(1.0f, 0.0f, 0.0f));
+                model = glm::scale(model, glm::vec3(objects.scales[i]));
+                objects.models[i] = model;
+                objects.visible[i] = frustum.Intersects(unitBox.Transformed(model)) ? 1 : 0;
+            }
+        });
+        double visible = 0.0;
+        for (unsigned char v : objects.visible) visible += v;
+        return visible;
+    } });
+
+    int jobCount = options.jobs;
+    workloads.push_back({ "tiny_jobs", [jobCount](JobSystem& jobs) {
+        JobCounter counter;
+        for (int i = 0; i < jobCount; i++) jobs.Run([]() {}, &counter);
+        jobs.Wait(counter);
+        return 0.0;
+    } });
+
+    if (!images.empty()) {
+        workloads.push_back({ "image_decode", [&images](JobSystem& jobs) {
+            int count = static_cast<int>(images.size()) * DECODE_COPIES;
+            vector<double> checksums(count, 0.0);
+            jobs.ParallelFor(0, count, 1, [&images, &checksums](int i) {
+                const vector<unsigned char>& file = images[i % images.size()];
+                int width, height, channels;
+                unsigned char* data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0);
+                if (!data) return;
+                checksums[i] = data[0] + width + height;
+                stbi_image_free(data);
+            });
+            double sum = 0.0;
+            for (double value : checksums) sum += value;
+            return sum;
+        } });
+    }
+
+    workloads.push_back({ "job_graph", [](JobSystem& jobs) {
+        // 每层的计数器：第 L 层的任务挂在第 L - 1 层上，每个任务读上一层的结果
+        vector<unique_ptr<JobCounter>> layers;
+        vector<vector<double>> values(GRAPH_LAYERS, vector<double>(GRAPH_WIDTH, 0.0));
+        for (int layer = 0; layer < GRAPH_LAYERS; layer++) {
+            layers.push_back(make_unique<JobCounter>());
+            for (int i = 0; i < GRAPH_WIDTH; i++) {
+                auto job = [&values, layer, i]() {
+                    double x = layer > 0 ? values[layer - 1][(i + 1) % GRAPH_WIDTH] : i;
+                    for (int k = 0; k < GRAPH_WORK; k++) x = x * 0.999999 + std::sin(x) * 1e-6;
+                    values[layer][i] = x;
+                };
+                if (layer == 0) jobs.Run(job, layers[layer].get());
+                else jobs.RunAfter(*layers[layer - 1], job, layers[layer].get());
+            }
+        }
+        for (auto& layer : layers) jobs.Wait(*layer);
+        double sum = 0.0;
+        for (double value : values.back()) sum += value;
+        return sum;
+    } });
+
+    return workloads;
+}
+
+ObjectData makeObjects(int count) {
+    ObjectData objects;
+    objects.positions.resize(count);
+    objects.rotations.resize(count);
+    objects.scales.resize(count);
+    objects.models.resize(count);
+    objects.visible.resize(count);
+    // 固定的伪随机分布，每次跑一样
+    unsigned int state = 12345u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < count; i++) {
+        objects.positions[i] = glm::vec3(next() * 400.0f - 200.0f, next() * 40.0f, next() * 400.0f - 200.0f);
+        objects.rotations[i] = glm::vec3(next() * 6.2832f, next() * 6.2832f, 0.0f);
+        objects.scales[i] = 0.5f + next() * 2.0f;
+    }
+    return objects;
+}
+
+vector<vector<unsigned char>> loadFiles() {
+    vector<vector<unsigned char>> files;
+    for (const char* path : SKYBOX_FACES) {
+        ifstream file(path, ios::binary);
+        if (!file) continue;
+        files.emplace_back((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    }
+    return files;
+}
+
+void writeJSON(const string& path, const JobBenchOptions& options, const vector<WorkloadResult>& results) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::JOB_BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << fixed << setprecision(4);
+    file << "{\n";
+    file << "  \"hardware_threads\": " << thread::hardware_concurrency() << ",\n";
+    file << "  \"runs\": " << options.runs << ",\n";
+    file << "  \"objects\": " << options.objects << ",\n";
+    file << "  \"jobs\": " << options.jobs << ",\n";
+    file << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const WorkloadResult& result = results[i];
+        file << "    {\"workload\": \"" << result.workload << "\", \"threads\": " << result.threads
+             << ", \"p50_ms\": " << result.ms.p50 << ", \"mean_ms\": " << result.ms.mean
+             << ", \"min_ms\": " << result.ms.min << ", \"max_ms\": " << result.ms.max
+             << ", \"speedup\": " << result.speedup << ", \"efficiency\": " << result.efficiency
+             << ", \"stolen_ratio\": " << result.stolenRatio << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+    cout << "Wrote " << path << endl;
+}
+
+bool parseArgs(int argc, char** argv, JobBenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            // 逗号分隔的整数列表
+            for (const char* p = argv[++i]; *p;) {
+                char* end = nullptr;
+                options.threads.push_back(static_cast<int>(strtol(p, &end, 10)));
+                if (end == p) break;
+                p = *end == ',' ? end + 1 : end;
+            }
+        }
+        else if (strcmp(argv[i], "--runs") == 0 && hasValue) options.runs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--objects") == 0 && hasValue) options.objects = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jobs") == 0 && hasValue) options.jobs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else {
+            cout << "Usage: " << argv[0] << " [--threads 1,2,4,8] [--runs N] [--objects N] [--jobs N] [--json out.json]" << endl;
+            return false;
+        }
+    }
+    // 默认：1, 2, 4 ... 一直到核数 (核数不是 2 的幂时最后再加上核数本身)
+    if (options.threads.empty()) {
+        int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+        for (int threads = 1; threads < cores; threads *= 2) options.threads.push_back(threads);
+        options.threads.push_back(cores);
+    }
+    for (int threads : options.threads) {
+        if (threads <= 0) {
+            cout << "ERROR::JOB_BENCH:: Invalid thread count" << endl;
+            return false;
+        }
+    }
+    if (options.runs <= 0 || options.objects < 0 || options.jobs < 0) {
+        cout << "ERROR::JOB_BENCH:: Invalid run, object or job count" << endl;
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,485 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+#include "model.h"
+#include "shader.h"
+#include "skybox.h"
+#include "headlessContext.h"
+#include "benchStats.h"
+#include "loadStats.h"
+#include "jobSystem.h"
+
+using namespace std;
+
+// ==========================================================
+// 资源加载基准测试：每个自带的资源反复加载，按阶段拆开时间和数据量
+//   parse (Assimp) / convert (processNode + processMesh) / decode (stbi_load) /
+//   upload (glTexImage2D) / mipmap (glGenerateMipmap) / shader (Shader 构造)
+//   main_load_bench [--runs N] [--cache cold|warm|both] [--assets TDA,YYB,...] [--json out.json] [--no-finish]
+//                   [--threads 1,2,4,8]
+// cold：每次加载前用 posix_fadvise(DONTNEED) 把资源文件踢出页缓存，测的是真正从磁盘读；
+//       踢不掉的页 (比如被别的进程 mmap 着) 会在输出里报出来。只有 Linux 支持，其他平台 cold = warm
+// warm：先加载一次热身，之后文件都在页缓存里
+// 默认 upload / mipmap 结束时 glFinish，记到的是驱动真正做完的时间；--no-finish 只记提交时间
+// 注意：Mesa 等驱动有磁盘上的着色器缓存，shader 阶段的 cold 也可能命中它，
+//       要测真正的编译时间就设 MESA_SHADER_CACHE_DISABLE=true
+// --threads 不再分 cold / warm，而是按线程数扫描网格转换 (Model 里并行的 convert 阶段)：
+//   每个线程数建一个任务系统 (N - 1 个工作线程 + 主线程)，warm 加载 --runs 次，报 convert 的时间和相对单线程的加速比；
+//   没给 --assets 时只跑 .pmx 模型
+// 有 EGL 就无窗口跑，否则开一个隐藏的 GLFW 窗口。必须在 LearnOpenGL 目录下运行
+// ==========================================================
+
+struct LoadBenchOptions {
+    int runs = 5;
+    bool cold = true;
+    bool warm = true;
+    bool finishGpu = true;
+    vector<string> assets;  // 空 = 全部
+    vector<int> threads;    // 非空 = 按线程数扫描 convert 阶段
+    string json;
+};
+
+// 一个资源：怎么加载，以及它读哪些文件 (冷缓存时要踢掉)
+// load 加载完、释放之前调用 loaded()，用来量加载后的内存
+struct BenchAsset {
+    string name;
+    string path;            // 主文件，不存在就跳过这个资源
+    vector<string> files;   // 文件或目录
+    function<void(const function<void()>& loaded)> load;
+};
+
+// 一次加载的结果
+struct LoadRun {
+    double totalMs = 0.0;
+    LoadStats stages;
+    long long rssDelta = 0; // 加载前后常驻内存的变化 (字节，释放之前量)
+};
+
+struct AssetResult {
+    string name;
+    vector<LoadRun> cold;
+    vector<LoadRun> warm;
+    double residentAfterEvict = 0.0; // cold 时踢完之后还留在页缓存里的比例
+    vector<pair<int, vector<LoadRun>>> threads; // --threads：每个线程数的 warm 加载
+};
+
+bool parseArgs(int argc, char** argv, LoadBenchOptions& options);
+GLFWwindow* initHiddenWindow();
+vector<BenchAsset> makeAssets();
+bool assetExists(const BenchAsset& asset);
+LoadRun loadOnce(const BenchAsset& asset);
+double evictFromCache(const vector<string>& roots);
+long long residentBytes();
+long long peakResidentBytes();
+void printResult(const AssetResult& result);
+void printThreadSweep(const AssetResult& result);
+vector<int> parseList(const string& list);
+void writeJSON(const string& path, const LoadBenchOptions& options, const vector<AssetResult>& results);
+
+int main(int argc, char** argv) {
+    LoadBenchOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+#ifdef ENTRO_HAS_EGL
+    HeadlessContext context(64, 64);
+    if (!context.Valid()) return 1;
+#else
+    GLFWwindow* window = initHiddenWindow();
+    if (!window) return -1;
+#endif
+
+    LoadProfiler& profiler = LoadProfiler::Get();
+    profiler.enabled = true;
+    profiler.finishGpu = options.finishGpu;
+
+    vector<AssetResult> results;
+    for (const BenchAsset& asset : makeAssets()) {
+        if (!options.assets.empty() && find(options.assets.begin(), options.assets.end(), asset.name) == options.assets.end())
+            continue;
+        bool pmx = asset.path.size() > 4 && asset.path.compare(asset.path.size() - 4, 4, ".pmx") == 0;
+        if (!options.threads.empty() && options.assets.empty() && !pmx) continue;
+        if (!assetExists(asset)) {
+            cout << "Skipping " << asset.name << ": files not found" << endl;
+            continue;
+        }
+        AssetResult result;
+        result.name = asset.name;
+        if (!options.threads.empty()) {
+            for (int threads : options.threads) {
+                JobSystem jobs(threads - 1);
+                Model::SetConversionJobSystem(&jobs);
+                loadOnce(asset); // 热身
+                vector<LoadRun> runs;
+                for (int run = 0; run < options.runs; run++) runs.push_back(loadOnce(asset));
+                Model::SetConversionJobSystem(nullptr);
+                result.threads.push_back({ threads, std::move(runs) });
+            }
+            printThreadSweep(result);
+            results.push_back(std::move(result));
+            continue;
+        }
+        if (options.cold) {
+            double resident = 0.0;
+            for (int run = 0; run < options.runs; run++) {
+                resident += evictFromCache(asset.files);
+                result.cold.push_back(loadOnce(asset));
+            }
+            result.residentAfterEvict = resident / options.runs;
+        }
+        if (options.warm) {
+            loadOnce(asset); // 热身：把文件读进页缓存
+            for (int run = 0; run < options.runs; run++) result.warm.push_back(loadOnce(asset));
+        }
+        printResult(result);
+        results.push_back(std::move(result));
+    }
+
+    cout << "Peak RSS " << fixed << setprecision(1) << peakResidentBytes() / (1024.0 * 1024.0) << " MiB" << endl;
+    if (!options.json.empty()) writeJSON(options.json, options, results);
+
+#ifndef ENTRO_HAS_EGL
+    glfwTerminate();
+#endif
+    return 0;
+}
+
+// 和 Renderer 里用到的资源一一对应
+vector<BenchAsset> makeAssets() {
+    auto model = [](const string& path) {
+        return [path](const function<void()>& loaded) {
+            Model model(path);
+            loaded();
+            model.Release();
+        };
+    };
+    vector<BenchAsset> assets;
+    assets.push_back({ "TDA", "objects/TDA/TDA.pmx", { "objects/TDA" }, model("objects/TDA/TDA.pmx") });
+    assets.push_back({ "YYB", "objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx", { "objects/YYB" },
+                       model("objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx") });
+    assets.push_back({ "backpack", "objects/backpack/backpack.obj", { "objects/backpack" }, model("objects/backpack/backpack.obj") });
+    assets.push_back({ "sphere", "objects/sphere.obj", { "objects/sphere.obj", "objects/sphere.mtl" }, model("objects/sphere.obj") });
+    assets.push_back({ "cube", "objects/cube.obj", { "objects/cube.obj" }, model("objects/cube.obj") });
+    assets.push_back({ "floor", "objects/floor.obj", { "objects/floor.obj" }, model("objects/floor.obj") });
+    assets.push_back({ "skybox", "textures/skybox/right.jpg", { "textures/skybox" }, [](const function<void()>& loaded) {
+        Skybox skybox(vector<string>{
+            "textures/skybox/right.jpg", "textures/skybox/left.jpg", "textures/skybox/top.jpg",
+            "textures/skybox/bottom.jpg", "textures/skybox/front.jpg", "textures/skybox/back.jpg" });
+        loaded();
+    } });
+    assets.push_back({ "shaders", "shaders/shader.vert", { "shaders" }, [](const function<void()>& loaded) {
+        static const char* pairs[][2] = {
+            { "shaders/shader.vert", "shaders/toon_shader.frag" },
+            { "shaders/shader.vert", "shaders/pbr_shader.frag" },
+            { "shaders/outline.vert", "shaders/outline.frag" },
+            { "shaders/light_cube.vert", "shaders/light_cube.frag" },
+            { "shaders/skybox.vert", "shaders/skybox.frag" },
+            { "shaders/pointShadowDepth.vert", "shaders/pointShadowDepth.frag" },
+            { "shaders/screen.vert", "shaders/ssOutline.frag" },
+            { "shaders/screen.vert", "shaders/upscale.frag" },
+            { "shaders/reflection.vert", "shaders/reflection.frag" },
+        };
+        vector<unsigned int> programs;
+        for (const auto& pair : pairs) programs.push_back(Shader(pair[0], pair[1]).ID);
+        loaded();
+        for (unsigned int program : programs) glDeleteProgram(program);
+    } });
+    return assets;
+}
+
+// 有的模型文件太大没有提交 (比如 backpack.obj)
+bool assetExists(const BenchAsset& asset) {
+    return filesystem::exists(asset.path);
+}
+
+LoadRun loadOnce(const BenchAsset& asset) {
+    LoadProfiler& profiler = LoadProfiler::Get();
+    profiler.stats.Reset();
+    glFinish();
+    long long rssBefore = residentBytes();
+    long long rssAfter = rssBefore;
+    auto start = chrono::steady_clock::now();
+    LoadRun run;
+    asset.load([&]() {
+        glFinish();
+        run.totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        run.stages = profiler.stats;
+        rssAfter = residentBytes();
+    });
+    run.rssDelta = rssAfter - rssBefore;
+    return run;
+}
+
+// 踢掉 roots 下所有文件的页缓存，返回踢完之后还在缓存里的页的比例 (用 mincore 检查)
+double evictFromCache(const vector<string>& roots) {
+#ifdef __linux__
+    vector<string> files;
+    for (const string& root : roots) {
+        if (filesystem::is_directory(root)) {
+            for (const auto& entry : filesystem::recursive_directory_iterator(root))
+                if (entry.is_regular_file()) files.push_back(entry.path().string());
+        } else {
+            files.push_back(root);
+        }
+    }
+    size_t totalPages = 0, residentPages = 0;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    for (const string& file : files) {
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        off_t size = lseek(fd, 0, SEEK_END);
+        if (size > 0) {
+            void* mapped = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                size_t pages = (size + pageSize - 1) / pageSize;
+                vector<unsigned char> residency(pages);
+                if (mincore(mapped, size, residency.data()) == 0) {
+                    totalPages += pages;
+                    for (unsigned char page : residency) residentPages += page & 1;
+                }
+                munmap(mapped, size);
+            }
+        }
+        close(fd);
+    }
+    return totalPages ? static_cast<double>(residentPages) / totalPages : 0.0;
+#else
+    (void)roots;
+    return 1.0;
+#endif
+}
+
+// 当前常驻内存 (/proc/self/statm 第二列是页数)
+long long residentBytes() {
+#ifdef __linux__
+    ifstream statm("/proc/self/statm");
+    long long size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+long long peakResidentBytes() {
+#ifdef __linux__
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long long>(usage.ru_maxrss) * 1024;
+#else
+    return 0;
+#endif
+}
+
+bool parseArgs(int argc, char** argv, LoadBenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--runs") == 0 && hasValue) options.runs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else if (strcmp(argv[i], "--no-finish") == 0) options.finishGpu = false;
+        else if (strcmp(argv[i], "--cache") == 0 && hasValue) {
+            string mode = argv[++i];
+            options.cold = mode == "cold" || mode == "both";
+            options.warm = mode == "warm" || mode == "both";
+            if (!options.cold && !options.warm) {
+                cout << "ERROR::LOADBENCH:: --cache must be cold, warm or both" << endl;
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--assets") == 0 && hasValue) {
+            // 逗号分隔的资源名
+            string list = argv[++i];
+            size_t begin = 0;
+            while (begin <= list.size()) {
+                size_t end = list.find(',', begin);
+                if (end == string::npos) end = list.size();
+                if (end > begin) options.assets.push_back(list.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = parseList(argv[++i]);
+            for (int threads : options.threads) {
+                if (threads <= 0) {
+                    cout << "ERROR::LOADBENCH:: Invalid thread count" << endl;
+                    return false;
+                }
+            }
+        }
+        else {
+            cout << "Usage: " << argv[0] << " [--runs N] [--cache cold|warm|both]"
+                 << " [--assets TDA,YYB,backpack,sphere,cube,floor,skybox,shaders] [--json out.json] [--no-finish]"
+                 << " [--threads 1,2,4,8]" << endl;
+            return false;
+        }
+    }
+    if (options.runs <= 0) {
+        cout << "ERROR::LOADBENCH:: Invalid run count" << endl;
+        return false;
+    }
+    return true;
+}
+
+// 逗号分隔的整数
+vector<int> parseList(const string& list) {
+    vector<int> values;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == string::npos) end = list.size();
+        if (end > begin) values.push_back(atoi(list.substr(begin, end - begin).c_str()));
+        begin = end + 1;
+    }
+    return values;
+}
+
+template <typename Getter>
+static SampleStats statsOf(const vector<LoadRun>& runs, Getter getter) {
+    vector<double> values;
+    values.reserve(runs.size());
+    for (const LoadRun& run : runs) values.push_back(getter(run));
+    return SampleStats::Compute(values);
+}
+
+static void printRuns(const char* mode, const vector<LoadRun>& runs) {
+    if (runs.empty()) return;
+    auto row = [](const string& name, const SampleStats& stats, double bytes) {
+        cout << "  " << left << setw(14) << name << setw(10) << stats.p50 << setw(10) << stats.min
+             << setw(10) << stats.max << setw(12) << bytes / (1024.0 * 1024.0) << endl;
+    };
+    cout << " " << mode << " (" << runs.size() << " runs)" << endl;
+    cout << "  " << left << setw(14) << "ms" << setw(10) << "p50" << setw(10) << "min"
+         << setw(10) << "max" << setw(12) << "MiB" << endl;
+    row("total", statsOf(runs, [](const LoadRun& r) { return r.totalMs; }),
+        static_cast<double>(runs.back().rssDelta));
+    for (int i = 0; i < LOAD_STAGE_COUNT; i++) {
+        if (runs.back().stages.count[i] == 0) continue;
+        row(LoadStageName(i), statsOf(runs, [i](const LoadRun& r) { return r.stages.ms[i]; }),
+            static_cast<double>(runs.back().stages.bytes[i]));
+    }
+}
+
+void printResult(const AssetResult& result) {
+    cout << fixed << setprecision(3) << result.name << endl;
+    printRuns("cold", result.cold);
+    if (!result.cold.empty() && result.residentAfterEvict > 0.1)
+        cout << "  WARNING: " << result.residentAfterEvict * 100.0 << "% of pages stayed cached after eviction" << endl;
+    printRuns("warm", result.warm);
+}
+
+// convert 阶段随线程数的变化，加速比相对第一个线程数
+void printThreadSweep(const AssetResult& result) {
+    cout << fixed << setprecision(3) << result.name << " (convert vs threads)" << endl;
+    cout << "  " << left << setw(10) << "threads" << setw(12) << "convert p50" << setw(10) << "min"
+         << setw(10) << "speedup" << setw(10) << "total p50" << endl;
+    double baseline = 0.0;
+    for (const auto& point : result.threads) {
+        SampleStats convert = statsOf(point.second, [](const LoadRun& r) { return r.stages.ms[LOAD_CONVERT]; });
+        SampleStats total = statsOf(point.second, [](const LoadRun& r) { return r.totalMs; });
+        if (baseline == 0.0) baseline = convert.p50;
+        cout << "  " << left << setw(10) << point.first << setw(12) << convert.p50 << setw(10) << convert.min
+             << setw(10) << (convert.p50 > 0.0 ? baseline / convert.p50 : 0.0) << setw(10) << total.p50 << endl;
+    }
+}
+
+static void writeStats(ostream& out, const SampleStats& stats) {
+    out << "{\"mean\": " << stats.mean << ", \"min\": " << stats.min << ", \"max\": " << stats.max
+        << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95 << "}";
+}
+
+static void writeRunsJSON(ostream& out, const vector<LoadRun>& runs) {
+    out << "{\"runs\": " << runs.size() << ", \"total_ms\": ";
+    writeStats(out, statsOf(runs, [](const LoadRun& r) { return r.totalMs; }));
+    out << ", \"rss_delta_bytes\": " << (runs.empty() ? 0 : runs.back().rssDelta) << ", \"stages\": {";
+    for (int i = 0; i < LOAD_STAGE_COUNT; i++) {
+        const LoadStats& last = runs.back().stages;
+        out << "\"" << LoadStageName(i) << "\": {\"count\": " << last.count[i] << ", \"bytes\": " << last.bytes[i] << ", \"ms\": ";
+        writeStats(out, statsOf(runs, [i](const LoadRun& r) { return r.stages.ms[i]; }));
+        out << "}" << (i + 1 < LOAD_STAGE_COUNT ? ", " : "");
+    }
+    out << "}}";
+}
+
+// 每个资源：cold / warm 各自的总时间和每个阶段的时间统计 + 数据量
+void writeJSON(const string& path, const LoadBenchOptions& options, const vector<AssetResult>& results) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::LOADBENCH:: Failed to open " << path << endl;
+        return;
+    }
+    file << fixed << setprecision(4);
+    file << "{\n";
+    file << "  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n";
+    file << "  \"version\": \"" << glGetString(GL_VERSION) << "\",\n";
+    file << "  \"runs\": " << options.runs << ",\n";
+    file << "  \"finish_gpu\": " << (options.finishGpu ? "true" : "false") << ",\n";
+    file << "  \"peak_rss_bytes\": " << peakResidentBytes() << ",\n";
+    file << "  \"assets\": [\n";
+    for (size_t a = 0; a < results.size(); a++) {
+        const AssetResult& result = results[a];
+        file << "    {\"name\": \"" << result.name << "\"";
+        if (!result.cold.empty()) {
+            file << ", \"resident_after_evict\": " << result.residentAfterEvict << ", \"cold\": ";
+            writeRunsJSON(file, result.cold);
+        }
+        if (!result.warm.empty()) {
+            file << ", \"warm\": ";
+            writeRunsJSON(file, result.warm);
+        }
+        if (!result.threads.empty()) {
+            file << ", \"threads\": [";
+            for (size_t t = 0; t < result.threads.size(); t++) {
+                file << (t ? ", " : "") << "{\"threads\": " << result.threads[t].first << ", \"load\": ";
+                writeRunsJSON(file, result.threads[t].second);
+                file << "}";
+            }
+            file << "]";
+        }
+        file << "}" << (a + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+}
+
+// 没有 EGL 时的退路：隐藏窗口，只是为了拿到 GL 上下文
+GLFWwindow* initHiddenWindow() {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(64, 64, "EntroRenderer Load Bench", NULL, NULL);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        cout << "Failed to initialize GLAD" << endl;
+        return nullptr;
+    }
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    return window;
+}
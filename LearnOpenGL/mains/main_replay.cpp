@@ -0,0 +1,214 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "headlessContext.h"
+#include "glCapture.h"
+#include "goldenImage.h"
+
+using namespace std;
+
+// ==========================================================
+// 回放 GL 命令流录制 (glCapture.h)：不需要资源文件、场景和输入，只有 GL 调用本身
+//   main_replay capture.glcap [--loops N] [--warmup N] [--finish] [--top N] [--csv calls.csv] [--out last.ppm]
+// 先执行一遍前导部分 (建资源 + 预热帧)，再把录下的帧循环 --warmup + --loops 遍，只统计后 --loops 遍：
+//   每帧墙钟时间；每个入口的调用次数和耗时 (调用返回为止的 CPU 时间，也就是驱动开销)；最慢的几次调用
+// --finish 每帧结束 glFinish，帧时间包含 GPU；否则只是提交的时间
+// --csv 每次调用一行 (loop, frame, index, call, us)，可以拿两次结果 diff 找变慢的调用
+// 录制：main --capture out.glcap 或 main_headless --capture out.glcap
+// ==========================================================
+
+struct ReplayOptions {
+    string capture;
+    int loops = 20;
+    int warmup = 2;
+    bool finish = false;
+    int top = 15;
+    string csv;
+    string out;
+};
+
+struct CallSummary {
+    int call = 0;
+    unsigned long long count = 0;
+    double totalUs = 0.0;
+    double maxUs = 0.0;
+};
+
+bool parseArgs(int argc, char** argv, ReplayOptions& options);
+GLFWwindow* initHiddenWindow(int width, int height);
+void writeCSV(const string& path, const vector<vector<GlReplaySample>>& loops);
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    GlReplay replay;
+    if (!replay.Load(options.capture)) return 1;
+    const GlCaptureHeader& header = replay.Header();
+
+#ifdef ENTRO_HAS_EGL
+    HeadlessContext context(header.width, header.height);
+    if (!context.Valid()) return 1;
+    unsigned int outputFBO = context.Framebuffer();
+#else
+    GLFWwindow* window = initHiddenWindow(header.width, header.height);
+    if (!window) return -1;
+    unsigned int outputFBO = 0;
+#endif
+
+    auto preludeStart = chrono::steady_clock::now();
+    if (!replay.RunPrelude(outputFBO)) return 1;
+    glFinish();
+    chrono::duration<double, milli> preludeMs = chrono::steady_clock::now() - preludeStart;
+    cout << fixed << setprecision(3) << options.capture << ": " << header.width << "x" << header.height
+         << ", prelude (setup + " << header.firstFrame << " frames) " << preludeMs.count() << " ms" << endl;
+
+    vector<vector<GlReplaySample>> loops;
+    vector<double> frameMs;
+    for (int loop = 0; loop < options.warmup + options.loops; loop++) {
+        bool measured = loop >= options.warmup;
+        vector<GlReplaySample> samples;
+        vector<double> loopFrameMs;
+        if (!replay.PlayFrames(options.finish, measured ? &samples : nullptr, loopFrameMs)) return 1;
+        if (!measured) continue;
+        frameMs.insert(frameMs.end(), loopFrameMs.begin(), loopFrameMs.end());
+        loops.push_back(std::move(samples));
+    }
+    glFinish();
+    if (frameMs.empty()) return 0;
+
+    // 每帧
+    double total = 0.0;
+    for (double ms : frameMs) total += ms;
+    cout << frameMs.size() << " frames" << (options.finish ? " (glFinish each frame)" : "")
+         << ": average " << total / frameMs.size() << " ms, min " << *min_element(frameMs.begin(), frameMs.end())
+         << " ms, max " << *max_element(frameMs.begin(), frameMs.end()) << " ms" << endl;
+
+    // 每个入口
+    vector<CallSummary> calls(CAPTURE_CALL_COUNT);
+    vector<GlReplaySample> slowest;
+    for (const vector<GlReplaySample>& samples : loops) {
+        for (const GlReplaySample& sample : samples) {
+            CallSummary& summary = calls[sample.call];
+            summary.call = sample.call;
+            summary.count++;
+            summary.totalUs += sample.us;
+            summary.maxUs = max(summary.maxUs, sample.us);
+        }
+        slowest.insert(slowest.end(), samples.begin(), samples.end());
+    }
+    sort(calls.begin(), calls.end(), [](const CallSummary& a, const CallSummary& b) { return a.totalUs > b.totalUs; });
+    double frames = static_cast<double>(frameMs.size());
+    cout << left << setw(26) << "call" << right << setw(12) << "calls/frame" << setw(12) << "us/frame"
+         << setw(10) << "avg us" << setw(10) << "max us" << endl;
+    for (const CallSummary& summary : calls) {
+        if (summary.count == 0) break;
+        cout << left << setw(26) << GlCaptureCallName(summary.call) << right << setprecision(1)
+             << setw(12) << summary.count / frames << setw(12) << summary.totalUs / frames
+             << setprecision(2) << setw(10) << summary.totalUs / summary.count << setw(10) << summary.maxUs << endl;
+    }
+
+    // 最慢的单次调用 (帧号 / 帧内序号对应录制时的位置)
+    size_t top = min(slowest.size(), static_cast<size_t>(max(options.top, 0)));
+    partial_sort(slowest.begin(), slowest.begin() + top, slowest.end(),
+                 [](const GlReplaySample& a, const GlReplaySample& b) { return a.us > b.us; });
+    if (top > 0) cout << "Slowest calls:" << endl;
+    for (size_t i = 0; i < top; i++)
+        cout << "  frame " << slowest[i].frame << " #" << slowest[i].index << "  " << left << setw(26)
+             << GlCaptureCallName(slowest[i].call) << right << setprecision(2) << slowest[i].us << " us" << endl;
+
+    if (!options.csv.empty()) writeCSV(options.csv, loops);
+
+    if (!options.out.empty()) {
+#ifdef ENTRO_HAS_EGL
+        vector<unsigned char> pixels;
+        context.ReadPixels(pixels);
+        if (!WritePPM(options.out, Image::FromGL(pixels, context.Width(), context.Height()))) return 1;
+        cout << "Wrote " << options.out << endl;
+#else
+        cout << "ERROR::REPLAY:: --out needs EGL" << endl;
+#endif
+    }
+
+#ifndef ENTRO_HAS_EGL
+    glfwTerminate();
+#endif
+    return 0;
+}
+
+void writeCSV(const string& path, const vector<vector<GlReplaySample>>& loops) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::REPLAY:: Failed to open " << path << endl;
+        return;
+    }
+    file << "loop,frame,index,call,us\n" << fixed << setprecision(3);
+    for (size_t loop = 0; loop < loops.size(); loop++)
+        for (const GlReplaySample& sample : loops[loop])
+            file << loop << "," << sample.frame << "," << sample.index << "," << GlCaptureCallName(sample.call)
+                 << "," << sample.us << "\n";
+    cout << "Wrote " << path << endl;
+}
+
+bool parseArgs(int argc, char** argv, ReplayOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--loops") == 0 && hasValue) options.loops = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue) options.warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--finish") == 0) options.finish = true;
+        else if (strcmp(argv[i], "--top") == 0 && hasValue) options.top = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue) options.csv = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) options.out = argv[++i];
+        else if (argv[i][0] != '-' && options.capture.empty()) options.capture = argv[i];
+        else {
+            options.capture.clear();
+            break;
+        }
+    }
+    if (options.capture.empty()) {
+        cout << "Usage: " << argv[0] << " capture.glcap [--loops N] [--warmup N] [--finish] [--top N]"
+             << " [--csv calls.csv] [--out last.ppm]" << endl;
+        return false;
+    }
+    if (options.loops <= 0 || options.warmup < 0) {
+        cout << "ERROR::REPLAY:: Invalid loop count" << endl;
+        return false;
+    }
+    return true;
+}
+
+// 没有 EGL 时的退路：隐藏窗口，回放画到它的默认帧缓冲
+GLFWwindow* initHiddenWindow(int width, int height) {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(width, height, "EntroRenderer Replay", NULL, NULL);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        cout << "Failed to initialize GLAD" << endl;
+        return nullptr;
+    }
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    return window;
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "camera.h"
+#include "renderer.h"
+#include "headlessContext.h"
+#include "benchStats.h"
+#include "uploadService.h"
+#include "modelStreamer.h"
+
+using namespace std;
+
+// ==========================================================
+// 流式加载基准测试：场景跑起来以后中途加载一个模型，看加载期间的帧时间有没有尖刺
+//   main_stream_bench [--model path] [--frames N] [--load-at K] [--mode sync|async|both]
+//                     [--width W] [--height H] [--json out.json]
+// sync ：没有上传服务，下一帧 RenderFrame 里整个加载 (和以前启动时加载一样)
+// async：上传线程 (uploadService.h) 在共享上下文里解析 + 解码 + 上传，渲染线程只等 fence、建 VAO
+// 每帧记 RenderFrame + glFinish 的墙钟时间，分三段汇总：
+//   before  : 请求之前 (基线)
+//   loading : 请求那一帧到模型 resident 的那一帧
+//   after   : resident 之后 (多了一个模型，会比基线慢一点)
+// spikes 是 loading 段里超过基线 p50 两倍的帧数。上传线程要真正和渲染并行需要至少两个核
+// 有 EGL 就无窗口跑，否则开两个隐藏的 GLFW 窗口。必须在 LearnOpenGL 目录下运行
+// ==========================================================
+
+const float FIXED_DELTA_TIME = 1.0f / 60.0f;
+
+struct StreamBenchOptions {
+    string model = "objects/YYB/YYB Hatsune Miku_10th_v1.02.pmx";
+    int frames = 300;
+    int loadAt = 60;               // 第几帧发请求
+    bool sync = true;
+    bool async = true;
+    int width = 1280;
+    int height = 720;
+    string json;
+};
+
+struct StreamRun {
+    string mode;
+    vector<double> frameMs;
+    int residentFrame = -1;        // 哪一帧开始时变成 resident，-1 = 跑完都没好
+    float loadMs = 0.0f, uploadMs = 0.0f, finalizeMs = 0.0f, residentMs = 0.0f;
+    SampleStats before, loading, after;
+    int spikes = 0;
+};
+
+bool parseArgs(int argc, char** argv, StreamBenchOptions& options);
+GLFWwindow* initHiddenWindow(int width, int height);
+StreamRun runStream(const StreamBenchOptions& options, UploadService* uploads, unsigned int outputFBO);
+void printRun(const StreamRun& run);
+void writeJSON(const string& path, const StreamBenchOptions& options, const vector<StreamRun>& runs);
+
+int main(int argc, char** argv) {
+    StreamBenchOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    UploadContext uploadContext;
+#ifdef ENTRO_HAS_EGL
+    HeadlessContext context(options.width, options.height);
+    if (!context.Valid()) return 1;
+    unsigned int outputFBO = context.Framebuffer();
+    if (options.async && context.CreateSharedContext()) {
+        uploadContext.makeCurrent = [&context]() { return context.MakeSharedCurrent(); };
+        uploadContext.release = [&context]() { context.ReleaseShared(); };
+    }
+#else
+    GLFWwindow* window = initHiddenWindow(options.width, options.height);
+    if (!window) return -1;
+    unsigned int outputFBO = 0;
+    GLFWwindow* uploadWindow = options.async ? glfwCreateWindow(1, 1, "Upload", NULL, window) : nullptr;
+    if (uploadWindow) {
+        uploadContext.makeCurrent = [uploadWindow]() { glfwMakeContextCurrent(uploadWindow); return true; };
+        uploadContext.release = []() { glfwMakeContextCurrent(nullptr); };
+    }
+#endif
+
+    vector<StreamRun> runs;
+    if (options.sync) runs.push_back(runStream(options, nullptr, outputFBO));
+    if (options.async) {
+        UploadService uploads(uploadContext);
+        if (!uploads.Valid()) {
+            cout << "ERROR::BENCH:: No shared upload context, skipping async" << endl;
+        } else {
+            runs.push_back(runStream(options, &uploads, outputFBO));
+            UploadStats stats = uploads.Stats();
+            cout << "Upload thread: " << stats.textures << " textures, " << stats.buffers << " buffers, "
+                 << fixed << setprecision(1) << stats.bytes / (1024.0 * 1024.0) << " MB, busy " << stats.busyMs << " ms" << endl;
+        }
+    }
+    for (const StreamRun& run : runs) printRun(run);
+    if (!options.json.empty()) writeJSON(options.json, options, runs);
+
+#ifndef ENTRO_HAS_EGL
+    if (uploadWindow) glfwDestroyWindow(uploadWindow);
+    glfwTerminate();
+#endif
+    return 0;
+}
+
+// 固定摄像机，默认场景；第 loadAt 帧发请求，之后每帧看它有没有 resident
+StreamRun runStream(const StreamBenchOptions& options, UploadService* uploads, unsigned int outputFBO) {
+    StreamRun run;
+    run.mode = uploads ? "async" : "sync";
+    cout << "Mode: " << run.mode << endl;
+
+    Renderer renderer(options.width, options.height);
+    renderer.dynamicResolution.settings.enabled = false;
+    renderer.SetUploadService(uploads);
+    Camera camera(glm::vec3(0.0f, 2.0f, 6.0f));
+    shared_ptr<StreamedModel> streamed;
+    for (int frame = 0; frame < options.frames; frame++) {
+        if (frame == options.loadAt) streamed = renderer.streamer.Load(options.model);
+        auto start = chrono::steady_clock::now();
+        renderer.RenderFrame(camera, FIXED_DELTA_TIME, outputFBO);
+        glFinish();
+        run.frameMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        renderer.CollectTimings();
+        if (streamed && run.residentFrame < 0) {
+            int state = streamed->state.load(memory_order_acquire);
+            if (state == STREAM_RESIDENT) run.residentFrame = frame;
+            else if (state == STREAM_FAILED) break;
+        }
+    }
+
+    int loadStart = min(options.loadAt, static_cast<int>(run.frameMs.size()));
+    int loadEnd = run.residentFrame < 0 ? static_cast<int>(run.frameMs.size()) : run.residentFrame + 1;
+    run.before = SampleStats::Compute(vector<double>(run.frameMs.begin(), run.frameMs.begin() + loadStart));
+    run.loading = SampleStats::Compute(vector<double>(run.frameMs.begin() + loadStart, run.frameMs.begin() + loadEnd));
+    run.after = SampleStats::Compute(vector<double>(run.frameMs.begin() + loadEnd, run.frameMs.end()));
+    for (int i = loadStart; i < loadEnd; i++)
+        if (run.frameMs[i] > 2.0 * run.before.p50) run.spikes++;
+    if (run.residentFrame >= 0) {
+        run.loadMs = streamed->loadMs;
+        run.uploadMs = streamed->uploadMs;
+        run.finalizeMs = streamed->finalizeMs;
+        run.residentMs = streamed->residentMs;
+    }
+    return run;
+}
+
+void printRun(const StreamRun& run) {
+    cout << fixed << setprecision(3);
+    cout << "== " << run.mode << " ==" << endl;
+    if (run.residentFrame < 0) cout << "Model never became resident" << endl;
+    else cout << "Resident after " << run.loading.count << " frames, " << run.residentMs << " ms (load " << run.loadMs
+              << ", upload " << run.uploadMs << ", finalize on render thread " << run.finalizeMs << ")" << endl;
+    cout << left << setw(10) << "ms" << setw(8) << "frames" << setw(10) << "p50" << setw(10) << "p99"
+         << setw(10) << "max" << endl;
+    auto row = [](const char* name, const SampleStats& stats) {
+        cout << left << setw(10) << name << setw(8) << stats.count << setw(10) << stats.p50 << setw(10) << stats.p99
+             << setw(10) << stats.max << endl;
+    };
+    row("before", run.before);
+    row("loading", run.loading);
+    row("after", run.after);
+    cout << "Spikes (> 2x baseline p50) while loading: " << run.spikes << endl;
+}
+
+void writeJSON(const string& path, const StreamBenchOptions& options, const vector<StreamRun>& runs) {
+    ofstream file(path);
+    if (!file) {
+        cout << "ERROR::BENCH:: Failed to open " << path << endl;
+        return;
+    }
+    auto stats = [&file](const char* name, const SampleStats& s) {
+        file << "      \"" << name << "\": { \"frames\": " << s.count << ", \"p50\": " << s.p50 << ", \"p99\": " << s.p99
+             << ", \"max\": " << s.max << " }";
+    };
+    file << fixed << setprecision(4);
+    file << "{\n";
+    file << "  \"model\": \"" << options.model << "\",\n";
+    file << "  \"frames\": " << options.frames << ",\n";
+    file << "  \"loadAt\": " << options.loadAt << ",\n";
+    file << "  \"runs\": [\n";
+    for (size_t r = 0; r < runs.size(); r++) {
+        const StreamRun& run = runs[r];
+        file << "    {\n";
+        file << "      \"mode\": \"" << run.mode << "\",\n";
+        file << "      \"residentFrame\": " << run.residentFrame << ",\n";
+        file << "      \"residentMs\": " << run.residentMs << ",\n";
+        file << "      \"loadMs\": " << run.loadMs << ",\n";
+        file << "      \"uploadMs\": " << run.uploadMs << ",\n";
+        file << "      \"finalizeMs\": " << run.finalizeMs << ",\n";
+        file << "      \"spikes\": " << run.spikes << ",\n";
+        stats("before", run.before);
+        file << ",\n";
+        stats("loading", run.loading);
+        file << ",\n";
+        stats("after", run.after);
+        file << ",\n";
+        file << "      \"frameMs\": [";
+        for (size_t i = 0; i < run.frameMs.size(); i++) file << (i ? ", " : "") << run.frameMs[i];
+        file << "]\n";
+        file << "    }" << (r + 1 < runs.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    cout << "Wrote " << path << endl;
+}
+
+bool parseArgs(int argc, char** argv, StreamBenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--model") == 0 && hasValue) options.model = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue) options.frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--load-at") == 0 && hasValue) options.loadAt = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && hasValue) options.width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && hasValue) options.height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else if (strcmp(argv[i], "--mode") == 0 && hasValue) {
+            string mode = argv[++i];
+            options.sync = mode == "sync" || mode == "both";
+            options.async = mode == "async" || mode == "both";
+            if (!options.sync && !options.async) {
+                cout << "ERROR::BENCH:: Unknown mode " << mode << endl;
+                return false;
+            }
+        } else {
+            cout << "Usage: " << argv[0] << " [--model path] [--frames N] [--load-at K] [--mode sync|async|both]"
+                 << " [--width W] [--height H] [--json out.json]" << endl;
+            return false;
+        }
+    }
+    if (options.frames <= 0 || options.loadAt < 0 || options.width <= 0 || options.height <= 0) {
+        cout << "ERROR::BENCH:: Invalid options" << endl;
+        return false;
+    }
+    return true;
+}
+
+// 没有 EGL 时的退路：隐藏窗口，只是为了拿到 GL 上下文，画到它的默认帧缓冲
+GLFWwindow* initHiddenWindow(int width, int height) {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(width, height, "EntroRenderer Stream Bench", NULL, NULL);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        cout << "Failed to initialize GLAD" << endl;
+        return nullptr;
+    }
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    return window;
+}
@@ -0,0 +1,91 @@
+#version 420 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D srcTexture;
+uniform vec2 srcResolution;
+uniform int mipLevel;
+uniform float threshold;  // 亮度超过它才发光
+uniform float knee;       // 阈值附近的软过渡宽度 (0 = 硬阈值)
+
+// Karis 平均用的亮度权重：越亮的样本权重越小，防止单个极亮像素闪烁
+float KarisWeight(vec3 c)
+{
+    float luma = dot(c, vec3(0.2126, 0.7152, 0.0722));
+    return 1.0 / (1.0 + luma);
+}
+
+// 软阈值 (soft knee)：threshold - knee 到 threshold + knee 之间用二次曲线过渡，
+// 避免亮度刚好跨过阈值的像素一闪一闪
+vec3 Prefilter(vec3 c)
+{
+    float brightness = dot(c, vec3(0.2126, 0.7152, 0.0722));
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 0.00001);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 0.00001);
+    return c * contribution;
+}
+
+// 13-tap 降采样 (Jimenez, "Next Generation Post Processing in Call of Duty: Advanced Warfare")
+// 采样点布局：
+// a - b - c
+// - j - k -
+// d - e - f
+// - l - m -
+// g - h - i
+// 这些采样都落在纹素交界处，硬件双线性再平均一次，相当于 36 个纹素的加权和
+void main()
+{
+    vec2 texel = 1.0 / srcResolution;
+    float x = texel.x;
+    float y = texel.y;
+
+    vec3 a = texture(srcTexture, TexCoords + vec2(-2.0 * x,  2.0 * y)).rgb;
+    vec3 b = texture(srcTexture, TexCoords + vec2( 0.0,      2.0 * y)).rgb;
+    vec3 c = texture(srcTexture, TexCoords + vec2( 2.0 * x,  2.0 * y)).rgb;
+    vec3 d = texture(srcTexture, TexCoords + vec2(-2.0 * x,  0.0)).rgb;
+    vec3 e = texture(srcTexture, TexCoords).rgb;
+    vec3 f = texture(srcTexture, TexCoords + vec2( 2.0 * x,  0.0)).rgb;
+    vec3 g = texture(srcTexture, TexCoords + vec2(-2.0 * x, -2.0 * y)).rgb;
+    vec3 h = texture(srcTexture, TexCoords + vec2( 0.0,     -2.0 * y)).rgb;
+    vec3 i = texture(srcTexture, TexCoords + vec2( 2.0 * x, -2.0 * y)).rgb;
+    vec3 j = texture(srcTexture, TexCoords + vec2(-x,  y)).rgb;
+    vec3 k = texture(srcTexture, TexCoords + vec2( x,  y)).rgb;
+    vec3 l = texture(srcTexture, TexCoords + vec2(-x, -y)).rgb;
+    vec3 m = texture(srcTexture, TexCoords + vec2( x, -y)).rgb;
+
+    vec3 result;
+    if (mipLevel == 0)
+    {
+        // 第一级：5 个 2x2 块分别做 Karis 平均再按权重合并
+        vec3 groups[5];
+        groups[0] = (a + b + d + e) * 0.25;
+        groups[1] = (b + c + e + f) * 0.25;
+        groups[2] = (d + e + g + h) * 0.25;
+        groups[3] = (e + f + h + i) * 0.25;
+        groups[4] = (j + k + l + m) * 0.25;
+        float weights[5] = float[](0.125, 0.125, 0.125, 0.125, 0.5);
+        result = vec3(0.0);
+        float total = 0.0;
+        for (int n = 0; n < 5; n++)
+        {
+            float w = weights[n] * KarisWeight(groups[n]);
+            result += groups[n] * w;
+            total += w;
+        }
+        result /= total;
+        // 第一级直接读 HDR 场景颜色，高亮提取在这里顺便做掉，场景帧不再需要第二个颜色附件
+        result = Prefilter(result);
+    }
+    else
+    {
+        // 中心 0.5，四个角块各 0.125
+        result  = e * 0.125;
+        result += (a + c + g + i) * 0.03125;
+        result += (b + d + f + h) * 0.0625;
+        result += (j + k + l + m) * 0.125;
+    }
+    // 防止出现负数 / NaN 传播到后面的级别
+    result = max(result, 0.0001);
+    FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#version 420 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D scene;
+uniform float threshold;
+uniform float knee;
+
+// 和 bloomDownsample.frag 里的第一级一样的软阈值，给 ping-pong / 计算着色器模糊单独提取高亮用
+vec3 Prefilter(vec3 c)
+{
+    float brightness = dot(c, vec3(0.2126, 0.7152, 0.0722));
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 0.00001);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 0.00001);
+    return c * contribution;
+}
+
+void main()
+{
+    FragColor = vec4(Prefilter(texture(scene, TexCoords).rgb), 1.0);
+}
\ No newline at end of file
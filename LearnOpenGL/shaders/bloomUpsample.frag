@@ -0,0 +1,33 @@
+#version 420 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D srcTexture;
+uniform float filterRadius; // tent 滤波半径 (UV 单位，各级共用，所以越小的 mip 模糊得越宽)
+
+// 3x3 tent 滤波升采样，结果用 GL_ONE, GL_ONE 叠加到上一级
+// a - b - c
+// d - e - f
+// g - h - i
+void main()
+{
+    float x = filterRadius;
+    float y = filterRadius;
+
+    vec3 a = texture(srcTexture, TexCoords + vec2(-x,  y)).rgb;
+    vec3 b = texture(srcTexture, TexCoords + vec2( 0.0, y)).rgb;
+    vec3 c = texture(srcTexture, TexCoords + vec2( x,  y)).rgb;
+    vec3 d = texture(srcTexture, TexCoords + vec2(-x,  0.0)).rgb;
+    vec3 e = texture(srcTexture, TexCoords).rgb;
+    vec3 f = texture(srcTexture, TexCoords + vec2( x,  0.0)).rgb;
+    vec3 g = texture(srcTexture, TexCoords + vec2(-x, -y)).rgb;
+    vec3 h = texture(srcTexture, TexCoords + vec2( 0.0, -y)).rgb;
+    vec3 i = texture(srcTexture, TexCoords + vec2( x, -y)).rgb;
+
+    // 权重 1-2-1 / 2-4-2 / 1-2-1，总和 16
+    vec3 result = e * 4.0;
+    result += (b + d + f + h) * 2.0;
+    result += (a + c + g + i);
+    result *= 1.0 / 16.0;
+    FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
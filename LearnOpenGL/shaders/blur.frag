@@ -2,31 +2,26 @@
 out vec4 FragColor;
 in vec2 TexCoords;
 
+// 最多多少个采样点 (一侧，包括中心)，对应 BlurKernel
+const int MAX_TAPS = 33;
+
 uniform sampler2D image;
 uniform bool horizontal; // true=水平模糊, false=垂直模糊
-// 权重数组 (高斯曲线)
-uniform float weight[5] = float[] (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+// 模糊核由 CPU 生成 (BlurKernel)：offsets 以纹素为单位，可以是小数 (线性采样合并后的位置)
+uniform int tapCount;
+uniform float offsets[MAX_TAPS];
+uniform float weights[MAX_TAPS];
 
 void main()
 {
     vec2 tex_offset = 1.0 / vec2(textureSize(image, 0)); // 获取单个纹素大小
-    vec3 result = texture(image, TexCoords).rgb * weight[0]; // 当前像素贡献
+    vec2 direction = horizontal ? vec2(tex_offset.x, 0.0) : vec2(0.0, tex_offset.y);
+    vec3 result = texture(image, TexCoords).rgb * weights[0]; // 当前像素贡献
 
-    if(horizontal)
-    {
-        for(int i = 1; i < 5; ++i)
-        {
-            result += texture(image, TexCoords + vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-            result += texture(image, TexCoords - vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-        }
-    }
-    else
+    for(int i = 1; i < tapCount; ++i)
     {
-        for(int i = 1; i < 5; ++i)
-        {
-            result += texture(image, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-            result += texture(image, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-        }
+        result += texture(image, TexCoords + direction * offsets[i]).rgb * weights[i];
+        result += texture(image, TexCoords - direction * offsets[i]).rgb * weights[i];
     }
     FragColor = vec4(result, 1.0);
 }
\ No newline at end of file
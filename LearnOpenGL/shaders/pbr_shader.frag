@@ -1,6 +1,5 @@
 #version 420 core
-layout (location = 0) out vec4 FragColor;    // 输出到 colorBuffers[0]
-layout (location = 1) out vec4 BrightColor;  // 输出到 colorBuffers[1]
+layout (location = 0) out vec4 FragColor;    // 输出到 colorBuffer
 
 // 保持和 C++ 代码一致的结构体定义
 struct Material {
@@ -30,14 +29,17 @@ struct PointLight {
 };
 
 // 【绑定点 1】
+// 和 pointLightData.h 里的 MAX_POINT_LIGHTS 一致；只有前 MAX_SHADOW_LIGHTS 个有阴影
+#define MAX_POINT_LIGHTS 128
+#define MAX_SHADOW_LIGHTS 4
 layout (std140, binding = 1) uniform LightBlock {
-    PointLight pointLights[4];
+    PointLight pointLights[MAX_POINT_LIGHTS];
+    int lightCount;
 };
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
-in vec4 FragPosLightSpace;
 in mat3 TBN;
 
 uniform vec3 viewPos;
@@ -48,6 +50,66 @@ uniform sampler2D metallicMap;
 uniform sampler2D roughnessMap;
 uniform sampler2D aoMap;
 
+// 【绑定点 2】点光源阴影图集 (见 pointShadowAtlas.h)
+layout (std140, binding = 2) uniform ShadowBlock {
+    mat4 faceMatrices[24];  // 每个光源 6 个面的光照空间矩阵
+    vec4 faceRects[24];     // xy = 图集 UV 偏移, zw = UV 大小
+    vec4 faceLightPos[24];  // xyz = 渲染这个面时的光源位置, w = 远平面
+    vec4 lightShadow[MAX_SHADOW_LIGHTS];    // x = 是否有阴影, y = 图集纹素大小, z = bias
+};
+layout(binding = 10) uniform sampler2D shadowAtlas;
+
+// 返回 0 (被照亮) ~ 1 (完全在阴影里)
+float PointShadow(int light, vec3 normal)
+{
+    if (light >= MAX_SHADOW_LIGHTS || lightShadow[light].x < 0.5)
+    return 0.0;
+
+    // 1. 根据光源指向片元的主轴选出立方体的面 (+X -X +Y -Y +Z -Z)
+    vec3 L = FragPos - pointLights[light].position;
+    vec3 a = abs(L);
+    int face;
+    if (a.x >= a.y && a.x >= a.z) face = L.x > 0.0 ? 0 : 1;
+    else if (a.y >= a.z)          face = L.y > 0.0 ? 2 : 3;
+    else                          face = L.z > 0.0 ? 4 : 5;
+    int index = light * 6 + face;
+    vec4 rect = faceRects[index];
+    if (rect.z <= 0.0)
+    return 0.0;
+
+    // 2. 投影到这个面上，再映射到图集里对应的区域
+    vec4 clipPos = faceMatrices[index] * vec4(FragPos, 1.0);
+    vec2 uv = clipPos.xy / clipPos.w * 0.5 + 0.5;
+
+    // 3. 深度图里存的是到光源的线性距离，这里也算同样的东西
+    // 用这个面被渲染时的光源位置，预算不够、面还没刷新时阴影也不会错位
+    vec3 lightPos = faceLightPos[index].xyz;
+    float farPlane = faceLightPos[index].w;
+    float currentDepth = length(FragPos - lightPos) / farPlane;
+    if (currentDepth > 1.0)
+    return 0.0;
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float bias = max(lightShadow[light].z * (1.0 - dot(normal, lightDir)), lightShadow[light].z * 0.1) / farPlane;
+
+    // 4. PCF 3x3，采样点限制在这个面的区域里，防止读到图集里相邻的面
+    float texel = lightShadow[light].y;
+    vec2 minUV = rect.xy + vec2(texel * 0.5);
+    vec2 maxUV = rect.xy + rect.zw - vec2(texel * 0.5);
+    vec2 baseUV = rect.xy + uv * rect.zw;
+    float shadow = 0.0;
+    for(int x = -1; x <= 1; ++x)
+    {
+        for(int y = -1; y <= 1; ++y)
+        {
+            float pcfDepth = texture(shadowAtlas, clamp(baseUV + vec2(x, y) * texel, minUV, maxUV)).r;
+            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    shadow /= 9.0;
+
+    return shadow;
+}
+
 
 const float PI = 3.14159265359;
 
@@ -118,7 +180,7 @@ void main()
 
     vec3 Lo = vec3(0.0);
 
-    for(int i = 0; i < 4; ++i)
+    for(int i = 0; i < lightCount; ++i)
     {
         vec3 L = normalize(pointLights[i].position - FragPos);
         vec3 H = normalize(V + L);
@@ -144,7 +206,8 @@ void main()
         kD *= 1.0 - metallic;
 
         float NdotL = max(dot(N, L), 0.0);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
+        float shadow = PointShadow(i, N);
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL * (1.0 - shadow);
     }
 
     vec3 ambient = vec3(0.03) * albedo * ao;
@@ -0,0 +1,11 @@
+#version 420 core
+in vec3 WorldPos;
+
+uniform vec3 lightPos;
+uniform float farPlane;
+
+void main()
+{
+    // 点光源的深度存“到光源的线性距离”，6 个面的比较方式就统一了，bias 也可以用世界单位
+    gl_FragDepth = length(WorldPos - lightPos) / farPlane;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 420 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 lightSpaceMatrix; // 立方体某一个面的 Projection * View
+uniform mat4 model;
+
+out vec3 WorldPos;
+
+void main()
+{
+    WorldPos = vec3(model * vec4(aPos, 1.0));
+    gl_Position = lightSpaceMatrix * vec4(WorldPos, 1.0);
+}
\ No newline at end of file
@@ -1,12 +1,28 @@
 #version 420 core
+// ========================================================
+// 合并后的后处理：每个像素只读一次场景、写一次结果
+// 每个效果都用 #ifdef 包起来，由 PostProcessor 按开关拼上 #define 编译出对应的变体，
+// 关掉的效果连分支都没有。效果按下面的顺序执行：
+//   POST_BLOOM         叠加泛光
+//   POST_TONEMAP       曝光 + ACES (POST_AUTO_EXPOSURE 时乘上自动曝光)
+//   POST_COLOR_GRADING 饱和度 / 对比度
+//   POST_VIGNETTE      暗角
+//   POST_GAMMA         伽马校正
+// 不合并时每个效果单独编译成一个 pass，用来对比耗时和带宽
+// ========================================================
 out vec4 FragColor;
 in vec2 TexCoords;
 
-uniform sampler2D scene;      // 原图
+uniform sampler2D scene;      // 原图 (不合并时是上一个 pass 的结果)
 uniform sampler2D bloomBlur;  // 泛光图
-uniform float exposure;       // 曝光度 (建议 0.5 ~ 2.0)
+uniform sampler2D exposureTexture; // 自动曝光算出的曝光 (1x1)
+uniform float exposure;       // 曝光度 (建议 0.5 ~ 2.0)，自动曝光时是补偿
 uniform float gamma;          // 伽马 (通常 2.2)
-uniform float bloomStrength;  // 【新增】泛光强度 (建议 0.02 ~ 0.1)
+uniform float bloomStrength;  // 泛光强度 (建议 0.02 ~ 0.1)
+uniform float saturation;     // 1 = 不变
+uniform float contrast;       // 1 = 不变
+uniform float vignetteStrength;
+uniform float vignetteRadius; // 从中心到这里开始变暗 (1 = 角落)
 
 // ========================================================
 // ACES 拟合公式 (Narkowicz版本)
@@ -24,21 +40,41 @@ vec3 ACESFilm(vec3 x)
 
 void main()
 {
-    vec3 hdrColor = texture(scene, TexCoords).rgb;
-    vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
+    vec3 color = texture(scene, TexCoords).rgb;
 
+#ifdef POST_BLOOM
     // 1. 混合 Bloom (增加控制权)
     // 直接叠加会导致画面变亮变白，乘个系数压一压
-    hdrColor += bloomColor * bloomStrength;
+    color += texture(bloomBlur, TexCoords).rgb * bloomStrength;
+#endif
 
+#ifdef POST_TONEMAP
     // 2. 应用曝光
-    hdrColor *= exposure;
-
+    float finalExposure = exposure;
+#ifdef POST_AUTO_EXPOSURE
+    finalExposure *= texelFetch(exposureTexture, ivec2(0), 0).r;
+#endif
     // 3. 色调映射 (Tone Mapping) - 使用 ACES 替代原来的 exp
-    vec3 result = ACESFilm(hdrColor);
+    color = ACESFilm(color * finalExposure);
+#endif
+
+#ifdef POST_COLOR_GRADING
+    // 4. 调色：饱和度围绕亮度，对比度围绕中灰
+    float luma = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    color = mix(vec3(luma), color, saturation);
+    color = clamp((color - 0.18) * contrast + 0.18, 0.0, 1.0);
+#endif
+
+#ifdef POST_VIGNETTE
+    // 5. 暗角：按到中心的距离 (角落是 1) 平滑变暗
+    float dist = length(TexCoords - 0.5) * 1.41421356;
+    color *= 1.0 - vignetteStrength * smoothstep(vignetteRadius, 1.0, dist);
+#endif
 
-    // 4. 伽马校正
-    result = pow(result, vec3(1.0 / gamma));
+#ifdef POST_GAMMA
+    // 6. 伽马校正
+    color = pow(color, vec3(1.0 / gamma));
+#endif
 
-    FragColor = vec4(hdrColor.rgb, 1.0);
+    FragColor = vec4(color, 1.0);
 }
\ No newline at end of file
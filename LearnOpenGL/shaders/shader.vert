@@ -8,7 +8,6 @@ layout (location = 4) in vec3 aBitangent;
 out vec2 TexCoords;
 out vec3 FragPos;
 out vec3 Normal;
-out vec4 FragPosLightSpace;
 out mat3 TBN;
 
 uniform mat4 model;
@@ -17,7 +16,6 @@ layout (std140, binding = 0) uniform Matrices
     mat4 projection;
     mat4 view;
 };
-uniform mat4 lightSpaceMatrix;
 
 void main()
 {
@@ -25,7 +23,6 @@ void main()
     FragPos = vec3(model * vec4(aPos, 1.0));
     // 法线矩阵
     Normal = mat3(transpose(inverse(model))) * aNormal;
-    FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
 
     // ==========================================
     // 构建 TBN 矩阵
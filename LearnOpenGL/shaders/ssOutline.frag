@@ -0,0 +1,60 @@
+#version 420 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D depthTexture;  // 场景深度
+uniform sampler2D normalMask;    // rgb = 世界空间法线, a = 这个像素属于需要描边的物体
+uniform vec3 color;
+uniform float thickness;         // 采样半径 (像素)
+uniform float depthThreshold;    // 线性深度的相对差
+uniform float normalThreshold;   // 1 - dot(n1, n2)
+uniform float nearPlane;
+uniform float farPlane;
+uniform ivec2 renderSize;        // 动态分辨率下实际渲染的区域 (帧缓冲左下角)
+
+// 把 [0,1] 的非线性深度还原成观察空间的距离
+float LinearDepth(float depth)
+{
+    float z = depth * 2.0 - 1.0;
+    return (2.0 * nearPlane * farPlane) / (farPlane + nearPlane - z * (farPlane - nearPlane));
+}
+
+void main()
+{
+    // 用 texelFetch 按像素读，视口是多大就读多大，不依赖 TexCoords
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 maxCoord = renderSize - 1;
+    int r = max(int(thickness + 0.5), 1);
+    ivec2 offsets[4] = ivec2[](ivec2(r, 0), ivec2(-r, 0), ivec2(0, r), ivec2(0, -r));
+
+    vec4 centerNM = texelFetch(normalMask, p, 0);
+    float centerDepth = LinearDepth(texelFetch(depthTexture, p, 0).r);
+    vec3 centerNormal = centerNM.rgb * 2.0 - 1.0;
+
+    float edge = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 q = clamp(p + offsets[i], ivec2(0), maxCoord);
+        vec4 nm = texelFetch(normalMask, q, 0);
+        // 只关心和“需要描边的物体”有关的像素对
+        if (centerNM.a < 0.5 && nm.a < 0.5)
+        continue;
+
+        float depth = LinearDepth(texelFetch(depthTexture, q, 0).r);
+        // 1. 深度不连续 (轮廓)：线画在较远的那一侧，也就是物体外沿，和外扩描边的位置一致
+        if (nm.a > 0.5 && depth < centerDepth && (centerDepth - depth) / depth > depthThreshold)
+        edge = 1.0;
+        // 2. 法线不连续 (折痕)：两边都属于描边物体、深度接近但朝向差很多
+        if (centerNM.a > 0.5 && nm.a > 0.5 && abs(centerDepth - depth) / centerDepth <= depthThreshold)
+        {
+            vec3 n = nm.rgb * 2.0 - 1.0;
+            if (1.0 - dot(centerNormal, n) > normalThreshold)
+            edge = 1.0;
+        }
+    }
+
+    // 没有边就直接丢弃，不产生任何写入
+    if (edge < 0.5)
+    discard;
+    FragColor = vec4(color, 1.0);
+}
\ No newline at end of file
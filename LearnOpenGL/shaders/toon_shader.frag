@@ -1,6 +1,6 @@
 #version 420 core
-layout (location = 0) out vec4 FragColor;    // 输出到 colorBuffers[0]
-layout (location = 1) out vec4 BrightColor;  // 输出到 colorBuffers[1]
+layout (location = 0) out vec4 FragColor;    // 输出到 colorBuffer
+layout (location = 1) out vec4 NormalMask;   // 输出到 normalMaskBuffer (只有屏幕空间描边的物体才打开这个附件)
 
 // 保持和 C++ 代码一致的结构体定义
 struct Material {
@@ -30,52 +30,75 @@ struct PointLight {
 };
 
 // 【绑定点 1】
+// 和 pointLightData.h 里的 MAX_POINT_LIGHTS 一致；只有前 MAX_SHADOW_LIGHTS 个有阴影
+#define MAX_POINT_LIGHTS 128
+#define MAX_SHADOW_LIGHTS 4
 layout (std140, binding = 1) uniform LightBlock {
-    PointLight pointLights[4];
+    PointLight pointLights[MAX_POINT_LIGHTS];
+    int lightCount;
 };
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
-in vec4 FragPosLightSpace;
 in mat3 TBN;
 
 uniform vec3 viewPos;
 uniform Material material;
 uniform vec2 uvScale;
 uniform bool useNormalMap;
-layout(binding = 10) uniform sampler2D shadowMap;
+// 【绑定点 2】点光源阴影图集 (见 pointShadowAtlas.h)
+layout (std140, binding = 2) uniform ShadowBlock {
+    mat4 faceMatrices[24];  // 每个光源 6 个面的光照空间矩阵
+    vec4 faceRects[24];     // xy = 图集 UV 偏移, zw = UV 大小
+    vec4 faceLightPos[24];  // xyz = 渲染这个面时的光源位置, w = 远平面
+    vec4 lightShadow[MAX_SHADOW_LIGHTS];    // x = 是否有阴影, y = 图集纹素大小, z = bias
+};
+layout(binding = 10) uniform sampler2D shadowAtlas;
 
-float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal)
+// 返回 0 (被照亮) ~ 1 (完全在阴影里)
+float PointShadow(int light, vec3 normal)
 {
-    vec3 lightDir = normalize(pointLights[0].position - FragPos);
-    // 1. 执行透视除法 (虽然正交投影下 w 是 1，但这步是标准流程)
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-
-    // 2. 变换到 [0,1] 的范围 (因为深度图是 0~1，而坐标是 -1~1)
-    projCoords = projCoords * 0.5 + 0.5;
-
-    // 3. 如果超过了视锥体远端，就不算阴影
-    if(projCoords.z > 1.0)
+    if (light >= MAX_SHADOW_LIGHTS || lightShadow[light].x < 0.5)
     return 0.0;
 
-    // 4. 获取当前像素的深度 (当前深度)
-    float currentDepth = projCoords.z;
+    // 1. 根据光源指向片元的主轴选出立方体的面 (+X -X +Y -Y +Z -Z)
+    vec3 L = FragPos - pointLights[light].position;
+    vec3 a = abs(L);
+    int face;
+    if (a.x >= a.y && a.x >= a.z) face = L.x > 0.0 ? 0 : 1;
+    else if (a.y >= a.z)          face = L.y > 0.0 ? 2 : 3;
+    else                          face = L.z > 0.0 ? 4 : 5;
+    int index = light * 6 + face;
+    vec4 rect = faceRects[index];
+    if (rect.z <= 0.0)
+    return 0.0;
 
-    // 5. 【阴影偏移 (Shadow Bias)】解决 "阴影痤疮" (Shadow Acne)
-    // 根据表面法线和光线的夹角动态调整偏移量
-    float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
+    // 2. 投影到这个面上，再映射到图集里对应的区域
+    vec4 clipPos = faceMatrices[index] * vec4(FragPos, 1.0);
+    vec2 uv = clipPos.xy / clipPos.w * 0.5 + 0.5;
 
-    // 6. PCF (百分比渐进过滤) - 让阴影边缘柔和一点
-    // 采样周围 3x3 的像素并取平均值
+    // 3. 深度图里存的是到光源的线性距离，这里也算同样的东西
+    // 用这个面被渲染时的光源位置，预算不够、面还没刷新时阴影也不会错位
+    vec3 lightPos = faceLightPos[index].xyz;
+    float farPlane = faceLightPos[index].w;
+    float currentDepth = length(FragPos - lightPos) / farPlane;
+    if (currentDepth > 1.0)
+    return 0.0;
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float bias = max(lightShadow[light].z * (1.0 - dot(normal, lightDir)), lightShadow[light].z * 0.1) / farPlane;
+
+    // 4. PCF 3x3，采样点限制在这个面的区域里，防止读到图集里相邻的面
+    float texel = lightShadow[light].y;
+    vec2 minUV = rect.xy + vec2(texel * 0.5);
+    vec2 maxUV = rect.xy + rect.zw - vec2(texel * 0.5);
+    vec2 baseUV = rect.xy + uv * rect.zw;
     float shadow = 0.0;
-    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0));
     for(int x = -1; x <= 1; ++x)
     {
         for(int y = -1; y <= 1; ++y)
         {
-            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
-            // 如果 当前深度 - bias > 记录深度，说明在阴影里
+            float pcfDepth = texture(shadowAtlas, clamp(baseUV + vec2(x, y) * texel, minUV, maxUV)).r;
             shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
         }
     }
@@ -120,7 +143,7 @@ void main()
     // 【核心一步】将连续的光照值“切”成离散的色阶
     float toonIntensity;
 
-    float shadow = ShadowCalculation(FragPosLightSpace, norm);
+    float shadow = PointShadow(0, norm);
     if (diffuseFactor < 0.3 || shadow > 0.5) {
         toonIntensity = 0.4;
     } else {
@@ -153,11 +176,7 @@ void main()
     vec3 result = finalAmbient + finalDiffuse + finalSpecular;
 
     FragColor = vec4(result, 1.0);
-    float brightness = dot(result, vec3(0.2126, 0.7152, 0.0722));
-
-    // 阈值设为 1.0 (超过 1.0 的才发光)
-    if(brightness > 1.0)
-    BrightColor = vec4(result, 1.0);
-    else
-    BrightColor = vec4(0.0, 0.0, 0.0, 1.0); // 暗的地方存黑色
+    // 屏幕空间描边用：rgb = 世界空间法线, a = 需要描边
+    NormalMask = vec4(norm * 0.5 + 0.5, 1.0);
+    // 高亮提取不在这里做了，放到泛光的第一次降采样里 (见 bloomDownsample.frag)
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#version 420 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D scene;      // 场景帧缓冲 (只有左下角 renderSize 大小是有效的)
+uniform vec2 renderSize;      // 本帧实际渲染的像素尺寸
+uniform float sharpness;      // 0 ~ 1
+
+// CAS 的公式假设颜色在 [0,1]，HDR 先压进 [0,1) 再算，最后还原 (可逆的 Reinhard)
+vec3 Compress(vec3 c) { return c / (1.0 + max(c.r, max(c.g, c.b))); }
+vec3 Expand(vec3 c) { return c / max(1.0 - max(c.r, max(c.g, c.b)), 0.0001); }
+
+vec3 Fetch(vec2 pixel)
+{
+    // 限制在有效区域内，双线性不会读到子区域外面的旧数据
+    vec2 texSize = vec2(textureSize(scene, 0));
+    pixel = clamp(pixel, vec2(0.5), renderSize - 0.5);
+    return Compress(texture(scene, pixel / texSize).rgb);
+}
+
+// 空间升采样 + 对比度自适应锐化 (思路来自 AMD FidelityFX CAS)
+// 十字形的 5 个双线性采样：对比度低的地方锐化强，已经有强边缘的地方锐化弱，不会产生光晕
+void main()
+{
+    vec2 pixel = TexCoords * renderSize;
+    vec3 b = Fetch(pixel + vec2( 0.0,  1.0));
+    vec3 d = Fetch(pixel + vec2(-1.0,  0.0));
+    vec3 e = Fetch(pixel);
+    vec3 f = Fetch(pixel + vec2( 1.0,  0.0));
+    vec3 h = Fetch(pixel + vec2( 0.0, -1.0));
+
+    vec3 mn = min(e, min(min(b, d), min(f, h)));
+    vec3 mx = max(e, max(max(b, d), max(f, h)));
+    // 离 0 或 1 越近 (局部对比度越高)，amp 越小
+    vec3 amp = sqrt(clamp(min(mn, 1.0 - mx) / max(mx, 0.0001), 0.0, 1.0));
+    float peak = -1.0 / mix(8.0, 5.0, sharpness);
+    vec3 w = amp * peak;
+    vec3 result = (e + (b + d + f + h) * w) / (1.0 + 4.0 * w);
+
+    FragColor = vec4(Expand(clamp(result, 0.0, 0.999)), 1.0);
+}
\ No newline at end of file
@@ -1,13 +1,21 @@
 #include "mesh.h"
 #include <string>
+#include <utility>
 
-Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<TextureInfo> textures)
+#include "resourceTracker.h"
+
+Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<TextureInfo> textures, bool upload)
 {
-    this->vertices = vertices;
-    this->indices = indices;
-    this->textures = textures;
+    this->vertices = std::move(vertices);
+    this->indices = std::move(indices);
+    this->textures = std::move(textures);
+
+    for (const Vertex& v : this->vertices)
+        bounds.Expand(v.Position);
 
-    setupMesh();
+    VAO = 0;
+    if (upload)
+        setupMesh();
 }
 
 void Mesh::Draw(Shader &shader)
@@ -49,6 +57,18 @@ void Mesh::Draw(Shader &shader)
     glActiveTexture(GL_TEXTURE0);
 }
 
+void Mesh::Release()
+{
+    ResourceTracker& tracker = ResourceTracker::Get();
+    tracker.Release(RESOURCE_KIND_BUFFER, VBO);
+    tracker.Release(RESOURCE_KIND_BUFFER, EBO);
+    tracker.Release(RESOURCE_KIND_HOST, VAO);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+    VAO = VBO = EBO = 0;
+}
+
 void Mesh::setupMesh()
 {
     glGenVertexArrays(1, &VAO);
@@ -62,6 +82,35 @@ void Mesh::setupMesh()
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
 
+    setupAttributes();
+    glBindVertexArray(0);
+
+    ResourceTracker& tracker = ResourceTracker::Get();
+    tracker.Track(RESOURCE_KIND_BUFFER, VBO, vertices.size() * sizeof(Vertex), RESOURCE_MESH);
+    tracker.Track(RESOURCE_KIND_BUFFER, EBO, indices.size() * sizeof(unsigned int), RESOURCE_MESH);
+    trackHostMemory();
+}
+
+void Mesh::AttachBuffers(unsigned int vertexBuffer, unsigned int indexBuffer)
+{
+    VBO = vertexBuffer;
+    EBO = indexBuffer;
+}
+
+void Mesh::CreateVertexArray()
+{
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    setupAttributes();
+    glBindVertexArray(0);
+    trackHostMemory();
+}
+
+// VAO 和两个缓冲都已经绑好
+void Mesh::setupAttributes()
+{
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
     glEnableVertexAttribArray(1);
@@ -75,6 +124,11 @@ void Mesh::setupMesh()
     // 4. 副切线 (Bitangent)
     glEnableVertexAttribArray(4);
     glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
+}
 
-    glBindVertexArray(0);
+// 顶点 / 索引在上传之后还留在内存里 (包围盒、阴影剔除会用到)，CPU 这份也记上，用 VAO 当名字
+void Mesh::trackHostMemory()
+{
+    ResourceTracker::Get().Track(RESOURCE_KIND_HOST, VAO, vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int),
+                                 RESOURCE_CPU_MESH);
 }
\ No newline at end of file
@@ -4,16 +4,109 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <iostream>
+#include <filesystem>
+#include <numeric>
+
+#include "jobSystem.h"
+#include "loadStats.h"
+#include "resourceTracker.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "assimp/scene.h"
 
-Model::Model(string const &path, bool gamma) : gammaCorrection(gamma)
+namespace {
+// 网格转换用的任务系统，nullptr = 全局的那个
+JobSystem* conversionJobs = nullptr;
+
+// 一个 aiMesh 转换出来的顶点 / 索引
+struct ConvertedGeometry {
+    vector<Vertex> vertices;
+    vector<unsigned int> indices;
+};
+
+// 顶点转换：有哪些属性在编译期定下来，循环里没有分支。没有的属性填 0
+template <bool NORMALS, bool UVS, bool TANGENTS>
+void convertVertices(const aiMesh *mesh, Vertex *out)
+{
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+    {
+        Vertex& vertex = out[i];
+        const aiVector3D& position = mesh->mVertices[i];
+        vertex.Position = glm::vec3(position.x, position.y, position.z);
+        if constexpr (NORMALS) {
+            const aiVector3D& normal = mesh->mNormals[i];
+            vertex.Normal = glm::vec3(normal.x, normal.y, normal.z);
+        } else {
+            vertex.Normal = glm::vec3(0.0f);
+        }
+        if constexpr (UVS) {
+            const aiVector3D& uv = mesh->mTextureCoords[0][i];
+            vertex.TexCoords = glm::vec2(uv.x, uv.y);
+        } else {
+            vertex.TexCoords = glm::vec2(0.0f);
+        }
+        if constexpr (TANGENTS) {
+            const aiVector3D& tangent = mesh->mTangents[i];
+            const aiVector3D& bitangent = mesh->mBitangents[i];
+            vertex.Tangent = glm::vec3(tangent.x, tangent.y, tangent.z);
+            vertex.Bitangent = glm::vec3(bitangent.x, bitangent.y, bitangent.z);
+        } else {
+            // 如果模型太简单（比如纯平面）Assimp没算出来，给个默认值
+            vertex.Tangent = glm::vec3(0.0f);
+            vertex.Bitangent = glm::vec3(0.0f);
+        }
+    }
+}
+
+using VertexKernel = void (*)(const aiMesh *, Vertex *);
+// 下标：法线 1 | 贴图坐标 2 | 切线和副切线 4
+const VertexKernel VERTEX_KERNELS[8] = {
+    convertVertices<false, false, false>, convertVertices<true, false, false>,
+    convertVertices<false, true, false>,  convertVertices<true, true, false>,
+    convertVertices<false, false, true>,  convertVertices<true, false, true>,
+    convertVertices<false, true, true>,   convertVertices<true, true, true>
+};
+
+// 只读 aiMesh、只写 out，不碰 GL 和 LoadProfiler，可以在任何线程上跑
+void convertGeometry(const aiMesh *mesh, ConvertedGeometry &out)
+{
+    int attributes = (mesh->HasNormals() ? 1 : 0) | (mesh->mTextureCoords[0] ? 2 : 0) |
+                     (mesh->HasTangentsAndBitangents() ? 4 : 0);
+    out.vertices.resize(mesh->mNumVertices);
+    VERTEX_KERNELS[attributes](mesh, out.vertices.data());
+
+    size_t indexCount = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        indexCount += mesh->mFaces[i].mNumIndices;
+    out.indices.resize(indexCount);
+    unsigned int* index = out.indices.data();
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+    {
+        const aiFace& face = mesh->mFaces[i];
+        index = std::copy(face.mIndices, face.mIndices + face.mNumIndices, index);
+    }
+}
+}
+
+void Model::SetConversionJobSystem(JobSystem *jobs)
+{
+    conversionJobs = jobs;
+}
+
+Model::Model(string const &path, bool gamma, ModelLoadMode mode) : gammaCorrection(gamma), loadMode(mode)
 {
     loadModel(path);
 }
 
+Model::Model(const aiScene *scene, string const &directory, bool gamma, ModelLoadMode mode)
+    : directory(directory), gammaCorrection(gamma), loadMode(mode)
+{
+    ResourceOwnerScope owner(directory);
+    LoadStageTimer timer(LOAD_CONVERT);
+    processScene(scene);
+}
+
 void Model::Draw(Shader &shader)
 {
     for(unsigned int i = 0; i < meshes.size(); i++)
@@ -27,11 +120,45 @@ void Model::DrawAt(glm::vec3 pos, Shader &shader) {
     Draw(shader);
 }
 
+void Model::Release()
+{
+    for (Mesh& mesh : meshes)
+        mesh.Release();
+    for (const TextureInfo& texture : textures_loaded) {
+        ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, texture.id);
+        glDeleteTextures(1, &texture.id);
+    }
+    meshes.clear();
+    textures_loaded.clear();
+    pendingTextures.clear();
+}
+
+void Model::SetTextureIds(const vector<unsigned int> &ids)
+{
+    for (size_t i = 0; i < ids.size() && i < textures_loaded.size(); i++) {
+        textures_loaded[i].id = ids[i];
+        for (Mesh& mesh : meshes)
+            for (TextureInfo& texture : mesh.textures)
+                if (texture.path == textures_loaded[i].path) texture.id = ids[i];
+    }
+    pendingTextures.clear();
+}
 
 void Model::loadModel(string const &path)
 {
+    // 下面创建的网格缓冲和贴图都记在这个模型名下
+    ResourceOwnerScope owner(path);
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    const aiScene* scene;
+    {
+        LoadStageTimer timer(LOAD_PARSE);
+        scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    }
+    if (LoadProfiler::Get().enabled) {
+        std::error_code error;
+        std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+        if (!error) LoadProfiler::Get().AddBytes(LOAD_PARSE, static_cast<size_t>(fileSize));
+    }
 
     if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) 
     {
@@ -39,10 +166,46 @@ void Model::loadModel(string const &path)
         return;
     }
     directory = path.substr(0, path.find_last_of('/'));
-    processNode(scene->mRootNode, scene);
+    // 里面加载纹理的时间记到 decode / upload / mipmap，不算在 convert 里
+    LoadStageTimer timer(LOAD_CONVERT);
+    processScene(scene);
+}
+
+void Model::processScene(const aiScene *scene)
+{
+    // 1. 先把节点树展开成网格列表 (深度优先，和以前逐个处理的顺序一样)
+    vector<aiMesh*> sourceMeshes;
+    processNode(scene->mRootNode, scene, sourceMeshes);
+
+    // 2. 顶点 / 索引并行转换，每个网格写自己的那一格，结果和线程数无关。
+    //    大的先开始，免得最后剩一个大网格拖着。
+    //    后台加载 (上传线程) 默认不用任务系统：渲染线程 Wait 时会帮着执行全局队列里的任务，不能让它捡到加载的活；
+    //    单独指定了转换用的任务系统时两种模式都用它
+    vector<ConvertedGeometry> geometry(sourceMeshes.size());
+    vector<int> order(sourceMeshes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sourceMeshes](int a, int b) {
+        return sourceMeshes[a]->mNumVertices > sourceMeshes[b]->mNumVertices;
+    });
+    auto convert = [&](int i) { convertGeometry(sourceMeshes[order[i]], geometry[order[i]]); };
+    if (loadMode == MODEL_LOAD_DEFERRED && !conversionJobs) {
+        for (int i = 0; i < static_cast<int>(order.size()); i++) convert(i);
+    } else {
+        JobSystem& jobs = conversionJobs ? *conversionJobs : JobSystem::Get();
+        jobs.ParallelFor(0, static_cast<int>(order.size()), 1, convert);
+    }
+
+    // 3. 贴图和 GL 缓冲按原来的顺序在当前线程上做
+    meshes.reserve(sourceMeshes.size());
+    for (size_t i = 0; i < sourceMeshes.size(); i++)
+        meshes.push_back(processMesh(sourceMeshes[i], scene, geometry[i].vertices, geometry[i].indices));
+
+    for (const Mesh& mesh : meshes)
+        bounds.Expand(mesh.bounds);
+    loaded = true;
 }
 
-void Model::processNode(aiNode *node, const aiScene *scene)
+void Model::processNode(aiNode *node, const aiScene *scene, vector<aiMesh*> &out)
 {
     for(unsigned int i = 0; i < node->mNumMeshes; i++)
     {
@@ -58,70 +221,19 @@ void Model::processNode(aiNode *node, const aiScene *scene)
             std::cout << "已跳过特殊网格: " << meshName << std::endl;
             continue; // 直接进入下一次循环，不处理这个网格
         }
-        meshes.push_back(processMesh(mesh, scene));
+        out.push_back(mesh);
     }
     for(unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        processNode(node->mChildren[i], scene);
+        processNode(node->mChildren[i], scene, out);
     }
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
+Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene, vector<Vertex> &vertices, vector<unsigned int> &indices)
 {
-    vector<Vertex> vertices;
-    vector<unsigned int> indices;
     vector<TextureInfo> textures;
 
-    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
-    {
-        Vertex vertex;
-        glm::vec3 vector; 
-        vector.x = mesh->mVertices[i].x;
-        vector.y = mesh->mVertices[i].y;
-        vector.z = mesh->mVertices[i].z;
-        vertex.Position = vector;
-        if (mesh->HasNormals())
-        {
-            vector.x = mesh->mNormals[i].x;
-            vector.y = mesh->mNormals[i].y;
-            vector.z = mesh->mNormals[i].z;
-            vertex.Normal = vector;
-        }
-        if(mesh->mTextureCoords[0]) 
-        {
-            glm::vec2 vec;
-            vec.x = mesh->mTextureCoords[0][i].x; 
-            vec.y = mesh->mTextureCoords[0][i].y;
-            vertex.TexCoords = vec;
-        }
-        else
-            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-
-        //  读取切线和副切线
-        if (mesh->HasTangentsAndBitangents()) {
-            vector.x = mesh->mTangents[i].x;
-            vector.y = mesh->mTangents[i].y;
-            vector.z = mesh->mTangents[i].z;
-            vertex.Tangent = vector;
-
-            vector.x = mesh->mBitangents[i].x;
-            vector.y = mesh->mBitangents[i].y;
-            vector.z = mesh->mBitangents[i].z;
-            vertex.Bitangent = vector;
-        } else {
-            // 如果模型太简单（比如纯平面）Assimp没算出来，给个默认值
-            vertex.Tangent = glm::vec3(0.0f);
-            vertex.Bitangent = glm::vec3(0.0f);
-        }
-        vertices.push_back(vertex);
-    }
-
-    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
-    {
-        aiFace face = mesh->mFaces[i];
-        for(unsigned int j = 0; j < face.mNumIndices; j++)
-            indices.push_back(face.mIndices[j]);
-    }
+    LoadProfiler::Get().AddBytes(LOAD_CONVERT, vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int));
 
     aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];    
 
@@ -134,7 +246,7 @@ Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
     std::vector<TextureInfo> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
     textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
     
-    return Mesh(vertices, indices, textures);
+    return Mesh(std::move(vertices), std::move(indices), std::move(textures), loadMode == MODEL_LOAD_IMMEDIATE);
 }
 
 vector<TextureInfo> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName)
@@ -157,7 +269,13 @@ vector<TextureInfo> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType t
         if(!skip)
         {
             TextureInfo texture;
-            texture.id = TextureFromFile(str.C_Str(), this->directory);
+            if (loadMode == MODEL_LOAD_DEFERRED) {
+                // 名字等上传完再填
+                texture.id = 0;
+                pendingTextures.push_back(DecodeTextureFile(str.C_Str(), this->directory));
+            } else {
+                texture.id = TextureFromFile(str.C_Str(), this->directory);
+            }
             texture.type = typeName;
             texture.path = str.C_Str();
             textures.push_back(texture);
@@ -176,9 +294,14 @@ unsigned int TextureFromFile(const char *path, const string &directory, bool gam
     glGenTextures(1, &textureID);
 
     int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
+    unsigned char *data;
+    {
+        LoadStageTimer timer(LOAD_DECODE);
+        data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
+    }
     if (data)
     {
+        size_t bytes = static_cast<size_t>(width) * height * nrComponents;
         GLenum format;
         if (nrComponents == 1)
             format = GL_RED;
@@ -188,8 +311,19 @@ unsigned int TextureFromFile(const char *path, const string &directory, bool gam
             format = GL_RGBA;
 
         glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+        {
+            LoadStageTimer timer(LOAD_UPLOAD);
+            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        }
+        {
+            LoadStageTimer timer(LOAD_MIPMAP);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+        LoadProfiler::Get().AddBytes(LOAD_DECODE, bytes);
+        LoadProfiler::Get().AddBytes(LOAD_UPLOAD, bytes);
+        LoadProfiler::Get().AddBytes(LOAD_MIPMAP, bytes / 3);
+        ResourceTracker::Get().Track(RESOURCE_KIND_TEXTURE, textureID, ResourceTracker::TextureBytes(width, height, format, true),
+                                     RESOURCE_TEXTURE, filename);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -205,4 +339,22 @@ unsigned int TextureFromFile(const char *path, const string &directory, bool gam
     }
 
     return textureID;
+}
+
+DecodedTexture DecodeTextureFile(const char *path, const string &directory)
+{
+    DecodedTexture texture;
+    texture.filename = directory + '/' + string(path);
+    unsigned char *data;
+    {
+        LoadStageTimer timer(LOAD_DECODE);
+        data = stbi_load(texture.filename.c_str(), &texture.width, &texture.height, &texture.components, 0);
+    }
+    if (data) {
+        texture.pixels = shared_ptr<unsigned char>(data, stbi_image_free);
+        LoadProfiler::Get().AddBytes(LOAD_DECODE, static_cast<size_t>(texture.width) * texture.height * texture.components);
+    } else {
+        std::cout << "Texture failed to load at path: " << texture.filename << std::endl;
+    }
+    return texture;
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headlessContext.h"
+#include "autoExposure.h"
+#include "testRunner.h"
+
+using namespace std;
+
+// ==========================================================
+// 自动曝光测试 (CTest: auto_exposure)
+// 无窗口上下文里对一张 1600x1200 的合成 HDR 图跑两个计算着色器，
+// 结果和 CPU 上按同样规则算的参考值比较 (直方图分 bin、百分位裁剪、时间适应都要对上)
+// 着色器从 shaders/ 读，要在 LearnOpenGL 目录下运行；没有 EGL 时返回 77 (CTest 记为跳过)
+// ==========================================================
+
+const int EXIT_SKIPPED = 77;
+const int IMAGE_WIDTH = 1600;
+const int IMAGE_HEIGHT = 1200;
+const int BIN_COUNT = AutoExposure::BIN_COUNT;
+
+// 和 luminanceHistogram.comp 的 luminanceToBin 一样
+int luminanceToBin(float r, float g, float b, const PostProcessingData& settings) {
+    float lum = r * 0.2126f + g * 0.7152f + b * 0.0722f;
+    if (lum < 0.0001f) return 0;
+    float range = settings.exposureMaxLogLum - settings.exposureMinLogLum;
+    float t = std::clamp((std::log2(lum) - settings.exposureMinLogLum) / range, 0.0f, 1.0f);
+    return static_cast<int>(t * (BIN_COUNT - 2) + 1.0f);
+}
+
+// 和 luminanceAverage.comp 一样：先算直方图，再按百分位取平均，最后做时间适应 (double 精度)
+AutoExposureResult referenceResult(const vector<float>& pixels, const PostProcessingData& settings,
+                                   float previousAdapted, float deltaTime) {
+    vector<double> bins(BIN_COUNT, 0.0);
+    for (size_t i = 0; i < pixels.size(); i += 4) bins[luminanceToBin(pixels[i], pixels[i + 1], pixels[i + 2], settings)] += 1.0;
+
+    double minLogLum = settings.exposureMinLogLum;
+    double range = settings.exposureMaxLogLum - settings.exposureMinLogLum;
+    auto binLogLum = [&](int bin) { return bin == 0 ? minLogLum : minLogLum + (bin - 0.5) / (BIN_COUNT - 2) * range; };
+
+    double total = pixels.size() / 4;
+    double lowCount = total * settings.exposureLowPercent, highCount = total * settings.exposureHighPercent;
+    double weighted = 0.0, weights = 0.0, all = 0.0, end = 0.0;
+    int lowBin = 0, highBin = 0;
+    for (int bin = 0; bin < BIN_COUNT; bin++) {
+        double count = bins[bin], start = end;
+        end += count;
+        double weight = std::max(0.0, std::min(end, highCount) - std::max(start, lowCount));
+        if (count > 0.0 && start <= lowCount && lowCount < end) lowBin = bin;
+        if (count > 0.0 && start < highCount && highCount <= end) highBin = bin;
+        weighted += weight * binLogLum(bin);
+        weights += weight;
+        all += count * binLogLum(bin);
+    }
+
+    AutoExposureResult result;
+    result.averageLum = static_cast<float>(std::exp2(all / total));
+    result.lowLum = static_cast<float>(std::exp2(binLogLum(lowBin)));
+    result.highLum = static_cast<float>(std::exp2(binLogLum(highBin)));
+    double target = std::exp2(weights > 0.0 ? weighted / weights : minLogLum);
+    double adapted = previousAdapted > 0.0f ? previousAdapted : target;
+    double speed = target > adapted ? settings.adaptSpeedUp : settings.adaptSpeedDown;
+    adapted += (target - adapted) * (1.0 - std::exp(-deltaTime * speed));
+    result.targetLum = static_cast<float>(target);
+    result.adaptedLum = static_cast<float>(adapted);
+    result.exposure = static_cast<float>(settings.exposureKey / adapted);
+    return result;
+}
+
+// 灰度像素，亮度放在 bin 中心 (不会因为舍入跑到相邻的 bin)。
+// 大部分像素集中在中间亮度，再混一些全黑和超出范围的高光，两头的百分位裁剪才有东西可裁
+vector<float> syntheticImage(const PostProcessingData& settings, int shift) {
+    double range = settings.exposureMaxLogLum - settings.exposureMinLogLum;
+    vector<float> pixels(static_cast<size_t>(IMAGE_WIDTH) * IMAGE_HEIGHT * 4);
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int x = 0; x < IMAGE_WIDTH; x++) {
+            unsigned int hash = static_cast<unsigned int>(x * 73856093u) ^ static_cast<unsigned int>(y * 19349663u);
+            hash = (hash ^ (hash >> 13)) * 0x5bd1e995u;
+            hash ^= hash >> 15;
+            float lum;
+            if (hash % 20 == 0) lum = 0.0f;
+            else if (hash % 20 == 1) lum = 1000.0f;
+            else {
+                int bin = std::clamp(100 + shift + static_cast<int>(hash % 61) - static_cast<int>((hash >> 8) % 31), 1, BIN_COUNT - 2);
+                lum = static_cast<float>(std::exp2(settings.exposureMinLogLum + (bin - 0.5) / (BIN_COUNT - 2) * range));
+            }
+            float* pixel = &pixels[(static_cast<size_t>(y) * IMAGE_WIDTH + x) * 4];
+            pixel[0] = pixel[1] = pixel[2] = lum;
+            pixel[3] = 1.0f;
+        }
+    }
+    return pixels;
+}
+
+unsigned int createTexture(const vector<float>& pixels) {
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA32F, IMAGE_WIDTH, IMAGE_HEIGHT);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, IMAGE_WIDTH, IMAGE_HEIGHT, GL_RGBA, GL_FLOAT, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+// ReadResult 不等 GPU，这里轮询到拿到结果为止 (最多 5 秒)
+bool waitResult(AutoExposure& exposure) {
+    glFlush();
+    for (int i = 0; i < 5000; i++) {
+        if (exposure.ReadResult()) return true;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return false;
+}
+
+bool close(float value, float expected, const char* field) {
+    bool ok = std::fabs(value - expected) <= 1e-3f * std::max(1.0f, std::fabs(expected));
+    if (!ok) cout << "  " << field << ": " << value << ", expected " << expected << endl;
+    return ok;
+}
+
+bool matches(const AutoExposureResult& result, const AutoExposureResult& expected) {
+    bool ok = close(result.averageLum, expected.averageLum, "averageLum");
+    ok = close(result.lowLum, expected.lowLum, "lowLum") && ok;
+    ok = close(result.highLum, expected.highLum, "highLum") && ok;
+    ok = close(result.targetLum, expected.targetLum, "targetLum") && ok;
+    ok = close(result.adaptedLum, expected.adaptedLum, "adaptedLum") && ok;
+    return close(result.exposure, expected.exposure, "exposure") && ok;
+}
+
+// 第一帧：适应亮度直接取目标值，曝光纹理里是同一个曝光
+bool testReferenceMatch() {
+    PostProcessingData settings;
+    vector<float> pixels = syntheticImage(settings, 0);
+    unsigned int texture = createTexture(pixels);
+    AutoExposure exposure;
+    exposure.Compute(texture, IMAGE_WIDTH, IMAGE_HEIGHT, 0.016f, settings);
+    bool ok = waitResult(exposure);
+
+    float stored = 0.0f;
+    glBindTexture(GL_TEXTURE_2D, exposure.ExposureTexture());
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, &stored);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &texture);
+
+    AutoExposureResult expected = referenceResult(pixels, settings, 0.0f, 0.016f);
+    return ok && matches(exposure.Result(), expected) && close(stored, expected.exposure, "exposure texture");
+}
+
+// 第二帧换一张更暗的图：从上一帧的适应亮度按变暗的速度往目标值走
+bool testAdaptation() {
+    PostProcessingData settings;
+    vector<float> bright = syntheticImage(settings, 0);
+    vector<float> dark = syntheticImage(settings, -60);
+    unsigned int brightTexture = createTexture(bright), darkTexture = createTexture(dark);
+    AutoExposure exposure;
+    exposure.Compute(brightTexture, IMAGE_WIDTH, IMAGE_HEIGHT, 0.016f, settings);
+    bool ok = waitResult(exposure);
+    float previous = exposure.Result().adaptedLum;
+    exposure.Compute(darkTexture, IMAGE_WIDTH, IMAGE_HEIGHT, 0.25f, settings);
+    ok = waitResult(exposure) && ok;
+    glDeleteTextures(1, &brightTexture);
+    glDeleteTextures(1, &darkTexture);
+
+    AutoExposureResult expected = referenceResult(dark, settings, previous, 0.25f);
+    return ok && expected.targetLum < previous && matches(exposure.Result(), expected);
+}
+
+// 读回不阻塞：没有 Compute 过就没有结果，一次 Compute 只读到一次
+bool testAsyncReadback() {
+    PostProcessingData settings;
+    vector<float> pixels = syntheticImage(settings, 0);
+    unsigned int texture = createTexture(pixels);
+    AutoExposure exposure;
+    bool ok = !exposure.ReadResult();
+    exposure.Compute(texture, IMAGE_WIDTH, IMAGE_HEIGHT, 0.016f, settings);
+    ok = waitResult(exposure) && ok;
+    ok = !exposure.ReadResult() && ok;
+    glDeleteTextures(1, &texture);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+#ifndef ENTRO_HAS_EGL
+    cout << "ERROR::AUTO_EXPOSURE:: Built without EGL, skipping" << endl;
+    return EXIT_SKIPPED;
+#else
+    HeadlessContext headless(16, 16);
+    if (!headless.Valid()) return EXIT_SKIPPED;
+
+    TestRunner runner;
+    runner.Add("reference_match", testReferenceMatch);
+    runner.Add("adaptation", testAdaptation);
+    runner.Add("async_readback", testAsyncReadback);
+    return runner.Run(argc, argv);
+#endif
+}
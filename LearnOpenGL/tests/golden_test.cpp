@@ -0,0 +1,170 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include "camera.h"
+#include "renderer.h"
+#include "headlessContext.h"
+#include "asyncReadback.h"
+#include "goldenImage.h"
+
+using namespace std;
+
+// ==========================================================
+// 参考图回归测试 (CTest: golden_images)
+// 在无窗口上下文里用固定的场景 / 摄像机 / 帧间隔渲染几组画面，异步读回后和 tests/golden 里的参考图比较：
+//   逐像素：任一通道差 > 8 的像素不能超过 0.1%
+//   结构：亮度 SSIM 不能低于 0.98
+// 失败时在 --out 目录写 <case>_actual.ppm 和 <case>_diff.ppm (差异标红)
+// 参考图不存在也算失败 (不写候选图)，参考图只能由 --update 生成。
+// 改了画面之后确认无误，用 --update 重新生成参考图：
+//   LIBGL_ALWAYS_SOFTWARE=1 ./golden_test --refs tests/golden --update
+// 参考图是在 Mesa llvmpipe 上生成的，别的驱动结果会有细微差别，CTest 里固定用软件光栅
+// 必须在 LearnOpenGL 目录下运行 (资源是相对路径)
+// ==========================================================
+
+const int GOLDEN_WIDTH = 320;
+const int GOLDEN_HEIGHT = 180;
+const int GOLDEN_FRAMES = 16;                // 让自动曝光、阴影缓存这些随帧变化的状态先稳定下来
+const float FIXED_DELTA_TIME = 1.0f / 60.0f;
+const int EXIT_SKIPPED = 77;
+
+struct GoldenCase {
+    string name;
+    string reference;                        // 参考图名，一般和 name 一样；画面应当相同的变体可以共用
+    Camera camera;
+    function<void(Renderer&)> setup;
+};
+
+struct GoldenOptions {
+    string refs = "tests/golden";
+    string out = "golden_out";
+    bool update = false;
+};
+
+bool parseArgs(int argc, char** argv, GoldenOptions& options);
+vector<GoldenCase> makeCases();
+
+int main(int argc, char** argv) {
+    GoldenOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+#ifndef ENTRO_HAS_EGL
+    cout << "ERROR::GOLDEN:: Built without EGL, skipping" << endl;
+    return EXIT_SKIPPED;
+#else
+    HeadlessContext context(GOLDEN_WIDTH, GOLDEN_HEIGHT);
+    if (!context.Valid()) return 1;
+    filesystem::create_directories(options.out);
+    if (options.update) filesystem::create_directories(options.refs);
+
+    vector<GoldenCase> cases = makeCases();
+    int failed = 0, missing = 0;
+
+    // 检查一组读回的结果
+    auto check = [&](const GoldenCase& golden, AsyncReadback& readback) {
+        vector<unsigned char> pixels;
+        if (!readback.Read(pixels, true)) {
+            cout << "[FAIL] " << golden.name << ": readback failed" << endl;
+            failed++;
+            return;
+        }
+        Image actual = Image::FromGL(pixels, readback.Width(), readback.Height());
+        string referencePath = options.refs + "/" + golden.reference + ".ppm";
+        if (options.update) {
+            // 共用参考图的变体不覆盖，只和它比
+            if (golden.reference == golden.name) {
+                if (!WritePPM(referencePath, actual)) failed++;
+                else cout << "[UPDATE] " << referencePath << endl;
+                return;
+            }
+        }
+
+        Image reference;
+        if (!ReadPPM(referencePath, reference)) {
+            cout << "[FAIL] " << golden.name << ": no reference " << referencePath << " (generate it with --update)" << endl;
+            missing++;
+            return;
+        }
+
+        ImageTolerance tolerance;
+        ImageCompareResult result = CompareImages(actual, reference, tolerance);
+        cout << fixed << setprecision(4)
+             << (result.passed ? "[PASS] " : "[FAIL] ") << golden.name;
+        if (result.sizeMismatch) {
+            cout << ": size " << actual.width << "x" << actual.height << " vs reference "
+                 << reference.width << "x" << reference.height << endl;
+        } else {
+            cout << ": max diff " << result.maxDiff << ", bad pixels " << result.badPixels
+                 << " (" << result.badFraction * 100.0 << "%), SSIM " << result.ssim << endl;
+        }
+        if (!result.passed) {
+            failed++;
+            WritePPM(options.out + "/" + golden.name + "_actual.ppm", actual);
+            if (!result.sizeMismatch)
+                WritePPM(options.out + "/" + golden.name + "_diff.ppm", MakeDiffImage(actual, reference, tolerance.pixelThreshold));
+        }
+    };
+
+    // 两个读回轮流用：第 i 组的结果在第 i+1 组渲染提交完之后才取，拷贝和下一组的渲染重叠
+    AsyncReadback readbacks[2];
+    for (size_t i = 0; i < cases.size(); i++) {
+        GoldenCase& golden = cases[i];
+        {
+            Renderer renderer(GOLDEN_WIDTH, GOLDEN_HEIGHT);
+            renderer.dynamicResolution.settings.enabled = false;
+            renderer.profiler.enabled = false;
+            if (golden.setup) golden.setup(renderer);
+            for (int frame = 0; frame < GOLDEN_FRAMES; frame++)
+                renderer.RenderFrame(golden.camera, FIXED_DELTA_TIME, context.Framebuffer());
+            readbacks[i % 2].Request(context.Framebuffer(), context.Width(), context.Height());
+        }
+        if (i > 0) check(cases[i - 1], readbacks[(i - 1) % 2]);
+    }
+    if (!cases.empty()) check(cases.back(), readbacks[(cases.size() - 1) % 2]);
+
+    cout << cases.size() << " cases, " << failed << " failed, " << missing << " without reference" << endl;
+    return failed > 0 || missing > 0 ? 1 : 0;
+#endif
+}
+
+vector<GoldenCase> makeCases() {
+    vector<GoldenCase> cases;
+    cases.push_back({ "default_front", "default_front", Camera(glm::vec3(0.0f, 2.0f, 3.0f)), nullptr });
+    // 从 +x 往 -x 看，略微俯视
+    cases.push_back({ "default_side", "default_side", Camera(glm::vec3(4.0f, 2.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 180.0f, -15.0f), nullptr });
+    cases.push_back({ "generated", "generated", Camera(glm::vec3(0.0f, 6.0f, 12.0f), glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, -25.0f),
+                      [](Renderer& renderer) {
+                          SceneGeneratorSettings settings;
+                          settings.seed = 1;
+                          settings.objects = 64;
+                          settings.lights = 8;
+                          settings.materials = 4;
+                          settings.characterRatio = 0.0f;
+                          renderer.GenerateScene(settings);
+                      } });
+    // 拆开的后处理和合并的后处理画面应当一样，直接和 default_front 比
+    cases.push_back({ "post_separate", "default_front", Camera(glm::vec3(0.0f, 2.0f, 3.0f)),
+                      [](Renderer& renderer) { renderer.postProcessingData.fusedPost = false; } });
+    return cases;
+}
+
+bool parseArgs(int argc, char** argv, GoldenOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--refs") == 0 && hasValue) options.refs = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) options.out = argv[++i];
+        else if (strcmp(argv[i], "--update") == 0) options.update = true;
+        else {
+            cout << "Usage: " << argv[0] << " [--refs dir] [--out dir] [--update]" << endl;
+            return false;
+        }
+    }
+    return true;
+}
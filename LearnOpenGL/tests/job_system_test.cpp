@@ -0,0 +1,185 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jobSystem.h"
+#include "testRunner.h"
+
+using namespace std;
+
+// ==========================================================
+// 任务系统测试 (CTest: job_system)
+// 不需要 GL。用 -DENTRO_TSAN=ON 配置时这个测试用 ThreadSanitizer 编译，数据竞争会直接报错退出。
+// 写共享数据的地方故意用普通变量而不是原子量：如果任务系统的同步 (Wait / RunAfter) 没有建立先后关系，TSAN 会抓到
+// ==========================================================
+
+// 用不同的工作线程数各跑一遍 (0 = 全部在调用线程上做)
+const int WORKER_COUNTS[] = { 0, 1, 3, 7 };
+
+bool testRunAndWait(int workers) {
+    JobSystem jobs(workers);
+    atomic<int> sum{ 0 };
+    JobCounter counter;
+    for (int i = 0; i < 10000; i++) jobs.Run([&sum, i]() { sum.fetch_add(i, memory_order_relaxed); }, &counter);
+    jobs.Wait(counter);
+    return sum.load() == 10000 * 9999 / 2 && counter.Done();
+}
+
+// 每个下标恰好被处理一次，各块写不同的元素 (普通 int)，Wait 之后主线程读
+bool testParallelFor(int workers) {
+    JobSystem jobs(workers);
+    for (int grain : { 0, 1, 7, 1000, 100000 }) {
+        vector<int> hits(50000, 0);
+        jobs.ParallelFor(0, static_cast<int>(hits.size()), grain, [&hits](int i) { hits[i]++; });
+        for (int hit : hits) if (hit != 1) return false;
+    }
+    // 空区间和偏移的区间
+    int calls = 0;
+    jobs.ParallelFor(5, 5, 1, [&calls](int) { calls++; });
+    vector<int> offset(100, 0);
+    jobs.ParallelFor(10, 90, 3, [&offset](int i) { offset[i] = i; });
+    for (int i = 0; i < 100; i++) if (offset[i] != (i >= 10 && i < 90 ? i : 0)) return false;
+    return calls == 0;
+}
+
+// 依赖：A 写 -> B、C 读 A 的结果各写一半 -> D 汇总，全是普通变量
+bool testDependencies(int workers) {
+    JobSystem jobs(workers);
+    for (int round = 0; round < 200; round++) {
+        int a = 0, b = 0, c = 0, d = 0;
+        JobCounter stageA, stageBC, stageD;
+        // A 先提交 (计数 +1)，稍微睡一下，让 B / C / D 大多数时候真的挂在计数上等
+        jobs.Run([&]() { this_thread::sleep_for(chrono::microseconds(20)); a = round + 1; }, &stageA);
+        jobs.RunAfter(stageA, [&]() { b = a * 2; }, &stageBC);
+        jobs.RunAfter(stageA, [&]() { c = a * 3; }, &stageBC);
+        jobs.RunAfter(stageBC, [&]() { d = b + c; }, &stageD);
+        jobs.Wait(stageD);
+        jobs.Wait(stageA);
+        jobs.Wait(stageBC);
+        if (d != (round + 1) * 5) return false;
+    }
+    // 依赖已经是 0：马上执行
+    JobCounter done, after;
+    int value = 0;
+    jobs.RunAfter(done, [&value]() { value = 42; }, &after);
+    jobs.Wait(after);
+    return value == 42;
+}
+
+// 一条 1000 长的依赖链，每一环只能在上一环之后
+bool testChain(int workers) {
+    JobSystem jobs(workers);
+    const int LENGTH = 1000;
+    vector<unique_ptr<JobCounter>> counters;
+    for (int i = 0; i < LENGTH; i++) counters.push_back(make_unique<JobCounter>());
+    vector<int> order;
+    // 第 i 环挂在第 i - 1 环的计数上；前一环提交时计数已经 +1，所以前一环没做完就一定会等
+    jobs.Run([&order]() { order.push_back(0); }, counters[0].get());
+    for (int i = 1; i < LENGTH; i++)
+        jobs.RunAfter(*counters[i - 1], [&order, i]() { order.push_back(i); }, counters[i].get());
+    jobs.Wait(*counters[LENGTH - 1]);
+    for (int i = 0; i < LENGTH - 1; i++) jobs.Wait(*counters[i]);
+    if (static_cast<int>(order.size()) != LENGTH) return false;
+    for (int i = 0; i < LENGTH; i++) if (order[i] != i) return false;
+    return true;
+}
+
+// 任务里再 ParallelFor：工作线程 Wait 时帮忙，不会死锁
+bool testNested(int workers) {
+    JobSystem jobs(workers);
+    vector<vector<int>> grid(64, vector<int>(256, 0));
+    jobs.ParallelFor(0, 64, 1, [&jobs, &grid](int row) {
+        jobs.ParallelFor(0, 256, 16, [&grid, row](int column) { grid[row][column] = row * 256 + column; });
+    });
+    for (int row = 0; row < 64; row++)
+        for (int column = 0; column < 256; column++)
+            if (grid[row][column] != row * 256 + column) return false;
+    return true;
+}
+
+// 多个非工作线程同时往队列 0 提交、各自等自己的计数
+bool testExternalThreads(int workers) {
+    JobSystem jobs(workers);
+    const int THREADS = 4;
+    vector<long long> results(THREADS, 0);
+    vector<thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&jobs, &results, t]() {
+            vector<long long> partial(100, 0);
+            JobCounter counter;
+            for (int i = 0; i < 100; i++) jobs.Run([&partial, i, t]() { partial[i] = static_cast<long long>(i) * (t + 1); }, &counter);
+            jobs.Wait(counter);
+            long long sum = 0;
+            for (long long value : partial) sum += value;
+            results[t] = sum;
+        });
+    }
+    for (thread& worker : threads) worker.join();
+    for (int t = 0; t < THREADS; t++) if (results[t] != 4950LL * (t + 1)) return false;
+    return true;
+}
+
+// 计数器在 Wait 返回后立刻销毁，反复很多次 (等待方和减到 0 的线程之间不能有用到已销毁对象的窗口)
+bool testCounterLifetime(int workers) {
+    JobSystem jobs(workers);
+    int total = 0;
+    for (int round = 0; round < 2000; round++) {
+        int value = 0;
+        {
+            JobCounter counter;
+            jobs.Run([&value]() { value = 1; }, &counter);
+            jobs.Wait(counter);
+        }
+        total += value;
+    }
+    return total == 2000;
+}
+
+// 析构时队列里剩下的任务也要做完
+bool testDrainOnDestroy(int workers) {
+    atomic<int> executed{ 0 };
+    {
+        JobSystem jobs(workers);
+        for (int i = 0; i < 1000; i++) jobs.Run([&executed]() { executed.fetch_add(1, memory_order_relaxed); });
+    }
+    return executed.load() == 1000;
+}
+
+// 统计：执行数等于提交数；有工作线程时应该发生过偷取
+bool testStats(int workers) {
+    JobSystem jobs(workers);
+    JobCounter counter;
+    for (int i = 0; i < 5000; i++) jobs.Run([]() { this_thread::yield(); }, &counter);
+    jobs.Wait(counter);
+    JobSystemStats stats = jobs.Stats();
+    if (stats.executed != 5000) return false;
+    // 任务全在队列 0，工作线程做的都是偷来的
+    unsigned long long byWorkers = 0;
+    for (int i = 1; i <= workers; i++) byWorkers += jobs.Stats(i).executed;
+    return workers == 0 || byWorkers == 0 || stats.stolen >= byWorkers;
+}
+
+int main(int argc, char** argv) {
+    // 参数是工作线程数
+    vector<pair<string, function<bool(int)>>> cases = {
+        { "run_and_wait", testRunAndWait },
+        { "parallel_for", testParallelFor },
+        { "dependencies", testDependencies },
+        { "chain", testChain },
+        { "nested", testNested },
+        { "external_threads", testExternalThreads },
+        { "counter_lifetime", testCounterLifetime },
+        { "drain_on_destroy", testDrainOnDestroy },
+        { "stats", testStats },
+    };
+    TestRunner runner;
+    for (const auto& test : cases)
+        for (int workers : WORKER_COUNTS)
+            runner.Add(test.first + " (" + to_string(workers) + " workers)", [&test, workers]() { return test.second(workers); });
+    return runner.Run(argc, argv);
+}
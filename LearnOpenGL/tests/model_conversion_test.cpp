@@ -0,0 +1,245 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <assimp/scene.h>
+
+#include "model.h"
+#include "jobSystem.h"
+#include "testRunner.h"
+
+using namespace std;
+
+// ==========================================================
+// 模型网格转换测试 (CTest: model_conversion)
+// 不需要 GL：合成的 aiScene 走 MODEL_LOAD_DEFERRED (不建缓冲)，没有贴图。
+// 1. 8 种属性组合 (法线 / 贴图坐标 / 切线) 的转换结果和以前逐顶点转换的写法逐个顶点比较，面的大小混着 1~4 个索引
+// 2. 转换用 0 / 1 / 7 个工作线程的任务系统，meshes 的顺序和内容都和串行转换一样
+// ==========================================================
+
+const int WORKER_COUNTS[] = { 0, 1, 7 };
+
+// 以前 Model::processMesh 里的逐顶点转换 (改成并行 kernel 之前的写法)。
+// 唯一的区别：以前没有法线时 Normal 没初始化，这里 vertex 值初始化成 0，和现在的 kernel 一致
+void referenceConvert(const aiMesh *mesh, vector<Vertex> &vertices, vector<unsigned int> &indices) {
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+        Vertex vertex{};
+        glm::vec3 vector;
+        vector.x = mesh->mVertices[i].x;
+        vector.y = mesh->mVertices[i].y;
+        vector.z = mesh->mVertices[i].z;
+        vertex.Position = vector;
+        if (mesh->HasNormals()) {
+            vector.x = mesh->mNormals[i].x;
+            vector.y = mesh->mNormals[i].y;
+            vector.z = mesh->mNormals[i].z;
+            vertex.Normal = vector;
+        }
+        if (mesh->mTextureCoords[0]) {
+            glm::vec2 vec;
+            vec.x = mesh->mTextureCoords[0][i].x;
+            vec.y = mesh->mTextureCoords[0][i].y;
+            vertex.TexCoords = vec;
+        } else
+            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+        if (mesh->HasTangentsAndBitangents()) {
+            vector.x = mesh->mTangents[i].x;
+            vector.y = mesh->mTangents[i].y;
+            vector.z = mesh->mTangents[i].z;
+            vertex.Tangent = vector;
+            vector.x = mesh->mBitangents[i].x;
+            vector.y = mesh->mBitangents[i].y;
+            vector.z = mesh->mBitangents[i].z;
+            vertex.Bitangent = vector;
+        } else {
+            vertex.Tangent = glm::vec3(0.0f);
+            vertex.Bitangent = glm::vec3(0.0f);
+        }
+        vertices.push_back(vertex);
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        aiFace face = mesh->mFaces[i];
+        for (unsigned int j = 0; j < face.mNumIndices; j++)
+            indices.push_back(face.mIndices[j]);
+    }
+}
+
+// 固定种子的伪随机数，不同平台结果一样
+struct Random {
+    unsigned int state;
+    float Next() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f * 2.0f - 1.0f;
+    }
+    aiVector3D Vector() {
+        float x = Next(), y = Next();
+        return aiVector3D(x, y, Next());
+    }
+};
+
+// attributes 的位和 model.cpp 里的 kernel 下标一样：法线 1 | 贴图坐标 2 | 切线和副切线 4
+aiMesh* syntheticMesh(const string &name, unsigned int vertexCount, int attributes, unsigned int seed) {
+    Random random{ seed };
+    aiMesh* mesh = new aiMesh();
+    mesh->mName.Set(name);
+    mesh->mNumVertices = vertexCount;
+    mesh->mVertices = new aiVector3D[vertexCount];
+    if (attributes & 1) mesh->mNormals = new aiVector3D[vertexCount];
+    if (attributes & 2) mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+    if (attributes & 4) {
+        mesh->mTangents = new aiVector3D[vertexCount];
+        mesh->mBitangents = new aiVector3D[vertexCount];
+    }
+    for (unsigned int i = 0; i < vertexCount; i++) {
+        mesh->mVertices[i] = random.Vector();
+        if (mesh->mNormals) mesh->mNormals[i] = random.Vector();
+        if (mesh->mTextureCoords[0]) mesh->mTextureCoords[0][i] = random.Vector();
+        if (mesh->mTangents) {
+            mesh->mTangents[i] = random.Vector();
+            mesh->mBitangents[i] = random.Vector();
+        }
+    }
+    // 点 / 线 / 三角形 / 四边形混着来 (没做三角化的模型就会这样)
+    mesh->mNumFaces = vertexCount / 2 + 1;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        aiFace& face = mesh->mFaces[i];
+        face.mNumIndices = 1 + (i * 7 + seed) % 4;
+        face.mIndices = new unsigned int[face.mNumIndices];
+        for (unsigned int j = 0; j < face.mNumIndices; j++)
+            face.mIndices[j] = (i * 31 + j * 17 + seed) % vertexCount;
+    }
+    return mesh;
+}
+
+aiNode* syntheticNode(const string &name, const vector<unsigned int> &meshIndices) {
+    aiNode* node = new aiNode();
+    node->mName.Set(name);
+    node->mNumMeshes = static_cast<unsigned int>(meshIndices.size());
+    node->mMeshes = new unsigned int[meshIndices.size()];
+    for (size_t i = 0; i < meshIndices.size(); i++) node->mMeshes[i] = meshIndices[i];
+    return node;
+}
+
+void addChildren(aiNode *parent, const vector<aiNode*> &children) {
+    parent->mNumChildren = static_cast<unsigned int>(children.size());
+    parent->mChildren = new aiNode*[children.size()];
+    for (size_t i = 0; i < children.size(); i++) {
+        parent->mChildren[i] = children[i];
+        children[i]->mParent = parent;
+    }
+}
+
+// 40 个网格，属性组合轮流来，大小差很多 (大的先排，调度顺序和节点顺序不一样)；
+// 节点树有三层，其中一个网格叫 hairShadow，加载时要被跳过
+struct SyntheticScene {
+    unique_ptr<aiScene> scene;
+    vector<unsigned int> expectedOrder;   // 深度优先展开后应该得到的网格下标
+};
+
+SyntheticScene syntheticScene() {
+    const unsigned int MESH_COUNT = 40;
+    const unsigned int SKIPPED = 13;
+    SyntheticScene result;
+    result.scene = make_unique<aiScene>();
+    aiScene* scene = result.scene.get();
+    scene->mNumMeshes = MESH_COUNT;
+    scene->mMeshes = new aiMesh*[MESH_COUNT];
+    for (unsigned int i = 0; i < MESH_COUNT; i++) {
+        unsigned int vertexCount = i == 21 ? 60000 : 3 + (i * 7919) % 4000;
+        string name = i == SKIPPED ? "Body_hairShadow" : "mesh" + to_string(i);
+        scene->mMeshes[i] = syntheticMesh(name, vertexCount, static_cast<int>(i % 8), i + 1);
+    }
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[1];
+    scene->mMaterials[0] = new aiMaterial();
+
+    // root: 网格 0~4，子节点 a (5~19，含跳过的 13，下面还有 a1: 20~29)、b (30~39，倒着挂)
+    vector<unsigned int> rootMeshes, aMeshes, a1Meshes, bMeshes;
+    for (unsigned int i = 0; i < 5; i++) rootMeshes.push_back(i);
+    for (unsigned int i = 5; i < 20; i++) aMeshes.push_back(i);
+    for (unsigned int i = 20; i < 30; i++) a1Meshes.push_back(i);
+    for (unsigned int i = MESH_COUNT; i > 30; i--) bMeshes.push_back(i - 1);
+    bMeshes.push_back(30);
+    scene->mRootNode = syntheticNode("root", rootMeshes);
+    aiNode* a = syntheticNode("a", aMeshes);
+    addChildren(a, { syntheticNode("a1", a1Meshes) });
+    addChildren(scene->mRootNode, { a, syntheticNode("b", bMeshes) });
+
+    for (const vector<unsigned int>* list : { &rootMeshes, &aMeshes, &a1Meshes, &bMeshes })
+        for (unsigned int index : *list)
+            if (index != SKIPPED) result.expectedOrder.push_back(index);
+    return result;
+}
+
+bool sameVertex(const Vertex &a, const Vertex &b) {
+    return a.Position == b.Position && a.Normal == b.Normal && a.TexCoords == b.TexCoords &&
+           a.Tangent == b.Tangent && a.Bitangent == b.Bitangent;
+}
+
+// model 里的网格按 expectedOrder 排，每个都和参考写法的结果一致
+bool matchesReference(const Model &model, const SyntheticScene &synthetic) {
+    if (!model.Loaded() || model.meshes.size() != synthetic.expectedOrder.size()) {
+        cout << "  got " << model.meshes.size() << " meshes, expected " << synthetic.expectedOrder.size() << endl;
+        return false;
+    }
+    for (size_t i = 0; i < model.meshes.size(); i++) {
+        const aiMesh* source = synthetic.scene->mMeshes[synthetic.expectedOrder[i]];
+        vector<Vertex> vertices;
+        vector<unsigned int> indices;
+        referenceConvert(source, vertices, indices);
+        const Mesh& mesh = model.meshes[i];
+        if (mesh.vertices.size() != vertices.size() || mesh.indices != indices || !mesh.textures.empty()) {
+            cout << "  mesh " << i << " (" << source->mName.C_Str() << ") size or indices differ" << endl;
+            return false;
+        }
+        for (size_t v = 0; v < vertices.size(); v++) {
+            if (!sameVertex(mesh.vertices[v], vertices[v])) {
+                cout << "  mesh " << i << " (" << source->mName.C_Str() << ") vertex " << v << " differs" << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 默认：后台加载在当前线程上串行转换
+bool testSerialMatchesReference() {
+    SyntheticScene synthetic = syntheticScene();
+    Model model(synthetic.scene.get(), "synthetic");
+    return matchesReference(model, synthetic);
+}
+
+// 8 种属性组合都覆盖到了 (syntheticScene 按 i % 8 轮流，这里防止以后改场景时漏掉)
+bool testAllAttributeCombinations() {
+    SyntheticScene synthetic = syntheticScene();
+    bool seen[8] = {};
+    for (unsigned int index : synthetic.expectedOrder) {
+        const aiMesh* mesh = synthetic.scene->mMeshes[index];
+        seen[(mesh->HasNormals() ? 1 : 0) | (mesh->mTextureCoords[0] ? 2 : 0) | (mesh->HasTangentsAndBitangents() ? 4 : 0)] = true;
+    }
+    for (bool combination : seen) if (!combination) return false;
+    return true;
+}
+
+// 指定的任务系统：结果和线程数无关，包围盒也一样
+bool testParallelDeterministic(int workers) {
+    SyntheticScene synthetic = syntheticScene();
+    Model serial(synthetic.scene.get(), "synthetic");
+    JobSystem jobs(workers);
+    Model::SetConversionJobSystem(&jobs);
+    Model parallel(synthetic.scene.get(), "synthetic");
+    Model::SetConversionJobSystem(nullptr);
+    return matchesReference(parallel, synthetic) &&
+           parallel.bounds.min == serial.bounds.min && parallel.bounds.max == serial.bounds.max;
+}
+
+int main(int argc, char** argv) {
+    TestRunner runner;
+    runner.Add("serial_matches_reference", testSerialMatchesReference);
+    runner.Add("all_attribute_combinations", testAllAttributeCombinations);
+    for (int workers : WORKER_COUNTS)
+        runner.Add("parallel_deterministic (" + to_string(workers) + " workers)", [workers]() { return testParallelDeterministic(workers); });
+    return runner.Run(argc, argv);
+}
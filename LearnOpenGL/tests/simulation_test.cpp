@@ -0,0 +1,183 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulation.h"
+#include "testRunner.h"
+
+using namespace std;
+
+// ==========================================================
+// 模拟线程 / 三缓冲测试 (CTest: simulation)
+// 不需要 GL。和 job_system 一样，-DENTRO_TSAN=ON 时用 ThreadSanitizer 编译
+// ==========================================================
+
+// 写线程每份快照的所有字段都写成同一个序号，读线程拿到的每一份都必须一致 (没有读到写了一半的)，而且序号不倒退
+struct Frame {
+    unsigned long long values[64];
+};
+
+bool testTripleBufferConsistency() {
+    TripleBuffer<Frame> buffer(Frame{});
+    const unsigned long long COUNT = 200000;
+    atomic<bool> done{ false };
+    thread writer([&]() {
+        for (unsigned long long i = 1; i <= COUNT; i++) {
+            Frame& frame = buffer.WriteBuffer();
+            for (unsigned long long& value : frame.values) value = i;
+            buffer.Publish();
+        }
+        done.store(true, memory_order_release);
+    });
+    bool consistent = true;
+    unsigned long long last = 0;
+    while (true) {
+        bool finished = done.load(memory_order_acquire);
+        buffer.Update();
+        const Frame& frame = buffer.ReadBuffer();
+        for (unsigned long long value : frame.values) if (value != frame.values[0]) consistent = false;
+        if (frame.values[0] < last) consistent = false;
+        last = frame.values[0];
+        // 写完以后再 Update 一次，必须拿到最后一份
+        if (finished) {
+            buffer.Update();
+            if (buffer.ReadBuffer().values[0] != COUNT) consistent = false;
+            break;
+        }
+    }
+    writer.join();
+    return consistent;
+}
+
+// 没有新发布时 Update 返回 false，读到的还是上一份
+bool testTripleBufferNoNewData() {
+    TripleBuffer<int> buffer(0);
+    if (buffer.Update()) return false;
+    buffer.WriteBuffer() = 7;
+    buffer.Publish();
+    if (!buffer.Update() || buffer.ReadBuffer() != 7) return false;
+    if (buffer.Update() || buffer.ReadBuffer() != 7) return false;
+    // 连发两份只拿到最新的
+    buffer.WriteBuffer() = 8;
+    buffer.Publish();
+    buffer.WriteBuffer() = 9;
+    buffer.Publish();
+    return buffer.Update() && buffer.ReadBuffer() == 9;
+}
+
+PointLightData testLight() {
+    PointLightData light = {};
+    light.position = glm::vec4(1.0f, 2.0f, 3.0f, 0.0f);
+    return light;
+}
+
+// 不开线程：每次 Advance 按帧时间走一步，和以前在主线程里直接改摄像机 / 光源一样
+bool testSynchronousStep() {
+    Camera reference(glm::vec3(0.0f, 2.0f, 3.0f));
+    Simulation simulation(reference, testLight());
+    SimulationSettings settings;
+    settings.threaded = false;
+    simulation.Apply(settings);
+
+    simulation.SetKeys((1u << SIM_KEY_FORWARD) | (1u << SIM_KEY_LIGHT_UP));
+    simulation.AddMouse(10.0f, -5.0f);
+    simulation.Advance(0.5f);
+    const SceneSnapshot& snapshot = simulation.Acquire(false);
+
+    reference.ProcessMouseMovement(10.0f, -5.0f);
+    reference.ProcessKeyboard(FORWARD, 0.5f);
+    glm::vec3 delta = snapshot.camera.Position - reference.Position;
+    return snapshot.tick == 1 && glm::dot(delta, delta) < 1e-10f &&
+           snapshot.camera.Yaw == reference.Yaw && snapshot.camera.Pitch == reference.Pitch &&
+           std::fabs(snapshot.light.position.y - (2.0f + Simulation::LIGHT_SPEED * 0.5f)) < 1e-5f;
+}
+
+// 开线程：按住前进一段时间，摄像机要往前走；松开后不再动
+bool testThreadedMovement() {
+    Simulation simulation(Camera(glm::vec3(0.0f)), testLight());
+    SimulationSettings settings;
+    settings.tickRate = 500;
+    simulation.Apply(settings);
+    simulation.SetKeys(1u << SIM_KEY_FORWARD);
+    this_thread::sleep_for(chrono::milliseconds(100));
+    simulation.SetKeys(0);
+    const SceneSnapshot& moving = simulation.Acquire(true);
+    float stoppedZ = moving.camera.Position.z;
+    unsigned long long stoppedTick = moving.tick;
+    this_thread::sleep_for(chrono::milliseconds(50));
+    const SceneSnapshot& stopped = simulation.Acquire(true);
+    // 默认朝 -Z 看
+    return stoppedZ < -0.1f && stopped.tick > stoppedTick && stopped.camera.Position.z == stoppedZ;
+}
+
+// late latch：推完鼠标输入马上 Acquire，拿到的快照已经包含它 (不用等下一步)
+bool testLateLatch() {
+    Simulation simulation(Camera(glm::vec3(0.0f)), testLight());
+    SimulationSettings settings;
+    settings.tickRate = 30;   // 步长很长，只有被输入叫醒才来得及
+    simulation.Apply(settings);
+    this_thread::sleep_for(chrono::milliseconds(50));
+    int latched = 0;
+    for (int i = 1; i <= 20; i++) {
+        simulation.AddMouse(1.0f, 0.0f);
+        const SceneSnapshot& snapshot = simulation.Acquire(true);
+        if (std::fabs(snapshot.camera.Yaw - (YAW + i * SENSITIVITY)) < 1e-4f) latched++;
+        // Acquire 超时的话后面就对不上了，这里追平再继续
+        while (std::fabs(simulation.Acquire(true).camera.Yaw - (YAW + i * SENSITIVITY)) >= 1e-4f)
+            this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    // 调度抖动时个别几次会超时，绝大多数应该当场拿到
+    return latched >= 15;
+}
+
+// GUI 改光源：覆盖模拟里的光源，快照带上新的修订号
+bool testLightOverride() {
+    Simulation simulation(Camera(), testLight());
+    SimulationSettings settings;
+    simulation.Apply(settings);
+    PointLightData edited = testLight();
+    edited.diffuse = glm::vec4(0.5f);
+    edited.position.x = -4.0f;
+    simulation.SetLight(edited);
+    unsigned long long revision = simulation.LightRevision();
+    for (int i = 0; i < 1000; i++) {
+        const SceneSnapshot& snapshot = simulation.Acquire(true);
+        if (snapshot.lightRevision == revision)
+            return snapshot.light.position.x == -4.0f && snapshot.light.diffuse.x == 0.5f;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// 线程开开关关：每次切换后状态接着走，不丢也不重
+bool testToggleThread() {
+    Simulation simulation(Camera(glm::vec3(0.0f)), testLight());
+    SimulationSettings settings;
+    unsigned long long lastTick = 0;
+    for (int round = 0; round < 20; round++) {
+        settings.threaded = round % 2 == 0;
+        simulation.Apply(settings);
+        if (!settings.threaded) simulation.Advance(0.01f);
+        else this_thread::sleep_for(chrono::milliseconds(5));
+        unsigned long long tick = simulation.Acquire(true).tick;
+        if (tick <= lastTick) return false;
+        lastTick = tick;
+    }
+    return simulation.Threaded() == false;
+}
+
+int main(int argc, char** argv) {
+    TestRunner runner;
+    runner.Add("triple_buffer_consistency", testTripleBufferConsistency);
+    runner.Add("triple_buffer_no_new_data", testTripleBufferNoNewData);
+    runner.Add("synchronous_step", testSynchronousStep);
+    runner.Add("threaded_movement", testThreadedMovement);
+    runner.Add("late_latch", testLateLatch);
+    runner.Add("light_override", testLightOverride);
+    runner.Add("toggle_thread", testToggleThread);
+    return runner.Run(argc, argv);
+}
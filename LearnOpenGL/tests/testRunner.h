@@ -0,0 +1,45 @@
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <iostream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ==========================================================
+// 测试用例登记 + 运行 (tests/ 下各个 CTest 共用)
+// 每个用例是一个返回 bool 的函数，Run 逐个跑、打印 [PASS] / [FAIL]，有失败就返回 1
+// 命令行第一个参数是名字过滤：只跑名字里带这个字符串的用例
+// ==========================================================
+
+struct TestCase {
+    std::string name;
+    std::function<bool()> run;
+};
+
+class TestRunner {
+public:
+    void Add(const std::string& name, std::function<bool()> run) {
+        cases.push_back({ name, std::move(run) });
+    }
+
+    int Run(int argc, char** argv) const {
+        const char* only = argc > 1 ? argv[1] : nullptr;
+        int failed = 0, run = 0;
+        for (const TestCase& test : cases) {
+            if (only && test.name.find(only) == std::string::npos) continue;
+            bool passed = test.run();
+            run++;
+            if (!passed) failed++;
+            std::cout << (passed ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+        }
+        std::cout << run << " tests, " << failed << " failed" << std::endl;
+        return failed > 0 ? 1 : 0;
+    }
+
+private:
+    std::vector<TestCase> cases;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include <glad/glad.h>
+#include <iostream>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "headlessContext.h"
+#include "uploadService.h"
+#include "testRunner.h"
+
+using namespace std;
+
+// ==========================================================
+// 后台上传线程测试 (CTest: upload_service)
+// 无窗口上下文 + 一个共享上下文跑 UploadService，上传的数据在主上下文里等 fence 过了再读回来比较
+// staging 故意设得很小，纹理 / 缓冲都要分好几条传
+// 没有 EGL 或者建不出共享上下文时返回 77 (CTest 记为跳过)
+// ==========================================================
+
+const int EXIT_SKIPPED = 77;
+const size_t TEST_STAGING_BYTES = 1000;
+
+struct Uploaded {
+    unsigned int id = 0;
+    GLsync fence = nullptr;
+};
+
+// 主线程上等 fence (最多 5 秒)，过了就删掉
+bool waitFence(GLsync fence) {
+    if (!fence) return false;
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 5000000000ull);
+    glDeleteSync(fence);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+vector<unsigned char> pattern(size_t bytes, unsigned int seed) {
+    vector<unsigned char> data(bytes);
+    for (size_t i = 0; i < bytes; i++) data[i] = static_cast<unsigned char>((i * 31 + seed * 7 + i / 251) & 0xFF);
+    return data;
+}
+
+// 宽度是奇数、RGB 三通道，行不按 4 字节对齐；读回第 0 级逐字节比较，并且有完整的 mipmap 链
+bool testTextureRoundTrip(UploadContext& context) {
+    const int width = 37, height = 29;
+    vector<unsigned char> pixels = pattern(static_cast<size_t>(width) * height * 3, 1);
+    Uploaded uploaded;
+    {
+        UploadService service(context, TEST_STAGING_BYTES);
+        if (!service.Valid()) return false;
+        promise<Uploaded> done;
+        service.Submit([&](UploadService& uploads) {
+            Uploaded result;
+            result.id = uploads.UploadTexture(pixels.data(), width, height, 3, "test");
+            result.fence = uploads.Fence();
+            done.set_value(result);
+        });
+        uploaded = done.get_future().get();
+    }
+    if (!waitFence(uploaded.fence)) return false;
+
+    vector<unsigned char> readback(pixels.size());
+    GLint levels = 0;
+    glBindTexture(GL_TEXTURE_2D, uploaded.id);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, readback.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &uploaded.id);
+    ResourceTracker::Get().Release(RESOURCE_KIND_TEXTURE, uploaded.id);
+    return levels == 6 && readback == pixels;
+}
+
+// 比 staging 大很多的缓冲，分块 glCopyBufferSubData 之后内容不变
+bool testBufferRoundTrip(UploadContext& context) {
+    vector<unsigned char> data = pattern(10 * TEST_STAGING_BYTES + 123, 2);
+    Uploaded uploaded;
+    {
+        UploadService service(context, TEST_STAGING_BYTES);
+        if (!service.Valid()) return false;
+        promise<Uploaded> done;
+        service.Submit([&](UploadService& uploads) {
+            Uploaded result;
+            result.id = uploads.UploadBuffer(data.data(), data.size(), RESOURCE_MESH);
+            result.fence = uploads.Fence();
+            done.set_value(result);
+        });
+        uploaded = done.get_future().get();
+    }
+    if (!waitFence(uploaded.fence)) return false;
+
+    vector<unsigned char> readback(data.size());
+    glBindBuffer(GL_COPY_READ_BUFFER, uploaded.id);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(readback.size()), readback.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glDeleteBuffers(1, &uploaded.id);
+    ResourceTracker::Get().Release(RESOURCE_KIND_BUFFER, uploaded.id);
+    return readback == data;
+}
+
+// 析构时排着的任务都要做完 (按提交顺序)，统计也要对得上
+bool testDrainOnDestroy(UploadContext& context) {
+    const int TASKS = 20;
+    vector<int> order;
+    vector<unsigned int> buffers;
+    UploadStats stats;
+    {
+        UploadService service(context, TEST_STAGING_BYTES);
+        if (!service.Valid()) return false;
+        for (int i = 0; i < TASKS; i++) {
+            service.Submit([&, i](UploadService& uploads) {
+                unsigned int value = i;
+                buffers.push_back(uploads.UploadBuffer(&value, sizeof(value), RESOURCE_BUFFER));
+                order.push_back(i);
+            });
+        }
+        // 不等，直接析构
+        service.Submit([&](UploadService& uploads) {
+            waitFence(uploads.Fence());
+            stats = uploads.Stats();
+        });
+    }
+    for (unsigned int buffer : buffers) ResourceTracker::Get().Release(RESOURCE_KIND_BUFFER, buffer);
+    glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+    if (static_cast<int>(order.size()) != TASKS || stats.buffers != TASKS) return false;
+    for (int i = 0; i < TASKS; i++) if (order[i] != i) return false;
+    return true;
+}
+
+// 上下文设不上：Valid() 为 false，析构不卡住
+bool testInvalidContext(UploadContext&) {
+    UploadContext broken;
+    broken.makeCurrent = []() { return false; };
+    UploadService service(broken);
+    return !service.Valid();
+}
+
+int main(int argc, char** argv) {
+#ifndef ENTRO_HAS_EGL
+    cout << "ERROR::UPLOAD:: Built without EGL, skipping" << endl;
+    return EXIT_SKIPPED;
+#else
+    HeadlessContext headless(16, 16);
+    if (!headless.Valid() || !headless.CreateSharedContext()) return EXIT_SKIPPED;
+    UploadContext context;
+    context.makeCurrent = [&headless]() { return headless.MakeSharedCurrent(); };
+    context.release = [&headless]() { headless.ReleaseShared(); };
+
+    TestRunner runner;
+    runner.Add("texture_round_trip", [&context]() { return testTextureRoundTrip(context); });
+    runner.Add("buffer_round_trip", [&context]() { return testBufferRoundTrip(context); });
+    runner.Add("drain_on_destroy", [&context]() { return testDrainOnDestroy(context); });
+    runner.Add("invalid_context", [&context]() { return testInvalidContext(context); });
+    return runner.Run(argc, argv);
+#endif
+}